@@ -327,6 +327,7 @@ files {
 	MAME_DIR .. "src/devices/sound/samples.h",
 	MAME_DIR .. "src/emu/drivers/empty.cpp",
 	MAME_DIR .. "src/emu/drivers/testcpu.cpp",
+	MAME_DIR .. "src/emu/drivers/testuml.cpp",
 	MAME_DIR .. "src/emu/drivers/xtal.h",
 	MAME_DIR .. "src/devices/machine/bcreader.cpp",
 	MAME_DIR .. "src/devices/machine/bcreader.h",
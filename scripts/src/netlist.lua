@@ -58,6 +58,8 @@ project "netlist"
 		MAME_DIR .. "src/lib/netlist/plib/pstring.h",
 		MAME_DIR .. "src/lib/netlist/plib/pstream.cpp",
 		MAME_DIR .. "src/lib/netlist/plib/pstream.h",
+		MAME_DIR .. "src/lib/netlist/plib/pthreadpool.cpp",
+		MAME_DIR .. "src/lib/netlist/plib/pthreadpool.h",
 		MAME_DIR .. "src/lib/netlist/plib/ptypes.h",
 		MAME_DIR .. "src/lib/netlist/tools/nl_convert.cpp",
 		MAME_DIR .. "src/lib/netlist/tools/nl_convert.h",
@@ -79,6 +81,8 @@ project "netlist"
 		MAME_DIR .. "src/lib/netlist/solver/nld_ms_sor.h",
 		MAME_DIR .. "src/lib/netlist/solver/nld_ms_sor_mat.h",
 		MAME_DIR .. "src/lib/netlist/solver/nld_ms_gmres.h",
+		MAME_DIR .. "src/lib/netlist/solver/nld_ms_sparse.h",
+		MAME_DIR .. "src/lib/netlist/solver/nld_ms_static.cpp",
 		MAME_DIR .. "src/lib/netlist/solver/mat_cr.h",
 		MAME_DIR .. "src/lib/netlist/solver/nld_ms_direct_lu.h",
 		MAME_DIR .. "src/lib/netlist/solver/vector_base.h",		
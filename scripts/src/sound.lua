@@ -424,6 +424,7 @@ if (SOUNDS["IREMGA20"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/sound/iremga20.cpp",
 		MAME_DIR .. "src/devices/sound/iremga20.h",
+		MAME_DIR .. "src/devices/sound/pcmvoice.h",
 	}
 end
 
@@ -774,6 +775,7 @@ if (SOUNDS["SEGAPCM"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/sound/segapcm.cpp",
 		MAME_DIR .. "src/devices/sound/segapcm.h",
+		MAME_DIR .. "src/devices/sound/pcmvoice.h",
 	}
 end
 
@@ -1273,6 +1275,7 @@ if (SOUNDS["YMZ280B"]~=null) then
 	files {
 		MAME_DIR .. "src/devices/sound/ymz280b.cpp",
 		MAME_DIR .. "src/devices/sound/ymz280b.h",
+		MAME_DIR .. "src/devices/sound/pcmvoice.h",
 	}
 end
 
@@ -26,9 +26,9 @@
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
+#include "cpu/drcbeut.h"
 
 
-#define ARM7_MAX_FASTRAM       4
 #define ARM7_MAX_HOTSPOTS      16
 
 
@@ -270,15 +270,6 @@ protected:
 	// DRC
 	//
 
-	/* fast RAM info */
-	struct fast_ram_info
-	{
-		offs_t              start;                      /* start of the RAM block */
-		offs_t              end;                        /* end of the RAM block */
-		UINT8               readonly;                   /* TRUE if read-only */
-		void *              base;                       /* base in memory where the RAM lives */
-	};
-
 	struct hotspot_info
 	{
 		UINT32             pc;
@@ -333,8 +324,7 @@ protected:
 		uml::code_handle *   write32;                    /* write word */
 
 		/* fast RAM */
-		UINT32              fastram_select;
-		fast_ram_info       fastram[ARM7_MAX_FASTRAM];
+		drc_fastram_table   fastram;
 
 		/* hotspots */
 		UINT32              hotspot_select;
@@ -575,3 +575,142 @@ void drc_label_list::oob_callback(drccodeptr *codeptr, void *param1, void *param
 	label_fixup *fixup = reinterpret_cast<label_fixup *>(param1);
 	fixup->m_callback(param2, fixup->m_label->m_codeptr);
 }
+
+
+
+//**************************************************************************
+//  DRC FAST RAM TABLE
+//**************************************************************************
+
+//-------------------------------------------------
+//  drc_fastram_table - constructor
+//-------------------------------------------------
+
+drc_fastram_table::drc_fastram_table()
+	: m_count(0)
+{
+	memset(m_region, 0, sizeof(m_region));
+}
+
+
+//-------------------------------------------------
+//  add - add a new region, or move an existing
+//  one with the same start address to a new
+//  base (e.g. on a bank switch); returns true
+//  if the table changed, in which case any code
+//  generated from it must be flushed
+//-------------------------------------------------
+
+bool drc_fastram_table::add(offs_t start, offs_t end, bool readonly, void *base)
+{
+	int index;
+	for (index = 0; index < m_count; index++)
+		if (m_region[index].start == start)
+			break;
+
+	if (index == m_count)
+	{
+		if (m_count == MAX_REGIONS)
+			return false;
+		m_count++;
+	}
+	else if (m_region[index].end == end && m_region[index].readonly == readonly && m_region[index].base == base)
+		return false;
+
+	m_region[index].start = start;
+	m_region[index].end = end;
+	m_region[index].readonly = readonly;
+	m_region[index].base = base;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  clear - remove all regions from the given
+//  index onwards
+//-------------------------------------------------
+
+void drc_fastram_table::clear(int first)
+{
+	if (first >= m_count)
+		return;
+
+	memset(&m_region[first], 0, sizeof(m_region[0]) * (m_count - first));
+	m_count = first;
+}
+
+
+//-------------------------------------------------
+//  generate_access - emit an inline bounds check
+//  of the address in I0 against each region; on
+//  a hit the access is done directly and the
+//  code returns, otherwise control falls through
+//  to whatever the caller emits next.  I1 holds
+//  the data for writes and, for masked writes,
+//  I2 the mask; I0, I2 and I3 may be trashed
+//-------------------------------------------------
+
+void drc_fastram_table::generate_access(drcuml_block &block, code_label &labelnum, int size, bool iswrite, UINT32 addrxor, bool masked) const
+{
+	static const operand_size sizemap[] = { SIZE_BYTE, SIZE_BYTE, SIZE_WORD, SIZE_WORD, SIZE_DWORD, SIZE_DWORD, SIZE_DWORD, SIZE_DWORD, SIZE_QWORD };
+	operand_size opsize = sizemap[size];
+
+	for (const region &curregion : *this)
+	{
+		if (curregion.base == nullptr || (iswrite && curregion.readonly))
+			continue;
+
+		void *fastbase = (UINT8 *)curregion.base - curregion.start;
+		code_label skip = labelnum++;
+
+		// make sure the whole access lands inside the region
+		if (curregion.end != 0xffffffff)
+		{
+			block.append().cmp(I0, curregion.end - (size - 1));                        // cmp     i0,end-(size-1)
+			block.append().jmp(COND_A, skip);                                          // ja      skip
+		}
+		if (curregion.start != 0x00000000)
+		{
+			block.append().cmp(I0, curregion.start);                                   // cmp     i0,start
+			block.append().jmp(COND_B, skip);                                          // jb      skip
+		}
+
+		if (addrxor != 0)
+			block.append()._xor(I0, I0, addrxor);                                      // xor     i0,i0,addrxor
+
+		if (!iswrite)
+		{
+			if (size == 8)
+				block.append().dload(I0, fastbase, I0, opsize, SCALE_x1);              // dload   i0,fastbase,i0,size_x1
+			else
+				block.append().load(I0, fastbase, I0, opsize, SCALE_x1);               // load    i0,fastbase,i0,size_x1
+		}
+		else if (size == 8)
+		{
+			if (masked)
+			{
+				block.append().dload(I3, fastbase, I0, opsize, SCALE_x1);              // dload   i3,fastbase,i0,qword_x1
+				block.append().dand(I1, I1, I2);                                       // dand    i1,i1,i2
+				block.append().dxor(I2, I2, U64(0xffffffffffffffff));                  // dxor    i2,i2,~0
+				block.append().dand(I3, I3, I2);                                       // dand    i3,i3,i2
+				block.append().dor(I1, I1, I3);                                        // dor     i1,i1,i3
+			}
+			block.append().dstore(fastbase, I0, I1, opsize, SCALE_x1);                 // dstore  fastbase,i0,i1,qword_x1
+		}
+		else
+		{
+			if (masked)
+			{
+				block.append().load(I3, fastbase, I0, opsize, SCALE_x1);               // load    i3,fastbase,i0,size_x1
+				block.append()._and(I1, I1, I2);                                       // and     i1,i1,i2
+				block.append()._xor(I2, I2, 0xffffffff);                               // xor     i2,i2,~0
+				block.append()._and(I3, I3, I2);                                       // and     i3,i3,i2
+				block.append()._or(I1, I1, I3);                                        // or      i1,i1,i3
+			}
+			block.append().store(fastbase, I0, I1, opsize, SCALE_x1);                  // store   fastbase,i0,i1,size_x1
+		}
+		block.append().ret();                                                          // ret
+
+		block.append().label(skip);                                                    // skip:
+	}
+}
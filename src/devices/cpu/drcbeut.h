@@ -163,4 +163,42 @@ private:
 };
 
 
+// ======================> drc_fastram_table
+
+// RAM regions that front-ends let generated code access directly
+class drc_fastram_table
+{
+public:
+	static const int MAX_REGIONS = 16;
+
+	struct region
+	{
+		offs_t          start;              // start of the RAM block
+		offs_t          end;                // end of the RAM block
+		bool            readonly;           // true if writes must go through the handlers
+		void *          base;               // base in memory where the RAM lives
+	};
+
+	// construction/destruction
+	drc_fastram_table();
+
+	// getters
+	int count() const { return m_count; }
+	const region *begin() const { return &m_region[0]; }
+	const region *end() const { return &m_region[m_count]; }
+
+	// configuration; add returns true if code referencing the table is now stale
+	bool add(offs_t start, offs_t end, bool readonly, void *base);
+	void clear(int first = 0);
+
+	// code generation
+	void generate_access(drcuml_block &block, uml::code_label &labelnum, int size, bool iswrite, UINT32 addrxor, bool masked = false) const;
+
+private:
+	// internal state
+	int                 m_count;            // number of live regions
+	region              m_region[MAX_REGIONS]; // the regions, in priority order
+};
+
+
 #endif /* __DRCBEUT_H__ */
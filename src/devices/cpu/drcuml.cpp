@@ -121,7 +121,7 @@ drcbe_interface::~drcbe_interface()
 drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits)
 	: m_device(device),
 		m_cache(cache),
-		m_drcbe_interface(device.machine().options().drc_use_c() ?
+		m_drcbe_interface(((flags & DRCUML_OPTION_USE_C) || (device.machine().options().drc_use_c() && !(flags & DRCUML_OPTION_USE_NATIVE))) ?
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_c>(*this, device, cache, flags, modes, addrbits, ignorebits) } :
 			std::unique_ptr<drcbe_interface>{ std::make_unique<drcbe_native>(*this, device, cache, flags, modes, addrbits, ignorebits) }),
 		m_beintf(*m_drcbe_interface.get()),
@@ -22,7 +22,8 @@
 //**************************************************************************
 
 // these options are passed into drcuml_alloc() and control global behaviors
-
+const UINT32 DRCUML_OPTION_USE_C        = 0x0001;   // always use the C back-end
+const UINT32 DRCUML_OPTION_USE_NATIVE   = 0x0002;   // always use the native back-end, regardless of -drc_use_c
 
 
 //**************************************************************************
@@ -27,6 +27,9 @@
 /* seems to be defined on mingw-gcc */
 #undef i386
 
+/* size of the execution code cache */
+#define CACHE_SIZE                      (16 * 1024 * 1024)
+
 const device_type I386 = &device_creator<i386_device>;
 const device_type I386SX = &device_creator<i386SX_device>;
 const device_type I486 = &device_creator<i486_device>;
@@ -45,6 +48,20 @@ i386_device::i386_device(const machine_config &mconfig, const char *tag, device_
 	, m_program_config("program", ENDIANNESS_LITTLE, 32, 32, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, 32, 16, 0)
 	, m_smiact(*this)
+	, m_cache(CACHE_SIZE + sizeof(internal_i386_state))
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_drcfe_hot(nullptr)
+	, m_core(nullptr)
+	, m_drcoptions(0)
+	, m_cache_dirty(0)
+	, m_isdrc(false)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
+	, m_interpret(nullptr)
+	, m_tlb_mismatch(nullptr)
+	, m_recompile(nullptr)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
@@ -60,6 +77,20 @@ i386_device::i386_device(const machine_config &mconfig, device_type type, const
 	, m_program_config("program", ENDIANNESS_LITTLE, program_data_width, program_addr_width, 0)
 	, m_io_config("io", ENDIANNESS_LITTLE, io_data_width, 16, 0)
 	, m_smiact(*this)
+	, m_cache(CACHE_SIZE + sizeof(internal_i386_state))
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_drcfe_hot(nullptr)
+	, m_core(nullptr)
+	, m_drcoptions(0)
+	, m_cache_dirty(0)
+	, m_isdrc(false)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
+	, m_interpret(nullptr)
+	, m_tlb_mismatch(nullptr)
+	, m_recompile(nullptr)
 {
 	m_program_config.m_logaddr_width = 32;
 	m_program_config.m_page_shift = 12;
@@ -3203,6 +3234,7 @@ void i386_device::i386_postload()
 	for (i = 0; i < 6; i++)
 		i386_load_segment_descriptor(i);
 	CHANGE_PC(m_eip);
+	m_cache_dirty = TRUE;
 }
 
 void i386_device::i386_common_init()
@@ -3243,6 +3275,7 @@ void i386_device::i386_common_init()
 	m_lock = false;
 
 	zero_state();
+	drc_init();
 
 	save_item(NAME(m_reg.d));
 	save_item(NAME(m_sreg[ES].selector));
@@ -3329,6 +3362,13 @@ void i386_device::device_start()
 	register_state_i386();
 }
 
+void i386_device::device_stop()
+{
+	m_drcfe = nullptr;
+	m_drcfe_hot = nullptr;
+	m_drcuml = nullptr;
+}
+
 void i386_device::register_state_i386()
 {
 	state_add( I386_PC,         "PC", m_pc).formatstr("%08X");
@@ -3693,6 +3733,7 @@ void i386_device::zero_state()
 	m_opcode = 0;
 	m_irq_state = 0;
 	m_a20_mask = 0;
+	m_cache_dirty = TRUE;
 	m_cpuid_max_input_value_eax = 0;
 	m_cpuid_id0 = 0;
 	m_cpuid_id1 = 0;
@@ -3917,6 +3958,51 @@ void i386_device::i386_set_a20_line(int state)
 	}
 	// TODO: how does A20M and the tlb interact
 	vtlb_flush_dynamic();
+	m_cache_dirty = TRUE;
+}
+
+void i386_device::i386_execute_one()
+{
+	m_operand_size = m_sreg[CS].d;
+	m_xmm_operand_size = 0;
+	m_address_size = m_sreg[CS].d;
+	m_operand_prefix = 0;
+	m_address_prefix = 0;
+
+	m_ext = 1;
+	int old_tf = m_TF;
+
+	m_segment_prefix = 0;
+	m_prev_eip = m_eip;
+
+	debugger_instruction_hook(this, m_pc);
+
+	if(m_delayed_interrupt_enable != 0)
+	{
+		m_IF = 1;
+		m_delayed_interrupt_enable = 0;
+	}
+#ifdef DEBUG_MISSING_OPCODE
+	m_opcode_bytes_length = 0;
+	m_opcode_pc = m_pc;
+#endif
+	try
+	{
+		i386_decode_opcode();
+		if(m_TF && old_tf)
+		{
+			m_prev_eip = m_eip;
+			m_ext = 1;
+			i386_trap(1,0,0);
+		}
+		if(m_lock && (m_opcode != 0xf0))
+			m_lock = false;
+	}
+	catch(UINT64 e)
+	{
+		m_ext = 1;
+		i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+	}
 }
 
 void i386_device::execute_run()
@@ -3932,53 +4018,91 @@ void i386_device::execute_run()
 		return;
 	}
 
-	while( m_cycles > 0 )
+	/* the debugger needs to see every instruction, so it always gets the interpreter */
+	if (m_isdrc && (machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
+		execute_run_drc();
+	else
 	{
-		i386_check_irq_line();
-		m_operand_size = m_sreg[CS].d;
-		m_xmm_operand_size = 0;
-		m_address_size = m_sreg[CS].d;
-		m_operand_prefix = 0;
-		m_address_prefix = 0;
-
-		m_ext = 1;
-		int old_tf = m_TF;
-
-		m_segment_prefix = 0;
-		m_prev_eip = m_eip;
-
-		debugger_instruction_hook(this, m_pc);
-
-		if(m_delayed_interrupt_enable != 0)
+		while( m_cycles > 0 )
 		{
-			m_IF = 1;
-			m_delayed_interrupt_enable = 0;
-		}
-#ifdef DEBUG_MISSING_OPCODE
-		m_opcode_bytes_length = 0;
-		m_opcode_pc = m_pc;
-#endif
-		try
-		{
-			i386_decode_opcode();
-			if(m_TF && old_tf)
-			{
-				m_prev_eip = m_eip;
-				m_ext = 1;
-				i386_trap(1,0,0);
-			}
-			if(m_lock && (m_opcode != 0xf0))
-				m_lock = false;
-		}
-		catch(UINT64 e)
-		{
-			m_ext = 1;
-			i386_trap_with_error(e&0xffffffff,0,0,e>>32);
+			i386_check_irq_line();
+			i386_execute_one();
 		}
 	}
 	m_tsc += (cycles - m_cycles);
 }
 
+/*-------------------------------------------------
+    drc_mode - return the recompiler mode for the
+    current state, or 0 if only the interpreter
+    can run it
+-------------------------------------------------*/
+
+int i386_device::drc_mode() const
+{
+	/* real, V86 and 16-bit code, SMM, single-stepping and interrupt shadows stay in the interpreter */
+	if (!(m_cr[0] & 1) || m_VM || !m_sreg[CS].d || m_smm || m_TF || m_lock || m_delayed_interrupt_enable || m_halted)
+		return 0;
+
+	/* paging changes what a given linear PC means, and supervisor/user checks differ */
+	if (!(m_cr[0] & 0x80000000))
+		return 1;
+	return (m_CPL == 3) ? 3 : 2;
+}
+
+
+/*-------------------------------------------------
+    drc_load_core - copy the interpreter state
+    into the recompiler's state
+-------------------------------------------------*/
+
+void i386_device::drc_load_core()
+{
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_core->r[regnum] = m_reg.d[regnum];
+	m_core->pc = m_pc;
+	m_core->cf = m_CF;
+	m_core->zf = m_ZF;
+	m_core->sf = m_SF;
+	m_core->of = m_OF;
+	m_core->pf = m_PF;
+	m_core->af = m_AF;
+	m_core->icount = m_cycles;
+	m_core->mode = drc_mode();
+	m_core->service = ((m_irq_state && m_IF) || (m_smi && !m_smm) || m_cache_dirty) ? 1 : 0;
+}
+
+
+/*-------------------------------------------------
+    drc_store_core - copy the recompiler's state
+    back to the interpreter
+-------------------------------------------------*/
+
+void i386_device::drc_store_core()
+{
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_reg.d[regnum] = m_core->r[regnum];
+	m_pc = m_core->pc;
+	m_eip = m_pc - m_sreg[CS].base;
+	m_CF = m_core->cf;
+	m_ZF = m_core->zf;
+	m_SF = m_core->sf;
+	m_OF = m_core->of;
+	m_PF = m_core->pf;
+	m_AF = m_core->af;
+	m_cycles = m_core->icount;
+}
+
+bool i386_device::drc_translate_fetch(offs_t &address)
+{
+	UINT32 error;
+
+	if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
+		return false;
+	address &= m_a20_mask;
+	return true;
+}
+
 /*************************************************************************/
 
 bool i386_device::memory_translate(address_spacenum spacenum, int intention, offs_t &address)
@@ -9,6 +9,8 @@
 #include "softfloat/softfloat.h"
 #include "debug/debugcpu.h"
 #include "divtlb.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
 
 
 #define INPUT_LINE_A20      1
@@ -24,8 +26,24 @@
 
 #define X86_NUM_CPUS        4
 
+
+/***************************************************************************
+    COMPILER-SPECIFIC OPTIONS
+***************************************************************************/
+
+#define I386DRC_STRICT_VERIFY       0x0001          /* verify all instructions */
+#define I386DRC_SINGLE_TIER         0x0002          /* compile everything with the full look-ahead straight away */
+
+#define I386DRC_COMPATIBLE_OPTIONS  (I386DRC_STRICT_VERIFY)
+#define I386DRC_FASTEST_OPTIONS     (0)
+
+
+class i386_frontend;
+
 class i386_device : public cpu_device, public device_vtlb_interface
 {
+	friend class i386_frontend;
+
 public:
 	// construction/destruction
 	i386_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
@@ -39,10 +57,14 @@ public:
 	UINT64 debug_segofftovirt(symbol_table &table, int params, const UINT64 *param);
 	UINT64 debug_virttophys(symbol_table &table, int params, const UINT64 *param);
 
+	void i386drc_set_options(UINT32 options);
+	void func_interpret();
+
 protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 	virtual void device_debug_setup() override;
 
 	// device_execute_interface overrides
@@ -1415,7 +1437,80 @@ struct I386_CALL_GATE
 	void pentium_smi();
 	void zero_state();
 	void i386_set_a20_line(int state);
+	void i386_execute_one();
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		UINT32              cycles;                     /* accumulated cycles */
+		UINT8               mode;                       /* mode being compiled */
+		uml::code_label     labelnum;                   /* index for local labels */
+	};
+
+	/* state that needs to be stored close to the generated DRC code */
+	struct internal_i386_state
+	{
+		UINT32      r[8];                               /* general purpose registers */
+		UINT32      pc;                                 /* linear PC */
+		UINT32      cf;                                 /* flags, one per word */
+		UINT32      zf;
+		UINT32      sf;
+		UINT32      of;
+		UINT32      pf;
+		UINT32      af;
+		UINT32      mode;                               /* recompiler mode (see drc_mode) */
+		UINT32      service;                            /* non-zero if an interrupt or flush is waiting */
+		INT32       icount;
+	};
 
+	/* core state */
+	drc_cache           m_cache;                        /* pointer to the DRC code cache */
+	std::unique_ptr<drcuml_state>      m_drcuml;        /* DRC UML generator state */
+	std::unique_ptr<i386_frontend>     m_drcfe;         /* pointer to the DRC front-end state for cold blocks */
+	std::unique_ptr<i386_frontend>     m_drcfe_hot;     /* pointer to the DRC front-end state for hot blocks */
+	internal_i386_state *m_core;
+	UINT32              m_drcoptions;                   /* configurable DRC options */
+	UINT8               m_cache_dirty;                  /* true if we need to flush the cache */
+	bool                m_isdrc;
+
+	/* parameters for subroutines */
+	uml::parameter      m_regmap[8];                    /* parameter to register mappings for all 8 integer registers */
+
+	/* internal stuff */
+	uml::code_handle *  m_entry;                        /* entry point */
+	uml::code_handle *  m_nocode;                       /* nocode exception handler */
+	uml::code_handle *  m_out_of_cycles;                /* out of cycles exception handler */
+	uml::code_handle *  m_interpret;                    /* single-step the interpreter */
+	uml::code_handle *  m_tlb_mismatch;                 /* tlb mismatch handler */
+	uml::code_handle *  m_recompile;                    /* hot block recompile request */
+
+	void drc_init();
+	int drc_mode() const;
+	void drc_load_core();
+	void drc_store_core();
+	void execute_run_drc();
+	void code_flush_cache();
+	void code_compile_block(UINT8 mode, offs_t pc, bool hot);
+	bool drc_translate_fetch(offs_t &address);
+
+	void alloc_handle(drcuml_state *drcuml, uml::code_handle **handleptr, const char *name);
+	void load_fast_iregs(drcuml_block *block);
+	void save_fast_iregs(drcuml_block *block);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_interpret_handler();
+	void static_generate_tlb_mismatch();
+	void static_generate_recompile_handler();
+
+	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
+	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_validate_tlb(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, bool checktlb);
+	bool generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc);
+	void generate_alu(drcuml_block *block, const opcode_desc *desc, int op, uml::parameter dst, uml::parameter src, bool keepcf);
+	void generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int cond, UINT32 takencycles);
+	void log_add_disasm_comment(drcuml_block *block, UINT32 pc, const UINT8 *oprom);
 };
 
 
@@ -1525,6 +1620,67 @@ protected:
 };
 
 
+class i386_frontend : public drc_frontend
+{
+public:
+	i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence);
+
+	/* instruction classes handled natively by the recompiler */
+	enum
+	{
+		INSN_ALU,                   /* ADD/OR/ADC/SBB/AND/SUB/XOR/CMP, plus TEST as op 8 */
+		INSN_MOV,
+		INSN_INC,
+		INSN_DEC,
+		INSN_NOP,
+		INSN_JCC,
+		INSN_JMP
+	};
+
+	enum
+	{
+		ALU_ADD = 0, ALU_OR, ALU_ADC, ALU_SBB, ALU_AND, ALU_SUB, ALU_XOR, ALU_CMP, ALU_TEST
+	};
+
+	/* register usage flags; integer registers live in regin/regout[0], flags in [1] */
+	enum
+	{
+		REGFLAG_CF = 0x01,
+		REGFLAG_ZF = 0x02,
+		REGFLAG_SF = 0x04,
+		REGFLAG_OF = 0x08,
+		REGFLAG_PF = 0x10,
+		REGFLAG_AF = 0x20,
+		REGFLAG_ALL = 0x3f
+	};
+
+	/* a decoded instruction; shared by the front-end and the code generator */
+	struct decoded_insn
+	{
+		UINT8       length;         /* length in bytes */
+		UINT8       kind;           /* INSN_* class */
+		UINT8       aluop;          /* ALU_* operation */
+		UINT8       dst;            /* destination register */
+		UINT8       src;            /* source register, if !srcimm */
+		bool        srcimm;         /* source is the immediate */
+		UINT8       cond;           /* condition code for INSN_JCC */
+		UINT32      imm;            /* immediate value or branch displacement */
+		int         cycles;         /* X86_CYCLES index (not taken, for branches) */
+		int         cycles_taken;   /* X86_CYCLES index when a branch is taken */
+	};
+
+	static bool decode(const UINT8 *oprom, int avail, decoded_insn &insn);
+
+protected:
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	bool describe_interpreted(opcode_desc &desc);
+
+	i386_device *m_i386;
+};
+
+
 extern const device_type I386;
 extern const device_type I386SX;
 extern const device_type I486;
@@ -0,0 +1,918 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    i386drc.cpp
+
+    Universal machine language-based i386 emulator.
+
+    The recompiler only runs 32-bit protected mode code outside of
+    V86 mode and SMM; everything else, and every instruction the
+    front-end does not describe natively, goes through the
+    interpreter one instruction at a time.  Outside of
+    drcuml_state::execute the interpreter's copy of the state is
+    authoritative; it is copied into m_core before running compiled
+    code and back out afterwards.
+
+    Code is compiled in two tiers.  New blocks are described with a
+    short look-ahead window so that the compile stall is small, and
+    carry a countdown at their entry.  When the countdown expires
+    the block is recompiled with the full window, which overrides
+    the hash table entries of the cold block so subsequent jumps
+    land in the hot code.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "debugger.h"
+#include "i386.h"
+#include "cpu/drcumlsh.h"
+
+extern int i386_parity_table[256];
+extern int i386_dasm_one(char *buffer, UINT32 pc, const UINT8 *oprom, int mode);
+
+using namespace uml;
+
+
+/***************************************************************************
+    CONSTANTS
+***************************************************************************/
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES           0
+#define EXECUTE_MISSING_CODE            1
+#define EXECUTE_RESET_CACHE             3
+#define EXECUTE_SERVICE                 4
+#define EXECUTE_RECOMPILE_HOT           5
+
+/* compilation boundaries -- how far back/forward does the analysis extend? */
+#define COMPILE_BACKWARDS_BYTES         128
+#define COMPILE_FORWARDS_BYTES          512
+#define COMPILE_MAX_SEQUENCE            64
+
+/* the same for blocks that have not proven to be hot yet */
+#define COMPILE_COLD_BACKWARDS_BYTES    0
+#define COMPILE_COLD_FORWARDS_BYTES     64
+#define COMPILE_COLD_MAX_SEQUENCE       16
+
+/* number of entries into a cold block before it is recompiled */
+#define COMPILE_HOT_THRESHOLD           32
+
+/* single instruction mode for debugging the recompiler */
+#define SINGLE_INSTRUCTION_MODE         (0)
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)        m_regmap[reg]
+
+/* interpreted instructions are the only ones the front-end marks as changing modes */
+#define DESC_IS_INTERPRETED(desc)   (((desc)->flags & OPFLAG_CAN_CHANGE_MODES) != 0)
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+void i386_device::alloc_handle(drcuml_state *drcuml, code_handle **handleptr, const char *name)
+{
+	if (*handleptr == nullptr)
+		*handleptr = drcuml->handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    load_fast_iregs - load any fast integer
+    registers
+-------------------------------------------------*/
+
+inline void i386_device::load_fast_iregs(drcuml_block *block)
+{
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+		if (m_regmap[regnum].is_int_register())
+			UML_MOV(block, ireg(m_regmap[regnum].ireg() - REG_I0), mem(&m_core->r[regnum]));
+}
+
+
+/*-------------------------------------------------
+    save_fast_iregs - save any fast integer
+    registers
+-------------------------------------------------*/
+
+inline void i386_device::save_fast_iregs(drcuml_block *block)
+{
+	for (int regnum = 0; regnum < ARRAY_LENGTH(m_regmap); regnum++)
+		if (m_regmap[regnum].is_int_register())
+			UML_MOV(block, mem(&m_core->r[regnum]), ireg(m_regmap[regnum].ireg() - REG_I0));
+}
+
+
+/*-------------------------------------------------
+    cfunc_interpret - run a single instruction
+    through the interpreter on behalf of
+    compiled code
+-------------------------------------------------*/
+
+static void cfunc_interpret(void *param)
+{
+	((i386_device *)param)->func_interpret();
+}
+
+void i386_device::func_interpret()
+{
+	drc_store_core();
+	i386_execute_one();
+	drc_load_core();
+}
+
+
+/***************************************************************************
+    CORE STATE
+***************************************************************************/
+
+/*-------------------------------------------------
+    drc_init - set up the recompiler; called
+    from i386_common_init
+-------------------------------------------------*/
+
+void i386_device::drc_init()
+{
+	static const char *const regnames[8] = { "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi" };
+	UINT32 flags = 0;
+
+	m_isdrc = (mconfig().options().drc() && !mconfig().m_force_no_drc) ? true : false;
+
+	/* allocate the implementation-specific state from the full cache */
+	m_core = (internal_i386_state *)m_cache.alloc_near(sizeof(internal_i386_state));
+	memset(m_core, 0, sizeof(internal_i386_state));
+
+	/* initialize the UML generator */
+	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, flags, 4, 32, 0);
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_core->pc, sizeof(m_core->pc), "pc");
+	m_drcuml->symbol_add(&m_core->icount, sizeof(m_core->icount), "icount");
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_drcuml->symbol_add(&m_core->r[regnum], sizeof(m_core->r[regnum]), regnames[regnum]);
+	m_drcuml->symbol_add(&m_core->cf, sizeof(m_core->cf), "cf");
+	m_drcuml->symbol_add(&m_core->zf, sizeof(m_core->zf), "zf");
+	m_drcuml->symbol_add(&m_core->sf, sizeof(m_core->sf), "sf");
+	m_drcuml->symbol_add(&m_core->of, sizeof(m_core->of), "of");
+	m_drcuml->symbol_add(&m_core->pf, sizeof(m_core->pf), "pf");
+	m_drcuml->symbol_add(&m_core->af, sizeof(m_core->af), "af");
+	m_drcuml->symbol_add(&m_core->mode, sizeof(m_core->mode), "mode");
+	m_drcuml->symbol_add(&m_core->service, sizeof(m_core->service), "service");
+
+	/* initialize the front-end helpers, one per tier */
+	m_drcfe = std::make_unique<i386_frontend>(this, COMPILE_COLD_BACKWARDS_BYTES, COMPILE_COLD_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_COLD_MAX_SEQUENCE);
+	m_drcfe_hot = std::make_unique<i386_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+
+	/* compute the register parameters */
+	for (int regnum = 0; regnum < 8; regnum++)
+		m_regmap[regnum] = uml::mem(&m_core->r[regnum]);
+
+	/* if we have registers to spare, keep EAX, ECX and EDX in them across blocks */
+	drcbe_info beinfo;
+	m_drcuml->get_backend_info(beinfo);
+	for (int regnum = 0; regnum < 3 && beinfo.direct_iregs > 4 + regnum; regnum++)
+		m_regmap[regnum] = uml::ireg(4 + regnum);
+
+	m_drcoptions = I386DRC_COMPATIBLE_OPTIONS;
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_cache_dirty = TRUE;
+}
+
+
+/*-------------------------------------------------
+    i386drc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void i386_device::i386drc_set_options(UINT32 options)
+{
+	if (!m_isdrc)
+		return;
+	m_drcoptions = options;
+}
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void i386_device::code_flush_cache()
+{
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and exception handlers */
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_interpret_handler();
+		static_generate_tlb_mismatch();
+		static_generate_recompile_handler();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate i386 static code\n");
+	}
+
+	m_cache_dirty = FALSE;
+}
+
+
+/*-------------------------------------------------
+    execute_run_drc - execute until out of cycles
+-------------------------------------------------*/
+
+void i386_device::execute_run_drc()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	int execute_result;
+
+	while (m_cycles > 0)
+	{
+		/* reset the cache if dirty */
+		if (m_cache_dirty)
+			code_flush_cache();
+
+		i386_check_irq_line();
+
+		/* step through anything the recompiler can't run, including interrupts still pending */
+		drc_load_core();
+		if (m_core->mode == 0 || m_core->service)
+		{
+			i386_execute_one();
+			continue;
+		}
+
+		/* run as much as we can */
+		execute_result = drcuml->execute(*m_entry);
+		drc_store_core();
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE || execute_result == EXECUTE_RECOMPILE_HOT)
+		{
+			int mode = drc_mode();
+			if (mode != 0)
+				code_compile_block(mode, m_pc, execute_result == EXECUTE_RECOMPILE_HOT || (m_drcoptions & I386DRC_SINGLE_TIER));
+		}
+		else if (execute_result == EXECUTE_RESET_CACHE)
+			code_flush_cache();
+	}
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc, at the cold
+    or the hot tier
+-------------------------------------------------*/
+
+void i386_device::code_compile_block(UINT8 mode, offs_t pc, bool hot)
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	int override = FALSE;
+	drcuml_block *block;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	desclist = hot ? m_drcfe_hot->describe_code(pc) : m_drcfe->describe_code(pc);
+
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			block = drcuml->begin_block(4096);
+			compiler.mode = mode;
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				UINT32 nextpc;
+
+				/* add a code log entry */
+				if (drcuml->logging())
+					block->append_comment("-------------------------");                 // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !drcuml->hash_exists(mode, seqhead->pc))
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = TRUE;
+					UML_HASH(block, mode, seqhead->pc);                                     // hash    mode,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                       // hashjmp <mode>,seqhead->pc,nocode
+					continue;
+				}
+
+				/* blocks are keyed by linear PC, which a CR3 write can point somewhere else; */
+				/* check the mapping on every entry, before trusting the checksum below */
+				generate_validate_tlb(block, &compiler, seqhead);
+
+				/* validate this code block if we're not pointing into ROM */
+				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
+					generate_checksum_block(block, &compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+
+				/* count entries into a cold block and ask for the hot version once it has earned it */
+				if (!hot && seqhead == desclist)
+				{
+					UINT32 *counter = (UINT32 *)m_cache.alloc_temporary(sizeof(UINT32));
+					if (counter == nullptr)
+						block->abort();
+					*counter = COMPILE_HOT_THRESHOLD;
+					UML_SUB(block, mem(counter), mem(counter), 1);                          // sub     [counter],[counter],1
+					UML_EXHc(block, COND_Z, *m_recompile, seqhead->pc);                     // exh     recompile,seqhead->pc,z
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, &compiler, curdesc, curdesc != seqhead);
+
+				/* jumps and interpreted instructions leave the sequence on their own */
+				if (seqlast->flags & OPFLAG_IS_UNCONDITIONAL_BRANCH)
+					continue;
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = seqlast->pc + seqlast->length;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, &compiler, nextpc, TRUE);                    // <subtract cycles>
+
+				/* if the next instruction isn't the next sequence, hash jump there */
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                            // hashjmp <mode>,nextpc,nocode
+			}
+
+			/* end the sequence */
+			block->end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void i386_device::static_generate_entry_point()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(20);
+
+	/* forward references */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+
+	alloc_handle(drcuml, &m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                        // handle  entry
+
+	/* load fast integer registers */
+	load_fast_iregs(block);
+
+	/* generate a hash jump via the current mode and PC */
+	UML_HASHJMP(block, mem(&m_core->mode), mem(&m_core->pc), *m_nocode);               // hashjmp <mode>,<pc>,nocode
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void i386_device::static_generate_nocode_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                       // handle  nocode
+	UML_GETEXP(block, I0);                                                              // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                               // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                              // exit    EXECUTE_MISSING_CODE
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void i386_device::static_generate_out_of_cycles()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                                // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                              // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                               // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                             // exit    EXECUTE_OUT_OF_CYCLES
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_interpret_handler - generate
+    a handler that single-steps the interpreter
+    at the exception PC and redispatches
+-------------------------------------------------*/
+
+void i386_device::static_generate_interpret_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(30);
+
+	alloc_handle(drcuml, &m_interpret, "interpret");
+	UML_HANDLE(block, *m_interpret);                                                    // handle  interpret
+	UML_GETEXP(block, I0);                                                              // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                               // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_CALLC(block, cfunc_interpret, this);                                            // callc   cfunc_interpret
+	load_fast_iregs(block);
+
+	/* the instruction may have used up our time, raised an interrupt or changed modes */
+	UML_CMP(block, mem(&m_core->icount), 0);                                            // cmp     [icount],0
+	UML_EXITc(block, COND_LE, EXECUTE_OUT_OF_CYCLES);                                   // exit    EXECUTE_OUT_OF_CYCLES,le
+	UML_CMP(block, mem(&m_core->service), 0);                                           // cmp     [service],0
+	UML_EXITc(block, COND_NE, EXECUTE_SERVICE);                                         // exit    EXECUTE_SERVICE,ne
+	UML_HASHJMP(block, mem(&m_core->mode), mem(&m_core->pc), *m_nocode);               // hashjmp <mode>,<pc>,nocode
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_tlb_mismatch - generate a
+    TLB mismatch handler
+-------------------------------------------------*/
+
+void i386_device::static_generate_tlb_mismatch()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(30);
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(drcuml, &m_tlb_mismatch, "tlb_mismatch");
+	UML_HANDLE(block, *m_tlb_mismatch);                                                 // handle  tlb_mismatch
+	UML_GETEXP(block, I0);                                                              // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                               // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_SHR(block, I1, I0, 12);                                                         // shr     i1,i0,12
+	UML_LOAD(block, I1, (void *)vtlb_table(), I1, SIZE_DWORD, SCALE_x4);                // load    i1,[vtlb_table],i1,dword
+
+	/* a valid entry means the mapping changed under us; recompile against the new one */
+	UML_TEST(block, I1, VTLB_FLAG_VALID);                                               // test    i1,VTLB_FLAG_VALID
+	UML_EXITc(block, COND_NZ, EXECUTE_MISSING_CODE);                                    // exit    EXECUTE_MISSING_CODE,nz
+
+	/* otherwise let the interpreter fetch it and take any page fault */
+	UML_EXH(block, *m_interpret, I0);                                                   // exh     interpret,i0
+
+	block->end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_recompile_handler - generate
+    a handler that leaves compiled code so that
+    a hot block can be recompiled
+-------------------------------------------------*/
+
+void i386_device::static_generate_recompile_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	alloc_handle(drcuml, &m_recompile, "recompile");
+	UML_HANDLE(block, *m_recompile);                                                    // handle  recompile
+	UML_GETEXP(block, I0);                                                              // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                               // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_RECOMPILE_HOT);                                             // exit    EXECUTE_RECOMPILE_HOT
+
+	block->end();
+}
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out
+-------------------------------------------------*/
+
+void i386_device::generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception)
+{
+	/* account for cycles */
+	if (compiler->cycles > 0)
+	{
+		UML_SUB(block, mem(&m_core->icount), mem(&m_core->icount), compiler->cycles);   // sub     icount,icount,cycles
+		if (allow_exception)
+			UML_EXHc(block, COND_S, *m_out_of_cycles, param);                           // exh     out_of_cycles,nextpc
+	}
+	compiler->cycles = 0;
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void i386_device::generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	bool loaded = false;
+	UINT32 sum = 0;
+
+	if (m_drcuml->logging())
+		block->append_comment("[Validation for %08X]", seqhead->pc);                    // comment
+
+	/* sum the instruction bytes a dword at a time where we can; loose verify only checks the first instruction */
+	for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+	{
+		if (DESC_IS_INTERPRETED(curdesc))
+			continue;
+
+		const UINT8 *base = (const UINT8 *)m_direct->read_ptr(curdesc->physpc);
+		for (int offset = 0; offset < curdesc->length; )
+		{
+			int size = (curdesc->length - offset >= 4) ? 4 : 1;
+			UINT32 value;
+
+			if (size == 4)
+			{
+				memcpy(&value, &base[offset], 4);
+				UML_LOAD(block, loaded ? I1 : I0, &base[offset], 0, SIZE_DWORD, SCALE_x1);   // load    i1,base,dword
+			}
+			else
+			{
+				value = base[offset];
+				UML_LOAD(block, loaded ? I1 : I0, &base[offset], 0, SIZE_BYTE, SCALE_x1);    // load    i1,base,byte
+			}
+			if (loaded)
+				UML_ADD(block, I0, I0, I1);                                             // add     i0,i0,i1
+			loaded = true;
+			sum += value;
+			offset += size;
+		}
+
+		if (!(m_drcoptions & I386DRC_STRICT_VERIFY))
+			break;
+	}
+
+	if (loaded)
+	{
+		UML_CMP(block, I0, sum);                                                        // cmp     i0,sum
+		UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                               // exne    nocode,seqhead->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_validate_tlb - generate code to check
+    that the TLB entry for an instruction still
+    maps the page it was compiled from
+-------------------------------------------------*/
+
+void i386_device::generate_validate_tlb(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	/* without paging a linear PC always means the same thing */
+	if (compiler->mode >= 2 && !DESC_IS_INTERPRETED(desc))
+	{
+		const vtlb_entry *tlbtable = vtlb_table();
+
+		/* if we currently have a valid TLB entry, we just verify */
+		if (tlbtable[desc->pc >> 12] & VTLB_FLAG_VALID)
+		{
+			UML_LOAD(block, I0, &tlbtable[desc->pc >> 12], 0, SIZE_DWORD, SCALE_x4);   // load    i0,tlbtable[desc->pc >> 12],0,dword
+			UML_CMP(block, I0, tlbtable[desc->pc >> 12]);                               // cmp     i0,*tlbentry
+			UML_EXHc(block, COND_NE, *m_tlb_mismatch, desc->pc);                        // exh     tlb_mismatch,desc->pc,NE
+		}
+
+		/* otherwise, we generate an unconditional exception */
+		else
+			UML_EXH(block, *m_tlb_mismatch, desc->pc);                                  // exh     tlb_mismatch,desc->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void i386_device::generate_sequence_instruction(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, bool checktlb)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging())
+		log_add_disasm_comment(block, desc->pc, desc->opptr.b);
+
+	/* validate our TLB entry at this PC if we cross into a new page; sequence heads were checked on entry */
+	if (checktlb && (desc->flags & OPFLAG_VALIDATE_TLB))
+		generate_validate_tlb(block, compiler, desc);
+
+	/* if this is something we can't compile, count off cycles and let the interpreter do it */
+	if (DESC_IS_INTERPRETED(desc) || !generate_opcode(block, compiler, desc))
+	{
+		generate_update_cycles(block, compiler, desc->pc, TRUE);                        // <subtract cycles>
+		UML_EXH(block, *m_interpret, desc->pc);                                         // exh     interpret,desc->pc
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a single
+    natively handled opcode
+-------------------------------------------------*/
+
+bool i386_device::generate_opcode(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc)
+{
+	i386_frontend::decoded_insn insn;
+
+	if (!i386_frontend::decode(desc->opptr.b, desc->length, insn))
+		return false;
+
+	/* accumulate total cycles; branches add their taken cost separately */
+	compiler->cycles += desc->cycles;
+
+	switch (insn.kind)
+	{
+		case i386_frontend::INSN_ALU:
+			generate_alu(block, desc, insn.aluop, R32(insn.dst), insn.srcimm ? uml::parameter(insn.imm) : R32(insn.src), false);
+			return true;
+
+		case i386_frontend::INSN_MOV:
+			UML_MOV(block, R32(insn.dst), insn.srcimm ? uml::parameter(insn.imm) : R32(insn.src));   // mov     <dst>,<src>
+			return true;
+
+		case i386_frontend::INSN_INC:
+			generate_alu(block, desc, i386_frontend::ALU_ADD, R32(insn.dst), 1, true);
+			return true;
+
+		case i386_frontend::INSN_DEC:
+			generate_alu(block, desc, i386_frontend::ALU_SUB, R32(insn.dst), 1, true);
+			return true;
+
+		case i386_frontend::INSN_NOP:
+			return true;
+
+		case i386_frontend::INSN_JCC:
+			generate_branch(block, compiler, desc, insn.cond, m_cycle_table_pm[insn.cycles_taken]);
+			return true;
+
+		case i386_frontend::INSN_JMP:
+			generate_branch(block, compiler, desc, -1, m_cycle_table_pm[insn.cycles_taken]);
+			return true;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_alu - generate a 32-bit ALU
+    operation, computing only the flags that
+    are read before being overwritten
+-------------------------------------------------*/
+
+void i386_device::generate_alu(drcuml_block *block, const opcode_desc *desc, int op, uml::parameter dst, uml::parameter src, bool keepcf)
+{
+	UINT32 req = desc->regreq[1];
+	bool arith = true;
+
+	switch (op)
+	{
+		case i386_frontend::ALU_ADD:
+			UML_ADD(block, I0, dst, src);                                               // add     i0,dst,src
+			break;
+
+		case i386_frontend::ALU_ADC:
+			UML_CARRY(block, mem(&m_core->cf), 0);                                      // carry   [cf],0
+			UML_ADDC(block, I0, dst, src);                                              // addc    i0,dst,src
+			break;
+
+		case i386_frontend::ALU_SUB:
+		case i386_frontend::ALU_CMP:
+			UML_SUB(block, I0, dst, src);                                               // sub     i0,dst,src
+			break;
+
+		case i386_frontend::ALU_SBB:
+			UML_CARRY(block, mem(&m_core->cf), 0);                                      // carry   [cf],0
+			UML_SUBB(block, I0, dst, src);                                              // subb    i0,dst,src
+			break;
+
+		case i386_frontend::ALU_OR:
+			UML_OR(block, I0, dst, src);                                                // or      i0,dst,src
+			arith = false;
+			break;
+
+		case i386_frontend::ALU_AND:
+		case i386_frontend::ALU_TEST:
+			UML_AND(block, I0, dst, src);                                               // and     i0,dst,src
+			arith = false;
+			break;
+
+		case i386_frontend::ALU_XOR:
+			UML_XOR(block, I0, dst, src);                                               // xor     i0,dst,src
+			arith = false;
+			break;
+	}
+
+	/* capture the UML flags straight away; SET leaves them intact for the next one */
+	if (arith && !keepcf && (req & i386_frontend::REGFLAG_CF))
+		UML_SETc(block, COND_C, mem(&m_core->cf));                                      // setc    [cf],c
+	if (arith && (req & i386_frontend::REGFLAG_OF))
+		UML_SETc(block, COND_V, mem(&m_core->of));                                      // setc    [of],v
+	if (req & i386_frontend::REGFLAG_ZF)
+		UML_SETc(block, COND_Z, mem(&m_core->zf));                                      // setc    [zf],z
+	if (req & i386_frontend::REGFLAG_SF)
+		UML_SETc(block, COND_S, mem(&m_core->sf));                                      // setc    [sf],s
+
+	/* the logical operations clear CF and OF and leave AF alone */
+	if (!arith)
+	{
+		if (req & i386_frontend::REGFLAG_CF)
+			UML_MOV(block, mem(&m_core->cf), 0);                                        // mov     [cf],0
+		if (req & i386_frontend::REGFLAG_OF)
+			UML_MOV(block, mem(&m_core->of), 0);                                        // mov     [of],0
+	}
+	else if (req & i386_frontend::REGFLAG_AF)
+	{
+		UML_XOR(block, I1, dst, src);                                                   // xor     i1,dst,src
+		UML_XOR(block, I1, I1, I0);                                                     // xor     i1,i1,i0
+		UML_ROLAND(block, mem(&m_core->af), I1, 32-4, 1);                               // roland  [af],i1,28,1
+	}
+
+	if (req & i386_frontend::REGFLAG_PF)
+	{
+		UML_AND(block, I1, I0, 0xff);                                                   // and     i1,i0,0xff
+		UML_LOAD(block, mem(&m_core->pf), i386_parity_table, I1, SIZE_DWORD, SCALE_x4); // load    [pf],parity_table,i1,dword
+	}
+
+	if (op != i386_frontend::ALU_CMP && op != i386_frontend::ALU_TEST)
+		UML_MOV(block, dst, I0);                                                        // mov     dst,i0
+}
+
+
+/*-------------------------------------------------
+    generate_branch - generate a conditional
+    (cond >= 0) or unconditional near branch
+-------------------------------------------------*/
+
+void i386_device::generate_branch(drcuml_block *block, compiler_state *compiler, const opcode_desc *desc, int cond, UINT32 takencycles)
+{
+	compiler_state compiler_temp = *compiler;
+	compiler_state *taken = (cond >= 0) ? &compiler_temp : compiler;
+	code_label skip = compiler->labelnum++;
+
+	if (cond >= 0)
+	{
+		/* evaluate the condition; the low bit of the condition code inverts it */
+		switch (cond >> 1)
+		{
+			case 0:     /* O */
+				UML_TEST(block, mem(&m_core->of), 1);                                   // test    [of],1
+				break;
+			case 1:     /* B */
+				UML_TEST(block, mem(&m_core->cf), 1);                                   // test    [cf],1
+				break;
+			case 2:     /* Z */
+				UML_TEST(block, mem(&m_core->zf), 1);                                   // test    [zf],1
+				break;
+			case 3:     /* BE */
+				UML_OR(block, I0, mem(&m_core->cf), mem(&m_core->zf));                  // or      i0,[cf],[zf]
+				break;
+			case 4:     /* S */
+				UML_TEST(block, mem(&m_core->sf), 1);                                   // test    [sf],1
+				break;
+			case 5:     /* P */
+				UML_TEST(block, mem(&m_core->pf), 1);                                   // test    [pf],1
+				break;
+			case 6:     /* L */
+				UML_XOR(block, I0, mem(&m_core->sf), mem(&m_core->of));                 // xor     i0,[sf],[of]
+				break;
+			case 7:     /* LE */
+				UML_XOR(block, I0, mem(&m_core->sf), mem(&m_core->of));                 // xor     i0,[sf],[of]
+				UML_OR(block, I0, I0, mem(&m_core->zf));                                // or      i0,i0,[zf]
+				break;
+		}
+		UML_JMPc(block, (cond & 1) ? COND_NZ : COND_Z, skip);                           // jmp     skip,<not taken>
+
+		/* the not-taken cost is already in the count */
+		compiler_temp.cycles += takencycles - desc->cycles;
+	}
+
+	/* count off cycles and go to the target */
+	generate_update_cycles(block, taken, desc->targetpc, TRUE);                         // <subtract cycles>
+	if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+		UML_JMP(block, desc->targetpc | 0x80000000);                                    // jmp     desc->targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, compiler->mode, desc->targetpc, *m_nocode);                  // hashjmp <mode>,desc->targetpc,nocode
+
+	if (cond >= 0)
+		UML_LABEL(block, skip);                                                         // skip:
+}
+
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an i386 instruction
+-------------------------------------------------*/
+
+void i386_device::log_add_disasm_comment(drcuml_block *block, UINT32 pc, const UINT8 *oprom)
+{
+	if (m_drcuml->logging())
+	{
+		char buffer[100];
+
+		i386_dasm_one(buffer, pc, oprom, 32);
+		block->append_comment("%08X: %s", pc, buffer);                                  // comment
+	}
+}
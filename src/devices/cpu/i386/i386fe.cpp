@@ -0,0 +1,322 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    i386fe.cpp
+
+    Front-end for the i386 recompiler.
+
+    Only a small, frequently executed subset of the 32-bit integer
+    instruction set is described natively: register-to-register ALU
+    and MOV forms, INC/DEC, NOP and near relative jumps.  Everything
+    else (memory operands, prefixes, x87, system instructions, or any
+    instruction that faults while being fetched) is described as an
+    "interpreted" instruction that hands control back to the
+    interpreter for a single step.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "i386.h"
+#include "cycles.h"
+#include "cpu/drcfe.h"
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define REGFLAG_R(n)    (1 << (n))
+
+
+/***************************************************************************
+    INSTRUCTION PARSERS
+***************************************************************************/
+
+i386_frontend::i386_frontend(i386_device *device, UINT32 window_start, UINT32 window_end, UINT32 max_sequence)
+	: drc_frontend(*device, window_start, window_end, max_sequence)
+	, m_i386(device)
+{
+}
+
+
+/*-------------------------------------------------
+    decode - decode a single 32-bit instruction
+    from the given bytes; returns false if the
+    instruction is not one the recompiler handles
+-------------------------------------------------*/
+
+bool i386_frontend::decode(const UINT8 *oprom, int avail, decoded_insn &insn)
+{
+	memset(&insn, 0, sizeof(insn));
+	if (avail < 1)
+		return false;
+
+	UINT8 op = oprom[0];
+
+	/* ALU r/m32,r32 and r32,r/m32 */
+	if (op < 0x40 && ((op & 7) == 1 || (op & 7) == 3))
+	{
+		if (avail < 2 || oprom[1] < 0xc0)
+			return false;
+		insn.kind = INSN_ALU;
+		insn.aluop = (op >> 3) & 7;
+		insn.length = 2;
+		insn.dst = (op & 2) ? ((oprom[1] >> 3) & 7) : (oprom[1] & 7);
+		insn.src = (op & 2) ? (oprom[1] & 7) : ((oprom[1] >> 3) & 7);
+		insn.cycles = (insn.aluop == ALU_CMP) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG;
+		return true;
+	}
+
+	/* ALU EAX,imm32 */
+	if (op < 0x40 && (op & 7) == 5)
+	{
+		if (avail < 5)
+			return false;
+		insn.kind = INSN_ALU;
+		insn.aluop = (op >> 3) & 7;
+		insn.length = 5;
+		insn.dst = 0;
+		insn.srcimm = true;
+		insn.imm = oprom[1] | (oprom[2] << 8) | (oprom[3] << 16) | (oprom[4] << 24);
+		insn.cycles = (insn.aluop == ALU_CMP) ? CYCLES_CMP_IMM_ACC : CYCLES_ALU_IMM_ACC;
+		return true;
+	}
+
+	switch (op)
+	{
+		case 0x0f:  /* Jcc rel32 */
+			if (avail < 6 || (oprom[1] & 0xf0) != 0x80)
+				return false;
+			insn.kind = INSN_JCC;
+			insn.cond = oprom[1] & 0x0f;
+			insn.length = 6;
+			insn.imm = oprom[2] | (oprom[3] << 8) | (oprom[4] << 16) | (oprom[5] << 24);
+			insn.cycles = CYCLES_JCC_FULL_DISP_NOBRANCH;
+			insn.cycles_taken = CYCLES_JCC_FULL_DISP;
+			return true;
+
+		case 0x40: case 0x41: case 0x42: case 0x43:     /* INC r32 */
+		case 0x44: case 0x45: case 0x46: case 0x47:
+			insn.kind = INSN_INC;
+			insn.length = 1;
+			insn.dst = op & 7;
+			insn.cycles = CYCLES_INC_REG;
+			return true;
+
+		case 0x48: case 0x49: case 0x4a: case 0x4b:     /* DEC r32 */
+		case 0x4c: case 0x4d: case 0x4e: case 0x4f:
+			insn.kind = INSN_DEC;
+			insn.length = 1;
+			insn.dst = op & 7;
+			insn.cycles = CYCLES_DEC_REG;
+			return true;
+
+		case 0x70: case 0x71: case 0x72: case 0x73:     /* Jcc rel8 */
+		case 0x74: case 0x75: case 0x76: case 0x77:
+		case 0x78: case 0x79: case 0x7a: case 0x7b:
+		case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+			if (avail < 2)
+				return false;
+			insn.kind = INSN_JCC;
+			insn.cond = op & 0x0f;
+			insn.length = 2;
+			insn.imm = (INT32)(INT8)oprom[1];
+			insn.cycles = CYCLES_JCC_DISP8_NOBRANCH;
+			insn.cycles_taken = CYCLES_JCC_DISP8;
+			return true;
+
+		case 0x81:  /* group 1 r32,imm32 */
+		case 0x83:  /* group 1 r32,imm8 */
+			if (avail < ((op == 0x81) ? 6 : 3) || oprom[1] < 0xc0)
+				return false;
+			insn.kind = INSN_ALU;
+			insn.aluop = (oprom[1] >> 3) & 7;
+			insn.dst = oprom[1] & 7;
+			insn.srcimm = true;
+			if (op == 0x81)
+			{
+				insn.length = 6;
+				insn.imm = oprom[2] | (oprom[3] << 8) | (oprom[4] << 16) | (oprom[5] << 24);
+			}
+			else
+			{
+				insn.length = 3;
+				insn.imm = (INT32)(INT8)oprom[2];
+			}
+			insn.cycles = (insn.aluop == ALU_CMP) ? CYCLES_CMP_REG_REG : CYCLES_ALU_REG_REG;
+			return true;
+
+		case 0x85:  /* TEST r/m32,r32 */
+		case 0x89:  /* MOV r/m32,r32 */
+		case 0x8b:  /* MOV r32,r/m32 */
+			if (avail < 2 || oprom[1] < 0xc0)
+				return false;
+			insn.kind = (op == 0x85) ? INSN_ALU : INSN_MOV;
+			insn.aluop = ALU_TEST;
+			insn.length = 2;
+			insn.dst = (op == 0x8b) ? ((oprom[1] >> 3) & 7) : (oprom[1] & 7);
+			insn.src = (op == 0x8b) ? (oprom[1] & 7) : ((oprom[1] >> 3) & 7);
+			insn.cycles = (op == 0x85) ? CYCLES_TEST_REG_REG : CYCLES_MOV_REG_REG;
+			return true;
+
+		case 0x90:  /* NOP */
+			insn.kind = INSN_NOP;
+			insn.length = 1;
+			insn.cycles = CYCLES_NOP;
+			return true;
+
+		case 0xa9:  /* TEST EAX,imm32 */
+			if (avail < 5)
+				return false;
+			insn.kind = INSN_ALU;
+			insn.aluop = ALU_TEST;
+			insn.length = 5;
+			insn.dst = 0;
+			insn.srcimm = true;
+			insn.imm = oprom[1] | (oprom[2] << 8) | (oprom[3] << 16) | (oprom[4] << 24);
+			insn.cycles = CYCLES_TEST_IMM_ACC;
+			return true;
+
+		case 0xb8: case 0xb9: case 0xba: case 0xbb:     /* MOV r32,imm32 */
+		case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+			if (avail < 5)
+				return false;
+			insn.kind = INSN_MOV;
+			insn.length = 5;
+			insn.dst = op & 7;
+			insn.srcimm = true;
+			insn.imm = oprom[1] | (oprom[2] << 8) | (oprom[3] << 16) | (oprom[4] << 24);
+			insn.cycles = CYCLES_MOV_IMM_REG;
+			return true;
+
+		case 0xe9:  /* JMP rel32 */
+			if (avail < 5)
+				return false;
+			insn.kind = INSN_JMP;
+			insn.length = 5;
+			insn.imm = oprom[1] | (oprom[2] << 8) | (oprom[3] << 16) | (oprom[4] << 24);
+			insn.cycles = insn.cycles_taken = CYCLES_JMP;
+			return true;
+
+		case 0xeb:  /* JMP rel8 */
+			if (avail < 2)
+				return false;
+			insn.kind = INSN_JMP;
+			insn.length = 2;
+			insn.imm = (INT32)(INT8)oprom[1];
+			insn.cycles = insn.cycles_taken = CYCLES_JMP_SHORT;
+			return true;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    describe - build a description of a single
+    instruction
+-------------------------------------------------*/
+
+bool i386_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	/* start a new sequence at each page boundary so that only sequence heads need TLB checks */
+	if ((desc.pc & 0xfff) == 0)
+		desc.flags |= OPFLAG_IS_BRANCH_TARGET;
+
+	/* compute the physical PC; let the interpreter raise any page fault */
+	if (!m_i386->drc_translate_fetch(desc.physpc))
+	{
+		desc.flags |= OPFLAG_COMPILER_PAGE_FAULT;
+		return describe_interpreted(desc);
+	}
+
+	/* copy the opcode bytes, stopping at the end of the page or of directly readable memory */
+	const UINT8 *base = (const UINT8 *)m_i386->m_direct->read_ptr(desc.physpc);
+	int avail = 0;
+	if (base != nullptr)
+	{
+		int limit = MIN(0x1000 - (desc.pc & 0xfff), (int)sizeof(desc.opptr.b));
+		for (avail = 1; avail < limit; avail++)
+			if (m_i386->m_direct->read_ptr(desc.physpc + avail) != base + avail)
+				break;
+		memcpy(desc.opptr.b, base, avail);
+	}
+
+	decoded_insn insn;
+	if (!decode(desc.opptr.b, avail, insn))
+		return describe_interpreted(desc);
+
+	const UINT8 *cycles = m_i386->m_cycle_table_pm;
+	desc.length = insn.length;
+	desc.cycles = cycles[insn.cycles];
+
+	switch (insn.kind)
+	{
+		case INSN_ALU:
+			desc.regin[0] |= REGFLAG_R(insn.dst);
+			if (!insn.srcimm)
+				desc.regin[0] |= REGFLAG_R(insn.src);
+			if (insn.aluop == ALU_ADC || insn.aluop == ALU_SBB)
+				desc.regin[1] |= REGFLAG_CF;
+			if (insn.aluop != ALU_CMP && insn.aluop != ALU_TEST)
+				desc.regout[0] |= REGFLAG_R(insn.dst);
+
+			/* the logical operations leave AF alone */
+			if (insn.aluop == ALU_OR || insn.aluop == ALU_AND || insn.aluop == ALU_XOR || insn.aluop == ALU_TEST)
+				desc.regout[1] |= REGFLAG_ALL & ~REGFLAG_AF;
+			else
+				desc.regout[1] |= REGFLAG_ALL;
+			return true;
+
+		case INSN_MOV:
+			if (!insn.srcimm)
+				desc.regin[0] |= REGFLAG_R(insn.src);
+			desc.regout[0] |= REGFLAG_R(insn.dst);
+			return true;
+
+		case INSN_INC:
+		case INSN_DEC:
+			desc.regin[0] |= REGFLAG_R(insn.dst);
+			desc.regout[0] |= REGFLAG_R(insn.dst);
+			desc.regout[1] |= REGFLAG_ALL & ~REGFLAG_CF;
+			return true;
+
+		case INSN_NOP:
+			return true;
+
+		case INSN_JCC:
+			desc.regin[1] |= REGFLAG_ALL;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.targetpc = desc.pc + insn.length + insn.imm;
+			return true;
+
+		case INSN_JMP:
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.targetpc = desc.pc + insn.length + insn.imm;
+			return true;
+	}
+
+	return describe_interpreted(desc);
+}
+
+
+/*-------------------------------------------------
+    describe_interpreted - describe an instruction
+    that is left to the interpreter; it is treated
+    as a dynamic branch that may touch anything
+-------------------------------------------------*/
+
+bool i386_frontend::describe_interpreted(opcode_desc &desc)
+{
+	/* the real length isn't known; one byte is enough to keep the sequence builder happy */
+	/* OPFLAG_CAN_CHANGE_MODES is what tells the code generator to call the interpreter */
+	desc.length = 1;
+	desc.cycles = 0;
+	desc.targetpc = BRANCH_TARGET_DYNAMIC;
+	desc.regin[0] = desc.regout[0] = 0xff;
+	desc.regin[1] = desc.regout[1] = REGFLAG_ALL;
+	desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_CAUSE_EXCEPTION |
+			OPFLAG_CAN_CHANGE_MODES | OPFLAG_READS_MEMORY | OPFLAG_WRITES_MEMORY;
+	return true;
+}
@@ -381,6 +381,11 @@ void m6502_device::execute_run()
 	if(inst_substate)
 		do_exec_partial();
 
+	// Run through the threaded dispatch loop while the debugger is
+	// off; it leaves interrupts and reset to the loop below
+	if(!(machine().debug_flags & DEBUG_FLAG_ENABLED))
+		do_exec_threaded();
+
 	while(icount > 0) {
 		if(inst_state < 0xff00) {
 			PPC = NPC;
@@ -17,6 +17,14 @@
 #define MCFG_M6502_SYNC_CALLBACK(_cb) \
 	devcb = &m6502_device::set_sync_callback(*device, DEVCB_##_cb);
 
+// the generated threaded dispatch loop uses computed gotos where the
+// compiler has them, and a switch loop elsewhere
+#if defined(__GNUC__)
+#define M6502_THREADED_DISPATCH 1
+#else
+#define M6502_THREADED_DISPATCH 0
+#endif
+
 class m6502_device : public cpu_device {
 public:
 	enum {
@@ -188,6 +196,7 @@ protected:
 
 	virtual void do_exec_full();
 	virtual void do_exec_partial();
+	virtual void do_exec_threaded();
 
 	// inline helpers
 	static inline bool page_changing(UINT16 base, int delta) { return ((base + delta) ^ base) & 0xff00; }
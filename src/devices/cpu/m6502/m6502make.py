@@ -179,6 +179,36 @@ DO_EXEC_PARTIAL_EPILOG="""\
 }
 """
 
+DO_EXEC_THREADED_PROLOG="""\
+void %(device)s::do_exec_threaded()
+{
+#if M6502_THREADED_DISPATCH
+"""
+
+DO_EXEC_THREADED_NEXT="""\
+\tif(icount <= 0 || inst_state >= 0xff00)
+\t\treturn;
+\tPPC = NPC;
+\tinst_state = IR | inst_state_base;
+\tgoto *dispatch[inst_state];
+"""
+
+DO_EXEC_THREADED_SWITCH="""\
+#else
+\twhile(icount > 0 && inst_state < 0xff00) {
+\t\tPPC = NPC;
+\t\tinst_state = IR | inst_state_base;
+\t\tswitch(inst_state) {
+"""
+
+DO_EXEC_THREADED_EPILOG="""\
+\t\tdefault: return;
+\t\t}
+\t}
+#endif
+}
+"""
+
 DISASM_PROLOG="""\
 const %(device)s::disasm_entry %(device)s::disasm_entries[0x%(disasm_count)x] = {
 """
@@ -213,6 +243,35 @@ def save_tables(f, device, states):
             emit(f, "\tcase %s: %s_partial(); break;\n" % ("STATE_RESET", state))
     emit(f, DO_EXEC_PARTIAL_EPILOG % d)
 
+    # Threaded dispatch: every handler ends with its own copy of the
+    # dispatch code, and unused states leave for the slow path.  The
+    # handlers are the full versions, so the per-cycle checks and
+    # timing are the same as do_exec_full()
+    handlers = []
+    for state in states[:-1]:
+        if state != "." and state not in handlers:
+            handlers.append(state)
+    emit(f, DO_EXEC_THREADED_PROLOG % d)
+    emit(f, "\tstatic const void *const dispatch[0x%x] = {" % (total_states-1))
+    for n in range(0, total_states-1, 8):
+        labels = []
+        for state in states[n:n+8]:
+            labels.append("&&slow" if state == "." else "&&l_%s" % state)
+        emit(f, "\t\t%s," % ", ".join(labels))
+    emit(f, "\t};\n")
+    emit(f, DO_EXEC_THREADED_NEXT % d)
+    for state in handlers:
+        emit(f, "l_%s:" % state)
+        emit(f, "\t%s_full();" % state)
+        emit(f, DO_EXEC_THREADED_NEXT % d)
+    emit(f, "slow:")
+    emit(f, "\treturn;")
+    emit(f, DO_EXEC_THREADED_SWITCH % d)
+    for n, state in enumerate(states[:-1]):
+        if state == ".": continue
+        emit(f, "\t\tcase 0x%02x: %s_full(); break;" % (n, state))
+    emit(f, DO_EXEC_THREADED_EPILOG % d)
+
     emit(f, DISASM_PROLOG % d )
     for n, state in enumerate(states):
         if state == ".": continue
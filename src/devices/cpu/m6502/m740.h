@@ -49,6 +49,7 @@ public:
 		virtual offs_t disasm_disassemble(char *buffer, offs_t pc, const UINT8 *oprom, const UINT8 *opram, UINT32 options) override;
 		virtual void do_exec_full() override;
 		virtual void do_exec_partial() override;
+		virtual void do_exec_threaded() override;
 		virtual void execute_set_input(int inputnum, int state) override;
 
 protected:
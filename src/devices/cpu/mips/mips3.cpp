@@ -157,12 +157,14 @@ mips3_device::mips3_device(const machine_config &mconfig, device_type type, cons
 	, m_cache(CACHE_SIZE + sizeof(internal_mips3_state))
 	, m_drcuml(nullptr)
 	, m_drcfe(nullptr)
+	, m_drcfe_hot(nullptr)
 	, m_drcoptions(0)
 	, m_cache_dirty(0)
 	, m_entry(nullptr)
 	, m_nocode(nullptr)
 	, m_out_of_cycles(nullptr)
 	, m_tlb_mismatch(nullptr)
+	, m_recompile(nullptr)
 	, m_hotspot_select(0)
 {
 	memset(m_fpmode, 0, sizeof(m_fpmode));
@@ -202,6 +204,10 @@ void mips3_device::device_stop()
 	{
 		m_drcfe = nullptr;
 	}
+	if (m_drcfe_hot != nullptr)
+	{
+		m_drcfe_hot = nullptr;
+	}
 	if (m_drcuml != nullptr)
 	{
 		m_drcuml = nullptr;
@@ -381,8 +387,9 @@ void mips3_device::device_start()
 	m_drcuml->symbol_add(&m_core->numcycles, sizeof(m_core->numcycles), "numcycles");
 	m_drcuml->symbol_add(&m_fpmode, sizeof(m_fpmode), "fpmode");
 
-	/* initialize the front-end helper */
-	m_drcfe = std::make_unique<mips3_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	/* initialize the front-end helpers, one per tier */
+	m_drcfe = std::make_unique<mips3_frontend>(this, COMPILE_COLD_BACKWARDS_BYTES, COMPILE_COLD_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_COLD_MAX_SEQUENCE);
+	m_drcfe_hot = std::make_unique<mips3_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
@@ -2703,9 +2710,9 @@ void mips3_device::execute_run()
 			execute_result = m_drcuml->execute(*m_entry);
 
 			/* if we need to recompile, do it */
-			if (execute_result == EXECUTE_MISSING_CODE)
+			if (execute_result == EXECUTE_MISSING_CODE || execute_result == EXECUTE_RECOMPILE_HOT)
 			{
-				code_compile_block(m_core->mode, m_core->pc);
+				code_compile_block(m_core->mode, m_core->pc, execute_result == EXECUTE_RECOMPILE_HOT || (m_drcoptions & MIPS3DRC_SINGLE_TIER));
 			}
 			else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			{
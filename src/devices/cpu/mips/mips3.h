@@ -408,7 +408,8 @@ private:
 	/* core state */
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                     /* DRC UML generator state */
-	std::unique_ptr<mips3_frontend>    m_drcfe;                      /* pointer to the DRC front-end state */
+	std::unique_ptr<mips3_frontend>    m_drcfe;                      /* pointer to the DRC front-end state for cold blocks */
+	std::unique_ptr<mips3_frontend>    m_drcfe_hot;                  /* pointer to the DRC front-end state for hot blocks */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* internal stuff */
@@ -426,6 +427,7 @@ private:
 	uml::code_handle *   m_nocode;                     /* nocode exception handler */
 	uml::code_handle *   m_out_of_cycles;              /* out of cycles exception handler */
 	uml::code_handle *   m_tlb_mismatch;               /* tlb mismatch handler */
+	uml::code_handle *   m_recompile;                  /* hot block recompile request */
 	uml::code_handle *   m_read8[3];                   /* read byte */
 	uml::code_handle *   m_write8[3];                  /* write byte */
 	uml::code_handle *   m_read16[3];                  /* read half */
@@ -528,7 +530,7 @@ private:
 	void load_fast_iregs(drcuml_block *block);
 	void save_fast_iregs(drcuml_block *block);
 	void code_flush_cache();
-	void code_compile_block(UINT8 mode, offs_t pc);
+	void code_compile_block(UINT8 mode, offs_t pc, bool hot);
 public:
 	void func_get_cycles();
 	void func_printf_exception();
@@ -540,6 +542,7 @@ private:
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
 	void static_generate_tlb_mismatch();
+	void static_generate_recompile_handler();
 	void static_generate_exception(UINT8 exception, int recover, const char *name);
 	void static_generate_memory_accessor(int mode, int size, int iswrite, int ismasked, const char *name, uml::code_handle **handleptr);
 
@@ -755,6 +758,7 @@ private:
 #define MIPS3DRC_FLUSH_PC           0x0010          /* flush the PC value before each memory access */
 #define MIPS3DRC_CHECK_OVERFLOWS    0x0020          /* actually check overflows on add/sub instructions */
 #define MIPS3DRC_ACCURATE_DIVZERO   0x0040          /* load correct values into HI/LO on integer divide-by-zero */
+#define MIPS3DRC_SINGLE_TIER        0x0080          /* compile everything with the full look-ahead straight away */
 
 #define MIPS3DRC_COMPATIBLE_OPTIONS (MIPS3DRC_STRICT_VERIFY | MIPS3DRC_STRICT_COP1 | MIPS3DRC_STRICT_COP0 | MIPS3DRC_STRICT_COP2 | MIPS3DRC_FLUSH_PC)
 #define MIPS3DRC_FASTEST_OPTIONS    (0)
@@ -51,11 +51,20 @@
 #define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/4) + (COMPILE_FORWARDS_BYTES/4))
 #define COMPILE_MAX_SEQUENCE            64
 
+/* the same for blocks that have not proven to be hot yet */
+#define COMPILE_COLD_BACKWARDS_BYTES    0
+#define COMPILE_COLD_FORWARDS_BYTES     64
+#define COMPILE_COLD_MAX_SEQUENCE       16
+
+/* number of entries into a cold block before it is recompiled */
+#define COMPILE_HOT_THRESHOLD           32
+
 /* exit codes */
 #define EXECUTE_OUT_OF_CYCLES           0
 #define EXECUTE_MISSING_CODE            1
 #define EXECUTE_UNMAPPED_CODE           2
 #define EXECUTE_RESET_CACHE             3
+#define EXECUTE_RECOMPILE_HOT           4
 
 
 
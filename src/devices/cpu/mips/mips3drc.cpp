@@ -231,6 +231,7 @@ void mips3_device::code_flush_cache()
 		static_generate_nocode_handler();
 		static_generate_out_of_cycles();
 		static_generate_tlb_mismatch();
+		static_generate_recompile_handler();
 
 		/* append exception handlers for various types */
 		static_generate_exception(EXCEPTION_INTERRUPT,     TRUE,  "exception_interrupt");
@@ -275,10 +276,11 @@ void mips3_device::code_flush_cache()
 
 /*-------------------------------------------------
     code_compile_block - compile a block of the
-    given mode at the specified pc
+    given mode at the specified pc, at the cold
+    or the hot tier
 -------------------------------------------------*/
 
-void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
+void mips3_device::code_compile_block(UINT8 mode, offs_t pc, bool hot)
 {
 	drcuml_state *drcuml = m_drcuml.get();
 	compiler_state compiler = { 0 };
@@ -290,7 +292,7 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
 	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	desclist = hot ? m_drcfe_hot->describe_code(pc) : m_drcfe->describe_code(pc);
 	if (drcuml->logging() || drcuml->logging_native())
 		log_opcode_desc(drcuml, desclist, 0);
 
@@ -348,6 +350,17 @@ void mips3_device::code_compile_block(UINT8 mode, offs_t pc)
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
 
+				/* count entries into a cold block and ask for the hot version once it has earned it */
+				if (!hot && seqhead == desclist)
+				{
+					UINT32 *counter = (UINT32 *)m_cache.alloc_temporary(sizeof(UINT32));
+					if (counter == nullptr)
+						block->abort();
+					*counter = COMPILE_HOT_THRESHOLD;
+					UML_SUB(block, mem(counter), mem(counter), 1);                          // sub     [counter],[counter],1
+					UML_EXHc(block, COND_Z, *m_recompile, seqhead->pc);                     // exh     recompile,seqhead->pc,z
+				}
+
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 					generate_sequence_instruction(block, &compiler, curdesc);
@@ -694,6 +707,31 @@ void mips3_device::static_generate_tlb_mismatch()
 }
 
 
+/*-------------------------------------------------
+    static_generate_recompile_handler - generate
+    a handler that leaves compiled code so that
+    a hot block can be recompiled
+-------------------------------------------------*/
+
+void mips3_device::static_generate_recompile_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	alloc_handle(drcuml, &m_recompile, "recompile");
+	UML_HANDLE(block, *m_recompile);                                            // handle  recompile
+	UML_GETEXP(block, I0);                                                      // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                        // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_RECOMPILE_HOT);                                     // exit    EXECUTE_RECOMPILE_HOT
+
+	block->end();
+}
+
+
 /*-------------------------------------------------
     static_generate_exception - generate a static
     exception handler
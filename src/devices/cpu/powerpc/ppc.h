@@ -18,6 +18,7 @@
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
+#include "cpu/drcbeut.h"
 
 
 /***************************************************************************
@@ -25,7 +26,6 @@
 ***************************************************************************/
 
 /* general constants */
-#define PPC_MAX_FASTRAM         4
 #define PPC_MAX_HOTSPOTS        16
 
 
@@ -152,6 +152,7 @@ enum
 #define PPCDRC_STRICT_VERIFY        0x0001          /* verify all instructions */
 #define PPCDRC_FLUSH_PC             0x0002          /* flush the PC value before each memory access */
 #define PPCDRC_ACCURATE_SINGLES     0x0004          /* do excessive rounding to make single-precision results "accurate" */
+#define PPCDRC_SINGLE_TIER          0x0008          /* compile everything with the full look-ahead straight away */
 
 
 /* common sets of options */
@@ -535,7 +536,8 @@ protected:
 	/* core state */
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                     /* DRC UML generator state */
-	std::unique_ptr<ppc_frontend>      m_drcfe;                      /* pointer to the DRC front-end state */
+	std::unique_ptr<ppc_frontend>      m_drcfe;                      /* pointer to the DRC front-end state for cold blocks */
+	std::unique_ptr<ppc_frontend>      m_drcfe_hot;                  /* pointer to the DRC front-end state for hot blocks */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* parameters for subroutines */
@@ -560,6 +562,7 @@ protected:
 	uml::code_handle *   m_nocode;                     /* nocode exception handler */
 	uml::code_handle *   m_out_of_cycles;              /* out of cycles exception handler */
 	uml::code_handle *   m_tlb_mismatch;               /* tlb mismatch handler */
+	uml::code_handle *   m_recompile;                  /* hot block recompile request */
 	uml::code_handle *   m_swap_tgpr;                  /* swap TGPR handler */
 	uml::code_handle *   m_lsw[8][32];                 /* lsw entries */
 	uml::code_handle *   m_stsw[8][32];                /* stsw entries */
@@ -583,17 +586,7 @@ protected:
 	uml::code_handle *   m_exception_norecover[EXCEPTION_COUNT];   /* array of exception handlers */
 
 	/* fast RAM */
-	/* fast RAM info */
-	struct fast_ram_info
-	{
-		offs_t              start;                      /* start of the RAM block */
-		offs_t              end;                        /* end of the RAM block */
-		UINT8               readonly;                   /* TRUE if read-only */
-		void *              base;                       /* base in memory where the RAM lives */
-	};
-
-	UINT32              m_fastram_select;
-	fast_ram_info       m_fastram[PPC_MAX_FASTRAM];
+	drc_fastram_table   m_fastram;
 
 	/* hotspots */
 	/* hotspot info */
@@ -643,11 +636,12 @@ protected:
 	UINT32 compute_crf_mask(UINT8 crm);
 	UINT32 compute_spr(UINT32 spr);
 	void code_flush_cache();
-	void code_compile_block(UINT8 mode, offs_t pc);
+	void code_compile_block(UINT8 mode, offs_t pc, bool hot);
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
 	void static_generate_tlb_mismatch();
+	void static_generate_recompile_handler();
 	void static_generate_exception(UINT8 exception, int recover, const char *name);
 	void static_generate_memory_accessor(int mode, int size, int iswrite, int ismasked, const char *name, uml::code_handle *&handleptr, uml::code_handle *masked);
 	void static_generate_swap_tgpr();
@@ -220,6 +220,7 @@ ppc_device::ppc_device(const machine_config &mconfig, device_type type, const ch
 	, m_cache(CACHE_SIZE + sizeof(internal_ppc_state))
 	, m_drcuml(nullptr)
 	, m_drcfe(nullptr)
+	, m_drcfe_hot(nullptr)
 	, m_drcoptions(0)
 {
 	m_program_config.m_logaddr_width = 32;
@@ -566,6 +567,7 @@ void ppc_device::device_start()
 	m_nocode = nullptr;
 	m_out_of_cycles = nullptr;
 	m_tlb_mismatch = nullptr;
+	m_recompile = nullptr;
 	m_swap_tgpr = nullptr;
 	memset(m_lsw, 0, sizeof(m_lsw));
 	memset(m_stsw, 0, sizeof(m_stsw));
@@ -693,8 +695,7 @@ void ppc_device::device_start()
 	m_dec_zero_cycles = 0;
 
 	m_arg1 = 0;
-	m_fastram_select = 0;
-	memset(m_fastram, 0, sizeof(m_fastram));
+	m_fastram.clear();
 	m_hotspot_select = 0;
 	memset(m_hotspot, 0, sizeof(m_hotspot));
 
@@ -929,8 +930,9 @@ void ppc_device::device_start()
 	m_drcuml->symbol_add(&m_cmpl_cr_table, sizeof(m_cmpl_cr_table), "cmpl_cr_table");
 	m_drcuml->symbol_add(&m_fcmp_cr_table, sizeof(m_fcmp_cr_table), "fcmp_cr_table");
 
-	/* initialize the front-end helper */
-	m_drcfe = std::make_unique<ppc_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	/* initialize the front-end helpers, one per tier */
+	m_drcfe = std::make_unique<ppc_frontend>(this, COMPILE_COLD_BACKWARDS_BYTES, COMPILE_COLD_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_COLD_MAX_SEQUENCE);
+	m_drcfe_hot = std::make_unique<ppc_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
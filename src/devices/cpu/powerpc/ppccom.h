@@ -43,6 +43,14 @@
 #define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/4) + (COMPILE_FORWARDS_BYTES/4))
 #define COMPILE_MAX_SEQUENCE            64
 
+/* the same for blocks that have not proven to be hot yet */
+#define COMPILE_COLD_BACKWARDS_BYTES    0
+#define COMPILE_COLD_FORWARDS_BYTES     64
+#define COMPILE_COLD_MAX_SEQUENCE       16
+
+/* number of entries into a cold block before it is recompiled */
+#define COMPILE_HOT_THRESHOLD           32
+
 
 /* core parameters */
 #define POWERPC_MIN_PAGE_SHIFT      12
@@ -49,6 +49,7 @@ extern offs_t ppc_dasm_one(char *buffer, UINT32 pc, UINT32 op);
 #define EXECUTE_MISSING_CODE            1
 #define EXECUTE_UNMAPPED_CODE           2
 #define EXECUTE_RESET_CACHE             3
+#define EXECUTE_RECOMPILE_HOT           4
 
 
 
@@ -220,8 +221,8 @@ void ppc_device::execute_run()
 		execute_result = m_drcuml->execute(*m_entry);
 
 		/* if we need to recompile, do it */
-		if (execute_result == EXECUTE_MISSING_CODE)
-			code_compile_block(m_core->mode, m_core->pc);
+		if (execute_result == EXECUTE_MISSING_CODE || execute_result == EXECUTE_RECOMPILE_HOT)
+			code_compile_block(m_core->mode, m_core->pc, execute_result == EXECUTE_RECOMPILE_HOT || (m_drcoptions & PPCDRC_SINGLE_TIER));
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
 		else if (execute_result == EXECUTE_RESET_CACHE)
@@ -248,14 +249,9 @@ void ppc_device::ppcdrc_set_options(UINT32 options)
 
 void ppc_device::ppcdrc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
 {
-	if (m_fastram_select < ARRAY_LENGTH(m_fastram))
-	{
-		m_fastram[m_fastram_select].start = start;
-		m_fastram[m_fastram_select].end = end;
-		m_fastram[m_fastram_select].readonly = readonly;
-		m_fastram[m_fastram_select].base = base;
-		m_fastram_select++;
-	}
+	/* the base pointers are baked into the memory accessors */
+	if (m_fastram.add(start, end, readonly, base))
+		m_cache_dirty = TRUE;
 }
 
 
@@ -297,6 +293,7 @@ void ppc_device::code_flush_cache()
 		static_generate_nocode_handler();
 		static_generate_out_of_cycles();
 		static_generate_tlb_mismatch();
+		static_generate_recompile_handler();
 		if (m_cap & PPCCAP_603_MMU)
 			static_generate_swap_tgpr();
 
@@ -353,10 +350,11 @@ void ppc_device::code_flush_cache()
 
 /*-------------------------------------------------
     code_compile_block - compile a block of the
-    given mode at the specified pc
+    given mode at the specified pc, at the cold
+    or the hot tier
 -------------------------------------------------*/
 
-void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
+void ppc_device::code_compile_block(UINT8 mode, offs_t pc, bool hot)
 {
 	compiler_state compiler = { 0 };
 	const opcode_desc *seqhead, *seqlast;
@@ -367,7 +365,7 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
 	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	desclist = hot ? m_drcfe_hot->describe_code(pc) : m_drcfe->describe_code(pc);
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(m_drcuml.get(), desclist, 0);
 
@@ -424,6 +422,17 @@ void ppc_device::code_compile_block(UINT8 mode, offs_t pc)
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                                     // label   seqhead->pc | 0x80000000
 
+				/* count entries into a cold block and ask for the hot version once it has earned it */
+				if (!hot && seqhead == desclist)
+				{
+					UINT32 *counter = (UINT32 *)m_cache.alloc_temporary(sizeof(UINT32));
+					if (counter == nullptr)
+						block->abort();
+					*counter = COMPILE_HOT_THRESHOLD;
+					UML_SUB(block, mem(counter), mem(counter), 1);                                  // sub     [counter],[counter],1
+					UML_EXHc(block, COND_Z, *m_recompile, seqhead->pc);                             // exh     recompile,seqhead->pc,z
+				}
+
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 					generate_sequence_instruction(block, &compiler, curdesc);                  // <instruction>
@@ -720,6 +729,30 @@ void ppc_device::static_generate_out_of_cycles()
 }
 
 
+/*-------------------------------------------------
+    static_generate_recompile_handler - generate
+    a handler that leaves compiled code so that
+    a hot block can be recompiled
+-------------------------------------------------*/
+
+void ppc_device::static_generate_recompile_handler()
+{
+	drcuml_block *block;
+
+	/* begin generating */
+	block = m_drcuml->begin_block(10);
+
+	alloc_handle(m_drcuml.get(), &m_recompile, "recompile");
+	UML_HANDLE(block, *m_recompile);                                                    // handle  recompile
+	UML_GETEXP(block, I0);                                                              // getexp  i0
+	UML_MOV(block, mem(&m_core->pc), I0);                                                  // mov     [pc],i0
+	save_fast_iregs(block);                                                            // <save fastregs>
+	UML_EXIT(block, EXECUTE_RECOMPILE_HOT);                                             // exit    EXECUTE_RECOMPILE_HOT
+
+	block->end();
+}
+
+
 /*-------------------------------------------------
     static_generate_tlb_mismatch - generate a
     TLB mismatch handler
@@ -969,8 +1002,7 @@ void ppc_device::static_generate_memory_accessor(int mode, int size, int iswrite
 	int unaligned = 0;
 	int alignex = 0;
 	int tlbmiss = 0;
-	int label = 1;
-	int ramnum;
+	code_label label = 1;
 
 	if (mode & MODE_USER)
 		translate_type = iswrite ? TRANSLATE_WRITE_USER : TRANSLATE_READ_USER;
@@ -1032,88 +1064,7 @@ void ppc_device::static_generate_memory_accessor(int mode, int size, int iswrite
 	UML_XOR(block, I0, I0, (mode & MODE_LITTLE_ENDIAN) ? (8 - size) : 0);   // xor     i0,i0,8-size
 
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
-		for (ramnum = 0; ramnum < PPC_MAX_FASTRAM; ramnum++)
-			if (m_fastram[ramnum].base != nullptr && (!iswrite || !m_fastram[ramnum].readonly))
-			{
-				void *fastbase = (UINT8 *)m_fastram[ramnum].base - m_fastram[ramnum].start;
-				UINT32 skip = label++;
-
-				if (m_fastram[ramnum].end != 0xffffffff)
-				{
-					UML_CMP(block, I0, m_fastram[ramnum].end);         // cmp     i0,end
-					UML_JMPc(block, COND_A, skip);                                              // ja      skip
-				}
-				if (m_fastram[ramnum].start != 0x00000000)
-				{
-					UML_CMP(block, I0, m_fastram[ramnum].start);           // cmp     i0,fastram_start
-					UML_JMPc(block, COND_B, skip);                                              // jb      skip
-				}
-
-				if (!iswrite)
-				{
-					if (size == 1)
-					{
-						UML_XOR(block, I0, I0, fastxor & 7);                        // xor     i0,i0,fastxor & 7
-						UML_LOAD(block, I0, fastbase, I0, SIZE_BYTE, SCALE_x1);     // load    i0,fastbase,i0,byte
-					}
-					else if (size == 2)
-					{
-						UML_XOR(block, I0, I0, fastxor & 6);                        // xor     i0,i0,fastxor & 6
-						UML_LOAD(block, I0, fastbase, I0, SIZE_WORD, SCALE_x1);     // load    i0,fastbase,i0,word_x1
-					}
-					else if (size == 4)
-					{
-						UML_XOR(block, I0, I0, fastxor & 4);                        // xor     i0,i0,fastxor & 4
-						UML_LOAD(block, I0, fastbase, I0, SIZE_DWORD, SCALE_x1);        // load    i0,fastbase,i0,dword_x1
-					}
-					else if (size == 8)
-					{
-						UML_DLOAD(block, I0, fastbase, I0, SIZE_QWORD, SCALE_x1);       // dload   i0,fastbase,i0,qword
-					}
-					UML_RET(block);                                                             // ret
-				}
-				else
-				{
-					if (size == 1)
-					{
-						UML_XOR(block, I0, I0, fastxor & 7);                        // xor     i0,i0,fastxor & 7
-						UML_STORE(block, fastbase, I0, I1, SIZE_BYTE, SCALE_x1);        // store   fastbase,i0,i1,byte
-					}
-					else if (size == 2)
-					{
-						UML_XOR(block, I0, I0, fastxor & 6);                        // xor     i0,i0,fastxor & 6
-						UML_STORE(block, fastbase, I0, I1, SIZE_WORD, SCALE_x1);        // store   fastbase,i0,i1,word_x1
-					}
-					else if (size == 4)
-					{
-						UML_XOR(block, I0, I0, fastxor & 4);                        // xor     i0,i0,fastxor & 4
-						if (ismasked)
-						{
-							UML_LOAD(block, I3, fastbase, I0, SIZE_DWORD, SCALE_x1);    // load    i3,fastbase,i0,dword_x1
-							UML_AND(block, I1, I1, I2);                         // and     i1,i1,i2
-							UML_XOR(block, I2, I2, 0xffffffff);                 // xor     i2,i2,0xfffffffff
-							UML_AND(block, I3, I3, I2);                         // and     i3,i3,i2
-							UML_OR(block, I1, I1, I3);                          // or      i1,i1,i3
-						}
-						UML_STORE(block, fastbase, I0, I1, SIZE_DWORD, SCALE_x1);       // store   fastbase,i0,i1,dword_x1
-					}
-					else if (size == 8)
-					{
-						if (ismasked)
-						{
-							UML_DLOAD(block, I3, fastbase, I0, SIZE_QWORD, SCALE_x1);   // dload   i3,fastbase,i0,qword_x1
-							UML_DAND(block, I1, I1, I2);                            // dand    i1,i1,i2
-							UML_DXOR(block, I2, I2, U64(0xffffffffffffffff));   // dxor    i2,i2,0xfffffffffffffffff
-							UML_DAND(block, I3, I3, I2);                            // dand    i3,i3,i2
-							UML_DOR(block, I1, I1, I3);                         // dor     i1,i1,i3
-						}
-						UML_DSTORE(block, fastbase, I0, I1, SIZE_QWORD, SCALE_x1);  // dstore  fastbase,i0,i1,qword_x1
-					}
-					UML_RET(block);                                                             // ret
-				}
-
-				UML_LABEL(block, skip);                                                     // skip:
-			}
+		m_fastram.generate_access(*block, label, size, iswrite, fastxor & (8 - size), ismasked);
 
 	switch (size)
 	{
@@ -94,6 +94,11 @@ extern offs_t rsp_dasm_one(char *buffer, offs_t pc, UINT32 op);
 #define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/4) + (COMPILE_FORWARDS_BYTES/4))
 #define COMPILE_MAX_SEQUENCE            64
 
+/* the same for blocks that have not proven to be hot yet */
+#define COMPILE_COLD_BACKWARDS_BYTES    0
+#define COMPILE_COLD_FORWARDS_BYTES     64
+#define COMPILE_COLD_MAX_SEQUENCE       16
+
 /* size of the execution code cache */
 #define CACHE_SIZE                      (32 * 1024 * 1024)
 
@@ -105,6 +110,7 @@ rsp_device::rsp_device(const machine_config &mconfig, const char *tag, device_t
 	, m_drcuml(nullptr)
 //  , m_drcuml(*this, m_cache, 0, 8, 32, 2)
 	, m_drcfe(nullptr)
+	, m_drcfe_hot(nullptr)
 	, m_drcoptions(0)
 	, m_cache_dirty(TRUE)
 	, m_numcycles(0)
@@ -114,6 +120,7 @@ rsp_device::rsp_device(const machine_config &mconfig, const char *tag, device_t
 	, m_entry(nullptr)
 	, m_nocode(nullptr)
 	, m_out_of_cycles(nullptr)
+	, m_recompile(nullptr)
 	, m_read8(nullptr)
 	, m_write8(nullptr)
 	, m_read16(nullptr)
@@ -159,6 +166,10 @@ void rsp_device::rsp_add_dmem(UINT32 *base)
 	m_dmem32 = base;
 	m_dmem16 = (UINT16*)base;
 	m_dmem8 = (UINT8*)base;
+
+	/* the memory accessors go straight to DMEM, so regenerate them */
+	if (m_fastram.add(0x000, 0xfff, FALSE, base))
+		m_cache_dirty = TRUE;
 }
 
 UINT8 rsp_device::DM_READ8(UINT32 address)
@@ -410,8 +421,9 @@ void rsp_device::device_start()
 	m_drcuml->symbol_add(&m_arg3, sizeof(m_arg3), "arg3");
 	m_drcuml->symbol_add(&m_numcycles, sizeof(m_numcycles), "numcycles");
 
-	/* initialize the front-end helper */
-	m_drcfe = std::make_unique<rsp_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	/* initialize the front-end helpers, one per tier */
+	m_drcfe = std::make_unique<rsp_frontend>(*this, COMPILE_COLD_BACKWARDS_BYTES, COMPILE_COLD_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_COLD_MAX_SEQUENCE);
+	m_drcfe_hot = std::make_unique<rsp_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
@@ -17,6 +17,7 @@
 #include "emu.h"
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
+#include "cpu/drcbeut.h"
 
 /***************************************************************************
     REGISTER ENUMERATION
@@ -109,6 +110,7 @@ enum
 #define RSP_STATUS_SIGNAL7       0x4000
 
 #define RSPDRC_STRICT_VERIFY    0x0001          /* verify all instructions */
+#define RSPDRC_SINGLE_TIER      0x0002          /* compile everything with the full look-ahead straight away */
 
 #define MCFG_RSP_DP_REG_R_CB(_devcb) \
 	devcb = &rsp_device::static_set_dp_reg_r_callback(*device, DEVCB_##_devcb);
@@ -205,19 +207,11 @@ protected:
 private:
 	address_space_config m_program_config;
 
-	/* fast RAM info */
-	struct fast_ram_info
-	{
-		offs_t              start;                      /* start of the RAM block */
-		offs_t              end;                        /* end of the RAM block */
-		UINT8               readonly;                   /* TRUE if read-only */
-		void *              base;                       /* base in memory where the RAM lives */
-	};
-
 	/* core state */
 	drc_cache           m_cache;                      /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                     /* DRC UML generator state */
-	std::unique_ptr<rsp_frontend>      m_drcfe;                      /* pointer to the DRC front-end state */
+	std::unique_ptr<rsp_frontend>      m_drcfe;                      /* pointer to the DRC front-end state for cold blocks */
+	std::unique_ptr<rsp_frontend>      m_drcfe_hot;                  /* pointer to the DRC front-end state for hot blocks */
 	UINT32              m_drcoptions;                 /* configurable DRC options */
 
 	/* internal stuff */
@@ -236,6 +230,7 @@ private:
 	uml::code_handle *   m_entry;                      /* entry point */
 	uml::code_handle *   m_nocode;                     /* nocode exception handler */
 	uml::code_handle *   m_out_of_cycles;              /* out of cycles exception handler */
+	uml::code_handle *   m_recompile;                  /* hot block recompile request */
 	uml::code_handle *   m_read8;                      /* read byte */
 	uml::code_handle *   m_write8;                     /* write byte */
 	uml::code_handle *   m_read16;                     /* read half */
@@ -243,6 +238,9 @@ private:
 	uml::code_handle *   m_read32;                     /* read word */
 	uml::code_handle *   m_write32;                    /* write word */
 
+	/* fast RAM */
+	drc_fastram_table   m_fastram;                    /* DMEM, for direct access from the accessors */
+
 	struct internal_rsp_state
 	{
 		UINT32 pc;
@@ -306,10 +304,11 @@ private:
 	void rspcom_init();
 	void execute_run_drc();
 	void code_flush_cache();
-	void code_compile_block(offs_t pc);
+	void code_compile_block(offs_t pc, bool hot);
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
+	void static_generate_recompile_handler();
 	void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle *&handleptr);
 	void generate_update_cycles(drcuml_block *block, compiler_state *compiler, uml::parameter param, int allow_exception);
 	void generate_checksum_block(drcuml_block *block, compiler_state *compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
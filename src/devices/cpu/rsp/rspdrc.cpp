@@ -46,6 +46,10 @@ extern offs_t rsp_dasm_one(char *buffer, offs_t pc, UINT32 op);
 #define EXECUTE_MISSING_CODE            1
 #define EXECUTE_UNMAPPED_CODE           2
 #define EXECUTE_RESET_CACHE             3
+#define EXECUTE_RECOMPILE_HOT           4
+
+/* number of entries into a cold block before it is recompiled */
+#define COMPILE_HOT_THRESHOLD           32
 
 
 
@@ -281,9 +285,9 @@ void rsp_device::execute_run_drc()
 		execute_result = drcuml->execute(*m_entry);
 
 		/* if we need to recompile, do it */
-		if (execute_result == EXECUTE_MISSING_CODE)
+		if (execute_result == EXECUTE_MISSING_CODE || execute_result == EXECUTE_RECOMPILE_HOT)
 		{
-			code_compile_block(m_rsp_state->pc);
+			code_compile_block(m_rsp_state->pc, execute_result == EXECUTE_RECOMPILE_HOT || (m_drcoptions & RSPDRC_SINGLE_TIER));
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 		{
@@ -327,6 +331,7 @@ void rsp_device::code_flush_cache()
 		static_generate_entry_point();
 		static_generate_nocode_handler();
 		static_generate_out_of_cycles();
+		static_generate_recompile_handler();
 
 		/* add subroutines for memory accesses */
 		static_generate_memory_accessor(1, FALSE, "read8",       m_read8);
@@ -345,10 +350,11 @@ void rsp_device::code_flush_cache()
 
 /*-------------------------------------------------
     code_compile_block - compile a block of the
-    given mode at the specified pc
+    given mode at the specified pc, at the cold
+    or the hot tier
 -------------------------------------------------*/
 
-void rsp_device::code_compile_block(offs_t pc)
+void rsp_device::code_compile_block(offs_t pc, bool hot)
 {
 	drcuml_state *drcuml = m_drcuml.get();
 	compiler_state compiler = { 0 };
@@ -360,7 +366,7 @@ void rsp_device::code_compile_block(offs_t pc)
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
 	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	desclist = hot ? m_drcfe_hot->describe_code(pc) : m_drcfe->describe_code(pc);
 
 	bool succeeded = false;
 	while (!succeeded)
@@ -415,6 +421,17 @@ void rsp_device::code_compile_block(offs_t pc)
 				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
 
+				/* count entries into a cold block and ask for the hot version once it has earned it */
+				if (!hot && seqhead == desclist)
+				{
+					UINT32 *counter = (UINT32 *)m_cache.alloc_temporary(sizeof(UINT32));
+					if (counter == nullptr)
+						block->abort();
+					*counter = COMPILE_HOT_THRESHOLD;
+					UML_SUB(block, mem(counter), mem(counter), 1);                          // sub     [counter],[counter],1
+					UML_EXHc(block, COND_Z, *m_recompile, seqhead->pc);                     // exh     recompile,seqhead->pc,z
+				}
+
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 					generate_sequence_instruction(block, &compiler, curdesc);
@@ -560,6 +577,30 @@ void rsp_device::static_generate_out_of_cycles()
 	block->end();
 }
 
+/*-------------------------------------------------
+    static_generate_recompile_handler - generate
+    a handler that leaves compiled code so that
+    a hot block can be recompiled
+-------------------------------------------------*/
+
+void rsp_device::static_generate_recompile_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	alloc_handle(drcuml, &m_recompile, "recompile");
+	UML_HANDLE(block, *m_recompile);                                   // handle  recompile
+	UML_GETEXP(block, I0);                                                      // getexp  i0
+	UML_MOV(block, mem(&m_rsp_state->pc), I0);                                          // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_RECOMPILE_HOT);                                 // exit    EXECUTE_RECOMPILE_HOT
+
+	block->end();
+}
+
 /*------------------------------------------------------------------
     static_generate_memory_accessor
 ------------------------------------------------------------------*/
@@ -571,6 +612,8 @@ void rsp_device::static_generate_memory_accessor(int size, int iswrite, const ch
 	/* routine trashes I0-I1 */
 	drcuml_state *drcuml = m_drcuml.get();
 	drcuml_block *block;
+	code_label label = 1;
+	code_label unaligned = 0;
 
 	/* begin generating */
 	block = drcuml->begin_block(1024);
@@ -579,6 +622,20 @@ void rsp_device::static_generate_memory_accessor(int size, int iswrite, const ch
 	alloc_handle(drcuml, &handleptr, name);
 	UML_HANDLE(block, *handleptr);                                                  // handle  *handleptr
 
+	/* DMEM mirrors every 4k; aligned accesses can go to it directly */
+	if (m_fastram.count() != 0)
+	{
+		UML_AND(block, I0, I0, 0xfff);                                              // and     i0,i0,0xfff
+		if (size != 1)
+		{
+			UML_TEST(block, I0, size - 1);                                          // test    i0,size-1
+			UML_JMPc(block, COND_NZ, unaligned = label++);                          // jmp     unaligned,nz
+		}
+		m_fastram.generate_access(*block, label, size, iswrite, (size == 1) ? BYTE4_XOR_BE(0) : (size == 2) ? WORD_XOR_BE(0) : 0);
+		if (size != 1)
+			UML_LABEL(block, unaligned);                                            // unaligned:
+	}
+
 	// write:
 	if (iswrite)
 	{
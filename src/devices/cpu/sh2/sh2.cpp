@@ -121,6 +121,11 @@
 #define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/2) + (COMPILE_FORWARDS_BYTES/2))
 #define COMPILE_MAX_SEQUENCE            64
 
+/* the same for blocks that have not proven to be hot yet */
+#define COMPILE_COLD_BACKWARDS_BYTES    0
+#define COMPILE_COLD_FORWARDS_BYTES     64
+#define COMPILE_COLD_MAX_SEQUENCE       16
+
 
 const device_type SH1 = &device_creator<sh1_device>;
 const device_type SH2 = &device_creator<sh2_device>;
@@ -179,6 +184,7 @@ sh2_device::sh2_device(const machine_config &mconfig, const char *tag, device_t
 	, m_drcuml(nullptr)
 //  , m_drcuml(*this, m_cache, 0, 1, 32, 1)
 	, m_drcfe(nullptr)
+	, m_drcfe_hot(nullptr)
 	, m_drcoptions(0)
 	, m_sh2_state(nullptr)
 	, m_entry(nullptr)
@@ -191,6 +197,7 @@ sh2_device::sh2_device(const machine_config &mconfig, const char *tag, device_t
 	, m_interrupt(nullptr)
 	, m_nocode(nullptr)
 	, m_out_of_cycles(nullptr)
+	, m_recompile(nullptr)
 	, m_debugger_temp(0)
 {
 	m_isdrc = (mconfig.options().drc() && !mconfig.m_force_no_drc) ? true : false;
@@ -212,6 +219,7 @@ sh2_device::sh2_device(const machine_config &mconfig, device_type type, const ch
 	, m_drcuml(nullptr)
 //  , m_drcuml(*this, m_cache, 0, 1, 32, 1)
 	, m_drcfe(nullptr)
+	, m_drcfe_hot(nullptr)
 	, m_drcoptions(0)
 	, m_sh2_state(nullptr)
 	, m_entry(nullptr)
@@ -224,6 +232,7 @@ sh2_device::sh2_device(const machine_config &mconfig, device_type type, const ch
 	, m_interrupt(nullptr)
 	, m_nocode(nullptr)
 	, m_out_of_cycles(nullptr)
+	, m_recompile(nullptr)
 {
 	m_isdrc = (mconfig.options().drc() && !mconfig.m_force_no_drc) ? true : false;
 }
@@ -2523,8 +2532,7 @@ void sh2_device::device_start()
 	m_sh2_state->arg0 = 0;
 	m_arg1 = 0;
 	m_irq = 0;
-	m_fastram_select = 0;
-	memset(m_fastram, 0, sizeof(m_fastram));
+	m_fastram.clear();
 
 	/* reset per-driver pcflushes */
 	m_pcfsel = 0;
@@ -2549,8 +2557,9 @@ void sh2_device::device_start()
 	m_drcuml->symbol_add(&m_sh2_state->macl, sizeof(m_sh2_state->macl), "macl");
 	m_drcuml->symbol_add(&m_sh2_state->mach, sizeof(m_sh2_state->macl), "mach");
 
-	/* initialize the front-end helper */
-	m_drcfe = std::make_unique<sh2_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	/* initialize the front-end helpers, one per tier */
+	m_drcfe = std::make_unique<sh2_frontend>(this, COMPILE_COLD_BACKWARDS_BYTES, COMPILE_COLD_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_COLD_MAX_SEQUENCE);
+	m_drcfe_hot = std::make_unique<sh2_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
 
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 16; regnum++)
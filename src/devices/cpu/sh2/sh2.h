@@ -19,6 +19,7 @@
 
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
+#include "cpu/drcbeut.h"
 
 
 #define SH2_INT_NONE    -1
@@ -78,12 +79,11 @@ typedef device_delegate<void (UINT32 data)> sh2_ftcsr_read_delegate;
 #define SH2DRC_STRICT_VERIFY        0x0001          /* verify all instructions */
 #define SH2DRC_FLUSH_PC         0x0002          /* flush the PC value before each memory access */
 #define SH2DRC_STRICT_PCREL     0x0004          /* do actual loads on MOVLI/MOVWI instead of collapsing to immediates */
+#define SH2DRC_SINGLE_TIER      0x0008          /* compile everything with the full look-ahead straight away */
 
 #define SH2DRC_COMPATIBLE_OPTIONS   (SH2DRC_STRICT_VERIFY | SH2DRC_FLUSH_PC | SH2DRC_STRICT_PCREL)
 #define SH2DRC_FASTEST_OPTIONS  (0)
 
-#define SH2_MAX_FASTRAM       4
-
 class sh2_frontend;
 
 class sh2_device : public cpu_device
@@ -220,7 +220,8 @@ private:
 
 	drc_cache           m_cache;                  /* pointer to the DRC code cache */
 	std::unique_ptr<drcuml_state>      m_drcuml;                 /* DRC UML generator state */
-	std::unique_ptr<sh2_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
+	std::unique_ptr<sh2_frontend>      m_drcfe;                  /* pointer to the DRC front-end state for cold blocks */
+	std::unique_ptr<sh2_frontend>      m_drcfe_hot;              /* pointer to the DRC front-end state for hot blocks */
 	UINT32              m_drcoptions;         /* configurable DRC options */
 
 	internal_sh2_state *m_sh2_state;
@@ -247,16 +248,10 @@ private:
 	uml::code_handle *  m_interrupt;              /* interrupt */
 	uml::code_handle *  m_nocode;                 /* nocode */
 	uml::code_handle *  m_out_of_cycles;              /* out of cycles exception handler */
+	uml::code_handle *  m_recompile;              /* hot block recompile request */
 
 	/* fast RAM */
-	UINT32              m_fastram_select;
-	struct
-	{
-		offs_t              start;                      /* start of the RAM block */
-		offs_t              end;                        /* end of the RAM block */
-		UINT8               readonly;                   /* TRUE if read-only */
-		void *              base;                       /* base in memory where the RAM lives */
-	} m_fastram[SH2_MAX_FASTRAM];
+	drc_fastram_table   m_fastram;
 
 	UINT32 m_debugger_temp;
 
@@ -449,10 +444,11 @@ private:
 
 	void code_flush_cache();
 	void execute_run_drc();
-	void code_compile_block(UINT8 mode, offs_t pc);
+	void code_compile_block(UINT8 mode, offs_t pc, bool hot);
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
+	void static_generate_recompile_handler();
 	void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle **handleptr);
 	const char *log_desc_flags_to_string(UINT32 flags);
 	void log_register_list(drcuml_state *drcuml, const char *string, const UINT32 *reglist, const UINT32 *regnostarlist);
@@ -44,6 +44,10 @@ using namespace uml;
 #define EXECUTE_MISSING_CODE            1
 #define EXECUTE_UNMAPPED_CODE           2
 #define EXECUTE_RESET_CACHE         3
+#define EXECUTE_RECOMPILE_HOT       4
+
+/* number of entries into a cold block before it is recompiled */
+#define COMPILE_HOT_THRESHOLD       32
 
 #define PROBE_ADDRESS                   ~0
 
@@ -596,6 +600,7 @@ void sh2_device::code_flush_cache()
 		/* generate the entry point and out-of-cycles handlers */
 		static_generate_nocode_handler();
 		static_generate_out_of_cycles();
+		static_generate_recompile_handler();
 		static_generate_entry_point();
 
 		/* add subroutines for memory accesses */
@@ -643,9 +648,9 @@ void sh2_device::execute_run_drc()
 		execute_result = drcuml->execute(*m_entry);
 
 		/* if we need to recompile, do it */
-		if (execute_result == EXECUTE_MISSING_CODE)
+		if (execute_result == EXECUTE_MISSING_CODE || execute_result == EXECUTE_RECOMPILE_HOT)
 		{
-			code_compile_block(0, m_sh2_state->pc);
+			code_compile_block(0, m_sh2_state->pc, execute_result == EXECUTE_RECOMPILE_HOT || (m_drcoptions & SH2DRC_SINGLE_TIER));
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 		{
@@ -660,10 +665,11 @@ void sh2_device::execute_run_drc()
 
 /*-------------------------------------------------
     code_compile_block - compile a block of the
-    given mode at the specified pc
+    given mode at the specified pc, at the cold
+    or the hot tier
 -------------------------------------------------*/
 
-void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
+void sh2_device::code_compile_block(UINT8 mode, offs_t pc, bool hot)
 {
 	drcuml_state *drcuml = m_drcuml.get();
 	compiler_state compiler = { 0 };
@@ -675,7 +681,7 @@ void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
 	/* get a description of this sequence */
-	desclist = m_drcfe->describe_code(pc);
+	desclist = hot ? m_drcfe_hot->describe_code(pc) : m_drcfe->describe_code(pc);
 	if (drcuml->logging() || drcuml->logging_native())
 		log_opcode_desc(drcuml, desclist, 0);
 
@@ -734,6 +740,17 @@ void sh2_device::code_compile_block(UINT8 mode, offs_t pc)
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
 				}
 
+				/* count entries into a cold block and ask for the hot version once it has earned it */
+				if (!hot && seqhead == desclist)
+				{
+					UINT32 *counter = (UINT32 *)m_cache.alloc_temporary(sizeof(UINT32));
+					if (counter == nullptr)
+						block->abort();
+					*counter = COMPILE_HOT_THRESHOLD;
+					UML_SUB(block, mem(counter), mem(counter), 1);                          // sub     [counter],[counter],1
+					UML_EXHc(block, COND_Z, *m_recompile, seqhead->pc);                     // exh     recompile,seqhead->pc,z
+				}
+
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 				{
@@ -903,6 +920,30 @@ void sh2_device::static_generate_out_of_cycles()
 	block->end();
 }
 
+/*-------------------------------------------------
+    static_generate_recompile_handler - generate
+    a handler that leaves compiled code so that
+    a hot block can be recompiled
+-------------------------------------------------*/
+
+void sh2_device::static_generate_recompile_handler()
+{
+	drcuml_state *drcuml = m_drcuml.get();
+	drcuml_block *block;
+
+	/* begin generating */
+	block = drcuml->begin_block(10);
+
+	alloc_handle(drcuml, &m_recompile, "recompile");
+	UML_HANDLE(block, *m_recompile);                                 // handle  recompile
+	UML_GETEXP(block, I0);                                  // getexp  i0
+	UML_MOV(block, mem(&m_sh2_state->pc), I0);                              // mov     [pc],i0
+	save_fast_iregs(block);
+	UML_EXIT(block, EXECUTE_RECOMPILE_HOT);                         // exit    EXECUTE_RECOMPILE_HOT
+
+	block->end();
+}
+
 /*------------------------------------------------------------------
     static_generate_memory_accessor
 ------------------------------------------------------------------*/
@@ -914,7 +955,7 @@ void sh2_device::static_generate_memory_accessor(int size, int iswrite, const ch
 	/* routine trashes I0 */
 	drcuml_state *drcuml = m_drcuml.get();
 	drcuml_block *block;
-	int label = 1;
+	code_label label = 1;
 
 	/* begin generating */
 	block = drcuml->begin_block(1024);
@@ -935,63 +976,7 @@ void sh2_device::static_generate_memory_accessor(int size, int iswrite, const ch
 
 	UML_LABEL(block, label++);              // label:
 
-	for (auto & elem : m_fastram)
-	{
-		if (elem.base != nullptr && (!iswrite || !elem.readonly))
-		{
-			void *fastbase = (UINT8 *)elem.base - elem.start;
-			UINT32 skip = label++;
-			if (elem.end != 0xffffffff)
-			{
-				UML_CMP(block, I0, elem.end);   // cmp     i0,end
-				UML_JMPc(block, COND_A, skip);                                      // ja      skip
-			}
-			if (elem.start != 0x00000000)
-			{
-				UML_CMP(block, I0, elem.start);// cmp     i0,fastram_start
-				UML_JMPc(block, COND_B, skip);                                      // jb      skip
-			}
-
-			if (!iswrite)
-			{
-				if (size == 1)
-				{
-					UML_XOR(block, I0, I0, BYTE4_XOR_BE(0));
-					UML_LOAD(block, I0, fastbase, I0, SIZE_BYTE, SCALE_x1);             // load    i0,fastbase,i0,byte
-				}
-				else if (size == 2)
-				{
-					UML_XOR(block, I0, I0, WORD_XOR_BE(0));
-					UML_LOAD(block, I0, fastbase, I0, SIZE_WORD, SCALE_x1);         // load    i0,fastbase,i0,word_x1
-				}
-				else if (size == 4)
-				{
-					UML_LOAD(block, I0, fastbase, I0, SIZE_DWORD, SCALE_x1);            // load    i0,fastbase,i0,dword_x1
-				}
-				UML_RET(block);                                                     // ret
-			}
-			else
-			{
-				if (size == 1)
-				{
-					UML_XOR(block, I0, I0, BYTE4_XOR_BE(0));
-					UML_STORE(block, fastbase, I0, I1, SIZE_BYTE, SCALE_x1);// store   fastbase,i0,i1,byte
-				}
-				else if (size == 2)
-				{
-					UML_XOR(block, I0, I0, WORD_XOR_BE(0));
-					UML_STORE(block, fastbase, I0, I1, SIZE_WORD, SCALE_x1);// store   fastbase,i0,i1,word_x1
-				}
-				else if (size == 4)
-				{
-					UML_STORE(block, fastbase, I0, I1, SIZE_DWORD, SCALE_x1);       // store   fastbase,i0,i1,dword_x1
-				}
-				UML_RET(block);                                                     // ret
-			}
-
-			UML_LABEL(block, skip);                                             // skip:
-		}
-	}
+	m_fastram.generate_access(*block, label, size, iswrite, (size == 1) ? BYTE4_XOR_BE(0) : (size == 2) ? WORD_XOR_BE(0) : 0);
 
 	if (iswrite)
 	{
@@ -2972,12 +2957,7 @@ void sh2_device::sh2drc_add_pcflush(offs_t address)
 
 void sh2_device::sh2drc_add_fastram(offs_t start, offs_t end, UINT8 readonly, void *base)
 {
-	if (m_fastram_select < ARRAY_LENGTH(m_fastram))
-	{
-		m_fastram[m_fastram_select].start = start;
-		m_fastram[m_fastram_select].end = end;
-		m_fastram[m_fastram_select].readonly = readonly;
-		m_fastram[m_fastram_select].base = base;
-		m_fastram_select++;
-	}
+	// the base pointers are baked into the memory accessors
+	if (m_fastram.add(start, end, readonly, base))
+		m_cache_dirty = TRUE;
 }
@@ -557,10 +557,18 @@ ATTR_HOT void netlist_mame_cpu_device_t::execute_run()
 
 netlist_mame_sound_device_t::netlist_mame_sound_device_t(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
 	: netlist_mame_device_t(mconfig, NETLIST_CPU, "Netlist Sound Device", tag, owner, clock, "netlist_sound", __FILE__),
-		device_sound_interface(mconfig, *this)
+		device_sound_interface(mconfig, *this),
+		m_run_ahead(0)
 {
 }
 
+void netlist_mame_sound_device_t::static_set_run_ahead(device_t &device, int samples)
+{
+	netlist_mame_sound_device_t &netlist = downcast<netlist_mame_sound_device_t &>(device);
+	LOG_DEV_CALLS(("set_run_ahead %d\n", samples));
+	netlist.m_run_ahead = samples;
+}
+
 void netlist_mame_sound_device_t::device_start()
 {
 	netlist_mame_device_t::device_start();
@@ -587,7 +595,6 @@ void netlist_mame_sound_device_t::device_start()
 			fatalerror("illegal channel number");
 		m_out[chan] = outdevs[i];
 		m_out[chan]->m_sample = netlist::netlist_time::from_hz(clock());
-		m_out[chan]->m_buffer = nullptr;
 	}
 
 	// Configure inputs
@@ -605,6 +612,12 @@ void netlist_mame_sound_device_t::device_start()
 		m_in->m_inc = netlist::netlist_time::from_hz(clock());
 	}
 
+	/* stream inputs are only valid for the current update */
+	if (m_num_inputs > 0)
+		m_run_ahead = 0;
+	if (m_run_ahead < 0 || m_run_ahead > nld_sound_out::BUFSIZE)
+		fatalerror("illegal run ahead %d\n", m_run_ahead);
+
 	/* initialize the stream(s) */
 	m_stream = machine().sound().stream_alloc(*this, m_num_inputs, m_num_outputs, clock());
 
@@ -619,11 +632,6 @@ void netlist_mame_sound_device_t::nl_register_devices()
 
 void netlist_mame_sound_device_t::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
 {
-	for (int i=0; i < m_num_outputs; i++)
-	{
-		m_out[i]->m_buffer = outputs[i];
-	}
-
 	if (m_num_inputs)
 		m_in->buffer_reset();
 
@@ -632,16 +640,38 @@ void netlist_mame_sound_device_t::sound_stream_update(sound_stream &stream, stre
 		m_in->m_buffer[i] = inputs[i];
 	}
 
-	netlist::netlist_time cur = netlist().time();
+	while (samples > 0)
+	{
+		/* all outputs are filled up to the same time */
+		int avail = m_out[0]->available();
 
-	netlist().process_queue(m_div * samples);
+		if (avail < samples)
+		{
+			/* run the netlist for what is missing or for the configured run ahead */
+			const int run = std::min(std::max(samples - avail, m_run_ahead), nld_sound_out::BUFSIZE - avail);
+			netlist::netlist_time cur = netlist().time();
 
-	cur += (m_div * samples);
+			netlist().process_queue(m_div * run);
 
-	for (int i=0; i < m_num_outputs; i++)
+			cur += (m_div * run);
+
+			for (int i=0; i < m_num_outputs; i++)
+				m_out[i]->sound_update(cur);
+			avail = m_out[0]->available();
+		}
+
+		const int count = std::min(samples, avail);
+		for (int i=0; i < m_num_outputs; i++)
+		{
+			m_out[i]->buffer_read(outputs[i], count);
+			outputs[i] += count;
+		}
+		samples -= count;
+	}
+
+	for (int i=0; i < m_num_inputs; i++)
 	{
-		m_out[i]->sound_update(cur);
-		m_out[i]->buffer_reset(cur);
+		m_in->m_buffer[i] = nullptr;
 	}
 }
 
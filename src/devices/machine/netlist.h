@@ -23,6 +23,9 @@
 #define MCFG_NETLIST_SETUP(_setup)                                                  \
 	netlist_mame_device_t::static_set_constructor(*device, NETLIST_NAME(_setup));
 
+#define MCFG_NETLIST_RUN_AHEAD(_samples)                                            \
+	netlist_mame_sound_device_t::static_set_run_ahead(*device, _samples);
+
 #define MCFG_NETLIST_ANALOG_INPUT(_basetag, _tag, _name)                            \
 	MCFG_DEVICE_ADD(_basetag ":" _tag, NETLIST_ANALOG_INPUT, 0)                     \
 	netlist_mame_analog_input_t::static_set_name(*device, _name);
@@ -253,6 +256,8 @@ public:
 	netlist_mame_sound_device_t(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
 	virtual ~netlist_mame_sound_device_t() {}
 
+	static void static_set_run_ahead(device_t &device, int samples);
+
 	inline sound_stream *get_stream() { return m_stream; }
 
 
@@ -278,6 +283,7 @@ private:
 
 	static const int MAX_OUT = 10;
 	nld_sound_out *m_out[MAX_OUT];
+	int m_run_ahead;
 	nld_sound_in *m_in;
 	sound_stream *m_stream;
 	int m_num_inputs;
@@ -547,6 +553,10 @@ private:
 
 // ----------------------------------------------------------------------------------------
 // sound_out
+//
+// Samples are collected in a ring buffer at the stream rate while the
+// netlist runs. Sound updates copy them to the stream in bulk, so the
+// netlist may run ahead of the stream by up to BUFSIZE samples.
 // ----------------------------------------------------------------------------------------
 
 class NETLIB_NAME(sound_out) : public netlist::device_t
@@ -555,7 +565,7 @@ public:
 	NETLIB_NAME(sound_out)()
 		: netlist::device_t() { }
 
-	static const int BUFSIZE = 2048;
+	static const int BUFSIZE = 2048; /* must be a power of two */
 
 	ATTR_COLD void start() override
 	{
@@ -565,24 +575,29 @@ public:
 		register_param("OFFSET", m_offset, 0.0);
 		m_sample = netlist::netlist_time::from_hz(1); //sufficiently big enough
 		save(NAME(m_last_buffer));
+		save(NAME(m_buffer));
+		save(NAME(m_rd));
+		save(NAME(m_avail));
+		save(NAME(m_cur));
 	}
 
 	ATTR_COLD void reset() override
 	{
 		m_cur = 0.0;
-		m_last_pos = 0;
+		m_rd = 0;
+		m_avail = 0;
 		m_last_buffer = netlist::netlist_time::zero;
 	}
 
+	/* fill the ring with the current level up to upto */
 	ATTR_HOT void sound_update(const netlist::netlist_time upto)
 	{
 		int pos = (upto - m_last_buffer) / m_sample;
-		if (pos >= BUFSIZE)
+		if (pos > BUFSIZE)
 			netlist().log().fatal("sound {1}: exceeded BUFSIZE\n", name().cstr());
-		while (m_last_pos < pos )
-		{
-			m_buffer[m_last_pos++] = (stream_sample_t) m_cur;
-		}
+		const stream_sample_t v = (stream_sample_t) m_cur;
+		while (m_avail < pos)
+			m_buffer[(m_rd + m_avail++) & (BUFSIZE - 1)] = v;
 	}
 
 	ATTR_HOT void update() override
@@ -599,23 +614,31 @@ public:
 
 	}
 
-	ATTR_HOT void buffer_reset(netlist::netlist_time upto)
+	/* number of finished samples not yet passed to the stream */
+	int available() const { return m_avail; }
+
+	/* move count finished samples to the stream buffer */
+	ATTR_HOT void buffer_read(stream_sample_t *dest, const int count)
 	{
-		m_last_pos = 0;
-		m_last_buffer = upto;
-		m_cur = 0.0;
+		const int first = std::min(count, BUFSIZE - m_rd);
+		std::copy(m_buffer + m_rd, m_buffer + m_rd + first, dest);
+		std::copy(m_buffer, m_buffer + count - first, dest + first);
+		m_rd = (m_rd + count) & (BUFSIZE - 1);
+		m_avail -= count;
+		m_last_buffer += m_sample * count;
 	}
 
 	netlist::param_int_t m_channel;
 	netlist::param_double_t m_mult;
 	netlist::param_double_t m_offset;
-	stream_sample_t *m_buffer;
 	netlist::netlist_time m_sample;
 
 private:
 	netlist::analog_input_t m_in;
 	double m_cur;
-	int m_last_pos;
+	stream_sample_t m_buffer[BUFSIZE];
+	int m_rd;
+	int m_avail;
 	netlist::netlist_time m_last_buffer;
 };
 
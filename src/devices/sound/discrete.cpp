@@ -112,7 +112,8 @@ public:
 	inline bool lock_threadid(INT32 threadid)
 	{
 		int expected = -1;
-		return m_threadid.compare_exchange_weak(expected, threadid, std::memory_order_release,std::memory_order_relaxed);
+		/* a spurious failure would lose a wakeup, so no weak exchange here */
+		return m_threadid.compare_exchange_strong(expected, threadid);
 	}
 	inline void unlock(void) { m_threadid = -1; }
 
@@ -122,6 +123,9 @@ public:
 	/* list of source nodes */
 	vector_t<input_buffer> source_list;      /* discrete_source_node */
 
+	/* tasks reading our buffered outputs */
+	vector_t<discrete_task *> consumer_list;
+
 	int                     task_group;
 
 
@@ -134,8 +138,8 @@ public:
 	}
 
 protected:
-	static void *task_callback(void *param, int threadid);
-	inline bool process(void);
+	inline bool ready(void) const;
+	inline void process(void);
 
 	void check(discrete_task *dest_task);
 	void prepare_for_queue(int samples);
@@ -144,11 +148,105 @@ protected:
 	discrete_device &                   m_device;
 
 private:
+	friend class discrete_scheduler;
+
 	std::atomic<INT32>      m_threadid;
 	volatile int            m_samples;
 
 };
 
+/*************************************
+ *
+ *  Task scheduler
+ *
+ *  Every work item queued by process() runs one worker.
+ *  A task is ready once all its sources have buffered the
+ *  next slice of samples. Workers push the tasks they make
+ *  ready onto their own deque, so a consumer usually follows
+ *  its producer on the same core slice by slice. A worker
+ *  with an empty deque steals the oldest task of another one.
+ *
+ *  A task stays locked while it is queued or running, and
+ *  remains locked once it has processed all its samples.
+ *
+ *************************************/
+
+class discrete_task_deque
+{
+public:
+	discrete_task_deque() : m_tasks(nullptr), m_size(0), m_head(0), m_count(0) { }
+
+	void init(running_machine &machine, int size)
+	{
+		m_tasks = auto_alloc_array_clear(machine, discrete_task *, size);
+		m_size = size;
+	}
+
+	void clear(void) { m_head = 0; m_count = 0; }
+
+	void push(discrete_task *task)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_tasks[(m_head + m_count) % m_size] = task;
+		m_count++;
+	}
+
+	/* the owner takes the newest task ... */
+	discrete_task *pop(void)
+	{
+		if (m_count == 0)
+			return nullptr;
+		std::lock_guard<std::mutex> guard(m_lock);
+		if (m_count == 0)
+			return nullptr;
+		m_count--;
+		return m_tasks[(m_head + m_count) % m_size];
+	}
+
+	/* ... thieves the oldest one */
+	discrete_task *steal(void)
+	{
+		if (m_count == 0)
+			return nullptr;
+		std::lock_guard<std::mutex> guard(m_lock);
+		if (m_count == 0)
+			return nullptr;
+		discrete_task *task = m_tasks[m_head];
+		m_head = (m_head + 1) % m_size;
+		m_count--;
+		return task;
+	}
+
+private:
+	std::mutex              m_lock;
+	discrete_task **        m_tasks;
+	int                     m_size;
+	int                     m_head;
+	std::atomic<int>        m_count;
+};
+
+class discrete_scheduler
+{
+public:
+	discrete_scheduler(running_machine &machine, task_list_t &tasks);
+
+	int workers(void) const { return m_workers; }
+
+	void prepare(int samples);
+	static void *worker_callback(void *param, int threadid);
+
+private:
+	void worker(int slot);
+	void make_ready(discrete_task *task, int slot);
+	discrete_task *next_task(int slot);
+
+	task_list_t &           m_tasks;
+	discrete_task_deque *   m_deques;
+	int                     m_workers;
+	std::atomic<int>        m_next_worker;
+	std::atomic<int>        m_done;
+};
+
 
 /*************************************
  *
@@ -212,29 +310,12 @@ inline void discrete_task::step_nodes(void)
 		*(outbuf->ptr++) = *outbuf->source;
 }
 
-void *discrete_task::task_callback(void *param, int threadid)
+inline bool discrete_task::ready(void) const
 {
-	task_list_t *list = (task_list_t *) param;
-	do
-	{
-		for_each(discrete_task **, task, list)
-		{
-			/* try to lock */
-			if ((*task)->lock_threadid(threadid))
-			{
-				if (!(*task)->process())
-					return nullptr;
-				(*task)->unlock();
-			}
-		}
-	} while (1);
-
-	return nullptr;
-}
+	if (m_samples == 0)
+		return false;
 
-bool discrete_task::process(void)
-{
-	int samples = MIN(m_samples, MAX_SAMPLES_PER_TASK_SLICE);
+	const int samples = MIN(m_samples, MAX_SAMPLES_PER_TASK_SLICE);
 
 	/* check dependencies */
 	for_each(input_buffer *, sn, &source_list)
@@ -244,8 +325,14 @@ bool discrete_task::process(void)
 		avail = sn->linked_outbuf->ptr - sn->ptr;
 		assert_always(avail >= 0, "task_callback: available samples are negative");
 		if (avail < samples)
-			samples = avail;
+			return false;
 	}
+	return true;
+}
+
+inline void discrete_task::process(void)
+{
+	int samples = MIN(m_samples, MAX_SAMPLES_PER_TASK_SLICE);
 
 	m_samples -= samples;
 	assert_always(m_samples >=0, "task_callback: task_samples got negative");
@@ -255,17 +342,15 @@ bool discrete_task::process(void)
 		step_nodes();
 		samples--;
 	}
-	if (m_samples == 0)
-	{
-		/* return and keep the task locked so it is not picked up by other worker threads */
-		return false;
-	}
-	return true;
+
+	/* publish the slice before consumers are checked */
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 }
 
 void discrete_task::prepare_for_queue(int samples)
 {
 	m_samples = samples;
+	m_threadid = -1;
 	/* set up task buffers */
 	for_each(output_buffer *, ob, &m_buffers)
 		ob->ptr = ob->node_buf;
@@ -329,6 +414,13 @@ void discrete_task::check(discrete_task *dest_task)
 						}
 						m_device.discrete_log("dso_task_start - buffering %d(%d) in task %p group %d referenced by %d group %d", NODE_INDEX(inputnode_num), NODE_CHILD_NODE_NUM(inputnode_num), this, task_group, dest_node->index(), dest_task->task_group);
 
+						bool known = false;
+						for_each(discrete_task **, consumer, &consumer_list)
+							if (*consumer == dest_task)
+								known = true;
+						if (!known)
+							consumer_list.add(dest_task);
+
 						/* register into source list */
 						//source = auto_alloc(device->machine(), discrete_source_node);
 						//source.task = this;
@@ -348,6 +440,90 @@ void discrete_task::check(discrete_task *dest_task)
 	}
 }
 
+/*************************************
+ *
+ *  Scheduler implementation
+ *
+ *************************************/
+
+discrete_scheduler::discrete_scheduler(running_machine &machine, task_list_t &tasks)
+	: m_tasks(tasks), m_deques(nullptr), m_workers(tasks.count()), m_next_worker(0), m_done(0)
+{
+	m_deques = auto_alloc_array(machine, discrete_task_deque, m_workers);
+	for (int i = 0; i < m_workers; i++)
+		m_deques[i].init(machine, m_tasks.count());
+}
+
+void discrete_scheduler::prepare(int samples)
+{
+	for_each(discrete_task **, task, &m_tasks)
+		(*task)->prepare_for_queue(samples);
+
+	for (int i = 0; i < m_workers; i++)
+		m_deques[i].clear();
+	m_next_worker = 0;
+	m_done = 0;
+
+	/* hand out the tasks without sources */
+	int slot = 0;
+	for_each(discrete_task **, task, &m_tasks)
+		if ((*task)->ready() && (*task)->lock_threadid(slot))
+		{
+			m_deques[slot].push(*task);
+			slot = (slot + 1) % m_workers;
+		}
+}
+
+void *discrete_scheduler::worker_callback(void *param, int threadid)
+{
+	discrete_scheduler *sched = (discrete_scheduler *) param;
+	sched->worker(sched->m_next_worker++);
+	return nullptr;
+}
+
+void discrete_scheduler::make_ready(discrete_task *task, int slot)
+{
+	if (task->ready() && task->lock_threadid(slot))
+		m_deques[slot].push(task);
+}
+
+discrete_task *discrete_scheduler::next_task(int slot)
+{
+	discrete_task *task = m_deques[slot].pop();
+	for (int i = 1; task == nullptr && i < m_workers; i++)
+		task = m_deques[(slot + i) % m_workers].steal();
+	return task;
+}
+
+void discrete_scheduler::worker(int slot)
+{
+	const int count = m_tasks.count();
+
+	while (m_done < count)
+	{
+		discrete_task *task = next_task(slot);
+		if (task == nullptr)
+			continue;
+
+		while (task->ready())
+		{
+			task->process();
+			for_each(discrete_task **, consumer, &task->consumer_list)
+				make_ready(*consumer, slot);
+		}
+
+		if (task->m_samples == 0)
+			m_done++;
+		else
+		{
+			/* a producer may have published while we held the lock */
+			task->unlock();
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			make_ready(task, slot);
+		}
+	}
+}
+
 /*************************************
  *
  *  Base node implementation
@@ -843,6 +1019,7 @@ discrete_device::discrete_device(const machine_config &mconfig, device_type type
 		m_indexed_node(nullptr),
 		m_disclogfile(nullptr),
 		m_queue(nullptr),
+		m_scheduler(nullptr),
 		m_profiling(0),
 		m_total_samples(0),
 		m_total_stream_updates(0)
@@ -933,6 +1110,8 @@ void discrete_device::device_start()
 				(*dest_task)->check((*task));
 		}
 	}
+
+	m_scheduler = auto_alloc(machine(), discrete_scheduler(machine(), task_list));
 }
 
 void discrete_device::device_stop()
@@ -1044,19 +1223,11 @@ void discrete_device::process(int samples)
 		return;
 
 	/* Setup tasks */
-	for_each(discrete_task **, task, &task_list)
-	{
-		/* unlock the thread */
-		(*task)->unlock();
+	m_scheduler->prepare(samples);
 
-		(*task)->prepare_for_queue(samples);
-	}
-
-	for_each(discrete_task **, task, &task_list)
-	{
-		/* Fire a work item for each task */
-		osd_work_item_queue(m_queue, discrete_task::task_callback, (void *) &task_list, WORK_ITEM_FLAG_AUTO_RELEASE);
-	}
+	/* Fire a work item for each worker */
+	for (int i = 0; i < m_scheduler->workers(); i++)
+		osd_work_item_queue(m_queue, discrete_scheduler::worker_callback, (void *) m_scheduler, WORK_ITEM_FLAG_AUTO_RELEASE);
 	osd_work_queue_wait(m_queue, osd_ticks_per_second()*10);
 
 	if (m_profiling)
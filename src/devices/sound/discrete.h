@@ -4184,6 +4184,7 @@ enum discrete_node_type
 struct discrete_block;
 class discrete_node_base_factory;
 class discrete_task;
+class discrete_scheduler;
 class discrete_base_node;
 class discrete_dss_input_stream_node;
 class discrete_device;
@@ -4359,6 +4360,7 @@ private:
 
 	/* parallel tasks */
 	osd_work_queue *        m_queue;
+	discrete_scheduler *    m_scheduler;
 
 	/* profiling */
 	int                     m_profiling;
@@ -686,6 +686,10 @@ struct FM_OPN
 #define LOG(d,n,x) do { if( (n)>=LOG_LEVEL ) d->logerror x; } while (0)
 #endif
 
+/* debug: set to 1 to still compute the channels the silence mask skips
+   and stop when one of them would have produced output */
+#define CHECK_SILENT_SKIP 0
+
 /* limitter */
 #define Limit(val, max,min) { \
 	if ( val > max )      val = max; \
@@ -1419,6 +1423,41 @@ static inline void chan_calc(FM_OPN *OPN, FM_CH *CH, int chnum)
 	}
 }
 
+/* mask of channels that can produce output
+** A channel with all slots in EG_OFF state and no feedback or MEM samples
+** left stays silent until it is keyed on, and key on restarts its phase
+** counters. Key on only happens between updates: register writes and the
+** timer A (CSM) handler bring the stream up to date first. The internal
+** timers key on CSM from inside the update, so they get no mask.
+*/
+static inline UINT32 OPN_active_channels(const FM_CH *CH, int chans)
+{
+	UINT32 mask = 0;
+	if (FM_INTERNAL_TIMER)
+		return ~0;
+	for (int c = 0; c < chans; c++, CH++)
+	{
+		if (CH->SLOT[SLOT1].state != EG_OFF || CH->SLOT[SLOT2].state != EG_OFF ||
+			CH->SLOT[SLOT3].state != EG_OFF || CH->SLOT[SLOT4].state != EG_OFF ||
+			CH->op1_out[0] != 0 || CH->op1_out[1] != 0 || CH->mem_value != 0)
+			mask |= 1 << c;
+	}
+	return mask;
+}
+
+/* calculate a channel unless the mask says it is silent */
+static inline void chan_calc_active(FM_OPN *OPN, FM_CH *CH, int chnum, UINT32 active)
+{
+	if (active & (1 << chnum))
+		chan_calc(OPN, CH, chnum);
+	else if (CHECK_SILENT_SKIP)
+	{
+		chan_calc(OPN, CH, chnum);
+		if (OPN->out_fm[chnum] != 0 || CH->op1_out[1] != 0 || CH->mem_value != 0)
+			fatalerror("OPN: skipped channel %d is not silent\n", chnum);
+	}
+}
+
 /* update phase increment and envelope generator */
 static inline void refresh_fc_eg_slot(FM_OPN *OPN, FM_SLOT *SLOT , int fc , int kc )
 {
@@ -2108,6 +2147,7 @@ void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length)
 	cch[1]   = &F2203->CH[1];
 	cch[2]   = &F2203->CH[2];
 
+	UINT32 active = OPN_active_channels(F2203->CH, 3);
 
 	/* refresh PG and EG */
 	refresh_fc_eg_chan( OPN, cch[0] );
@@ -2151,10 +2191,10 @@ void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length)
 			advance_eg_channel(OPN, &cch[2]->SLOT[SLOT1]);
 		}
 
-		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
+		/* calculate FM, silent channels add nothing */
+		chan_calc_active(OPN, cch[0], 0, active);
+		chan_calc_active(OPN, cch[1], 1, active);
+		chan_calc_active(OPN, cch[2], 2, active);
 
 		/* buffering */
 		{
@@ -2742,6 +2782,8 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 	cch[4]   = &F2608->CH[4];
 	cch[5]   = &F2608->CH[5];
 
+	UINT32 active = OPN_active_channels(F2608->CH, 6);
+
 	/* refresh PG and EG */
 	refresh_fc_eg_chan( OPN, cch[0] );
 	refresh_fc_eg_chan( OPN, cch[1] );
@@ -2779,13 +2821,13 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 		out_fm[4] = 0;
 		out_fm[5] = 0;
 
-		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
-		chan_calc(OPN, cch[3], 3 );
-		chan_calc(OPN, cch[4], 4 );
-		chan_calc(OPN, cch[5], 5 );
+		/* calculate FM, silent channels add nothing */
+		chan_calc_active(OPN, cch[0], 0, active);
+		chan_calc_active(OPN, cch[1], 1, active);
+		chan_calc_active(OPN, cch[2], 2, active);
+		chan_calc_active(OPN, cch[3], 3, active);
+		chan_calc_active(OPN, cch[4], 4, active);
+		chan_calc_active(OPN, cch[5], 5, active);
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -3281,6 +3323,8 @@ void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length)
 	cch[2] = &F2610->CH[4];
 	cch[3] = &F2610->CH[5];
 
+	UINT32 active = OPN_active_channels(F2610->CH, 6);
+
 #ifdef YM2610B_WARNING
 #define FM_KEY_IS(SLOT) ((SLOT)->key)
 #define FM_MSG_YM2610B "YM2610-%p.CH%d is playing,Check whether the type of the chip is YM2610B\n"
@@ -3336,11 +3380,11 @@ void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length)
 			advance_eg_channel(OPN, &cch[3]->SLOT[SLOT1]);
 		}
 
-		/* calculate FM */
-		chan_calc(OPN, cch[0], 1 ); /*remapped to 1*/
-		chan_calc(OPN, cch[1], 2 ); /*remapped to 2*/
-		chan_calc(OPN, cch[2], 4 ); /*remapped to 4*/
-		chan_calc(OPN, cch[3], 5 ); /*remapped to 5*/
+		/* calculate FM, silent channels add nothing */
+		chan_calc_active(OPN, cch[0], 1, active); /*remapped to 1*/
+		chan_calc_active(OPN, cch[1], 2, active); /*remapped to 2*/
+		chan_calc_active(OPN, cch[2], 4, active); /*remapped to 4*/
+		chan_calc_active(OPN, cch[3], 5, active); /*remapped to 5*/
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
@@ -3419,6 +3463,8 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 	cch[4] = &F2610->CH[4];
 	cch[5] = &F2610->CH[5];
 
+	UINT32 active = OPN_active_channels(F2610->CH, 6);
+
 	/* refresh PG and EG */
 	refresh_fc_eg_chan( OPN, cch[0] );
 	refresh_fc_eg_chan( OPN, cch[1] );
@@ -3470,13 +3516,13 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 			advance_eg_channel(OPN, &cch[5]->SLOT[SLOT1]);
 		}
 
-		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
-		chan_calc(OPN, cch[3], 3 );
-		chan_calc(OPN, cch[4], 4 );
-		chan_calc(OPN, cch[5], 5 );
+		/* calculate FM, silent channels add nothing */
+		chan_calc_active(OPN, cch[0], 0, active);
+		chan_calc_active(OPN, cch[1], 1, active);
+		chan_calc_active(OPN, cch[2], 2, active);
+		chan_calc_active(OPN, cch[3], 3, active);
+		chan_calc_active(OPN, cch[4], 4, active);
+		chan_calc_active(OPN, cch[5], 5, active);
 
 		/* deltaT ADPCM */
 		if( DELTAT->portstate&0x80 )
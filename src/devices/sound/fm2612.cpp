@@ -706,6 +706,10 @@ struct YM2612
 #define LOG(d,n,x) do { if( (n)>=LOG_LEVEL ) d->logerror x; } while (0)
 #endif
 
+/* debug: set to 1 to still compute the channels the silence mask skips
+   and stop when one of them would have produced output */
+#define CHECK_SILENT_SKIP 0
+
 /* limitter */
 #define Limit(val, max,min) { \
 	if ( val > max )      val = max; \
@@ -1669,6 +1673,42 @@ static inline void chan_calc(YM2612 *F2612, fm2612_FM_OPN *OPN, fm2612_FM_CH *CH
 	}
 }
 
+/* mask of channels that can produce output
+** A channel with all slots in EG_OFF state and no feedback or MEM samples
+** left stays silent until it is keyed on, and key on restarts its phase
+** counters. Key on only happens between updates: register writes and the
+** timer A (CSM) handler bring the stream up to date first. The internal
+** timers key on CSM from inside the update, so they get no mask.
+*/
+static inline UINT32 OPN_active_channels(const fm2612_FM_CH *CH, int chans)
+{
+	UINT32 mask = 0;
+	if (FM_INTERNAL_TIMER)
+		return ~0;
+	for (int c = 0; c < chans; c++, CH++)
+	{
+		if (CH->SLOT[SLOT1].state != EG_OFF || CH->SLOT[SLOT2].state != EG_OFF ||
+			CH->SLOT[SLOT3].state != EG_OFF || CH->SLOT[SLOT4].state != EG_OFF ||
+			CH->op1_out[0] != 0 || CH->op1_out[1] != 0 || CH->mem_value != 0)
+			mask |= 1 << c;
+	}
+	return mask;
+}
+
+/* calculate a channel unless the mask says it is silent */
+static inline void chan_calc_active(YM2612 *F2612, fm2612_FM_OPN *OPN, int chnum, UINT32 active)
+{
+	fm2612_FM_CH *CH = &F2612->CH[chnum];
+	if (active & (1 << chnum))
+		chan_calc(F2612, OPN, CH);
+	else if (CHECK_SILENT_SKIP)
+	{
+		chan_calc(F2612, OPN, CH);
+		if (OPN->out_fm[chnum] != 0 || CH->op1_out[1] != 0 || CH->mem_value != 0)
+			fatalerror("YM2612: skipped channel %d is not silent\n", chnum);
+	}
+}
+
 static void FMCloseTable( void )
 {
 #ifdef SAVE_SAMPLE
@@ -2196,6 +2236,8 @@ void ym2612_update_one(void *chip, FMSAMPLE **buffer, int length)
 	cch[4]   = &F2612->CH[4];
 	cch[5]   = &F2612->CH[5];
 
+	UINT32 active = OPN_active_channels(F2612->CH, 6);
+
 	/* refresh PG and EG */
 	refresh_fc_eg_chan( OPN, cch[0] );
 	refresh_fc_eg_chan( OPN, cch[1] );
@@ -2233,16 +2275,16 @@ void ym2612_update_one(void *chip, FMSAMPLE **buffer, int length)
 		update_ssg_eg_channel(&cch[4]->SLOT[SLOT1]);
 		update_ssg_eg_channel(&cch[5]->SLOT[SLOT1]);
 
-		/* calculate FM */
-		chan_calc(F2612, OPN, cch[0]);
-		chan_calc(F2612, OPN, cch[1]);
-		chan_calc(F2612, OPN, cch[2]);
-		chan_calc(F2612, OPN, cch[3]);
-		chan_calc(F2612, OPN, cch[4]);
+		/* calculate FM, silent channels add nothing */
+		chan_calc_active(F2612, OPN, 0, active);
+		chan_calc_active(F2612, OPN, 1, active);
+		chan_calc_active(F2612, OPN, 2, active);
+		chan_calc_active(F2612, OPN, 3, active);
+		chan_calc_active(F2612, OPN, 4, active);
 		if( F2612->dacen )
 			*cch[5]->connect4 += F2612->dacout;
 		else
-			chan_calc(F2612, OPN, cch[5]);
+			chan_calc_active(F2612, OPN, 5, active);
 
 		/* advance LFO */
 		advance_lfo(OPN);
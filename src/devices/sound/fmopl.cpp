@@ -186,6 +186,10 @@ static FILE *sample[1];
 #define LOG_CYM_FILE 0
 static FILE * cymfile = nullptr;
 
+/* debug: set to 1 to still compute the channels the silence mask skips
+   and stop when one of them would have produced output */
+#define CHECK_SILENT_SKIP 0
+
 
 
 #define OPL_TYPE_WAVESEL   0x01  /* waveform select     */
@@ -943,6 +947,39 @@ static inline void OPL_CALC_CH( FM_OPL *OPL, OPL_CH *CH )
 		OPL->output[0] += op_calc(SLOT->Cnt, env, OPL->phase_modulation, SLOT->wavetable);
 }
 
+/* mask of channels that can produce output
+** A channel with both slots in EG_OFF state and no feedback samples left
+** stays silent until it is keyed on, which only happens between updates
+** (CSM key on brings the stream up to date first).
+*/
+static inline UINT32 OPL_active_channels( FM_OPL *OPL )
+{
+	UINT32 mask = 0;
+	for (int c = 0; c < 9; c++)
+	{
+		const OPL_CH *CH = &OPL->P_CH[c];
+		if (CH->SLOT[SLOT1].state != EG_OFF || CH->SLOT[SLOT2].state != EG_OFF ||
+			CH->SLOT[SLOT1].op1_out[0] != 0 || CH->SLOT[SLOT1].op1_out[1] != 0)
+			mask |= 1 << c;
+	}
+	return mask;
+}
+
+/* calculate a channel unless the mask says it is silent */
+static inline void OPL_CALC_CH_ACTIVE( FM_OPL *OPL, int c, UINT32 active )
+{
+	if (active & (1 << c))
+		OPL_CALC_CH(OPL, &OPL->P_CH[c]);
+	else if (CHECK_SILENT_SKIP)
+	{
+		const OPL_SLOT *SLOT = &OPL->P_CH[c].SLOT[SLOT1];
+		signed int output = OPL->output[0];
+		OPL_CALC_CH(OPL, &OPL->P_CH[c]);
+		if (OPL->output[0] != output || SLOT->op1_out[1] != 0)
+			fatalerror("OPL: skipped channel %d is not silent\n", c);
+	}
+}
+
 /*
     operators used in the rhythm sounds generation process:
 
@@ -2224,6 +2261,7 @@ void ym3812_update_one(void *chip, OPLSAMPLE *buffer, int length)
 {
 	FM_OPL      *OPL = (FM_OPL *)chip;
 	UINT8       rhythm = OPL->rhythm&0x20;
+	UINT32      active = OPL_active_channels(OPL);
 	OPLSAMPLE   *buf = buffer;
 	int i;
 
@@ -2235,19 +2273,19 @@ void ym3812_update_one(void *chip, OPLSAMPLE *buffer, int length)
 
 		advance_lfo(OPL);
 
-		/* FM part */
-		OPL_CALC_CH(OPL, &OPL->P_CH[0]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[1]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[2]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[3]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[4]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[5]);
+		/* FM part, silent channels add nothing */
+		OPL_CALC_CH_ACTIVE(OPL, 0, active);
+		OPL_CALC_CH_ACTIVE(OPL, 1, active);
+		OPL_CALC_CH_ACTIVE(OPL, 2, active);
+		OPL_CALC_CH_ACTIVE(OPL, 3, active);
+		OPL_CALC_CH_ACTIVE(OPL, 4, active);
+		OPL_CALC_CH_ACTIVE(OPL, 5, active);
 
 		if(!rhythm)
 		{
-			OPL_CALC_CH(OPL, &OPL->P_CH[6]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[7]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[8]);
+			OPL_CALC_CH_ACTIVE(OPL, 6, active);
+			OPL_CALC_CH_ACTIVE(OPL, 7, active);
+			OPL_CALC_CH_ACTIVE(OPL, 8, active);
 		}
 		else        /* Rhythm part */
 		{
@@ -2351,6 +2389,7 @@ void ym3526_update_one(void *chip, OPLSAMPLE *buffer, int length)
 {
 	FM_OPL      *OPL = (FM_OPL *)chip;
 	UINT8       rhythm = OPL->rhythm&0x20;
+	UINT32      active = OPL_active_channels(OPL);
 	OPLSAMPLE   *buf = buffer;
 	int i;
 
@@ -2362,19 +2401,19 @@ void ym3526_update_one(void *chip, OPLSAMPLE *buffer, int length)
 
 		advance_lfo(OPL);
 
-		/* FM part */
-		OPL_CALC_CH(OPL, &OPL->P_CH[0]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[1]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[2]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[3]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[4]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[5]);
+		/* FM part, silent channels add nothing */
+		OPL_CALC_CH_ACTIVE(OPL, 0, active);
+		OPL_CALC_CH_ACTIVE(OPL, 1, active);
+		OPL_CALC_CH_ACTIVE(OPL, 2, active);
+		OPL_CALC_CH_ACTIVE(OPL, 3, active);
+		OPL_CALC_CH_ACTIVE(OPL, 4, active);
+		OPL_CALC_CH_ACTIVE(OPL, 5, active);
 
 		if(!rhythm)
 		{
-			OPL_CALC_CH(OPL, &OPL->P_CH[6]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[7]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[8]);
+			OPL_CALC_CH_ACTIVE(OPL, 6, active);
+			OPL_CALC_CH_ACTIVE(OPL, 7, active);
+			OPL_CALC_CH_ACTIVE(OPL, 8, active);
 		}
 		else        /* Rhythm part */
 		{
@@ -2506,6 +2545,7 @@ void y8950_update_one(void *chip, OPLSAMPLE *buffer, int length)
 	int i;
 	FM_OPL      *OPL = (FM_OPL *)chip;
 	UINT8       rhythm  = OPL->rhythm&0x20;
+	UINT32      active  = OPL_active_channels(OPL);
 	YM_DELTAT   *DELTAT = OPL->deltat;
 	OPLSAMPLE   *buf    = buffer;
 
@@ -2522,19 +2562,19 @@ void y8950_update_one(void *chip, OPLSAMPLE *buffer, int length)
 		if( DELTAT->portstate&0x80 )
 			YM_DELTAT_ADPCM_CALC(DELTAT);
 
-		/* FM part */
-		OPL_CALC_CH(OPL, &OPL->P_CH[0]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[1]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[2]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[3]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[4]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[5]);
+		/* FM part, silent channels add nothing */
+		OPL_CALC_CH_ACTIVE(OPL, 0, active);
+		OPL_CALC_CH_ACTIVE(OPL, 1, active);
+		OPL_CALC_CH_ACTIVE(OPL, 2, active);
+		OPL_CALC_CH_ACTIVE(OPL, 3, active);
+		OPL_CALC_CH_ACTIVE(OPL, 4, active);
+		OPL_CALC_CH_ACTIVE(OPL, 5, active);
 
 		if(!rhythm)
 		{
-			OPL_CALC_CH(OPL, &OPL->P_CH[6]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[7]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[8]);
+			OPL_CALC_CH_ACTIVE(OPL, 6, active);
+			OPL_CALC_CH_ACTIVE(OPL, 7, active);
+			OPL_CALC_CH_ACTIVE(OPL, 8, active);
 		}
 		else        /* Rhythm part */
 		{
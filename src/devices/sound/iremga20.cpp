@@ -30,6 +30,7 @@ Revisions:
 
 #include "emu.h"
 #include "iremga20.h"
+#include "pcmvoice.h"
 
 #define MAX_VOL 256
 
@@ -103,81 +104,75 @@ void iremga20_device::device_reset()
 
 
 //-------------------------------------------------
-//  sound_stream_update - handle a stream update
+//  iremga20_voice - channel state for
+//  pcm_voice_mix
 //-------------------------------------------------
 
-void iremga20_device::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
+class iremga20_voice
 {
-	UINT32 rate[4], pos[4], frac[4], end[4], vol[4], play[4];
-	UINT8 *pSamples;
-	stream_sample_t *outL, *outR;
-	int i, sampleout;
-
-	/* precache some values */
-	for (i=0; i < 4; i++)
+public:
+	iremga20_voice(const UINT8 *rom, IremGA20_channel_def &channel)
+		: m_rom(rom), m_channel(channel), m_end(channel.end - 0x20)
 	{
-		rate[i] = m_channel[i].rate;
-		pos[i] = m_channel[i].pos;
-		frac[i] = m_channel[i].frac;
-		end[i] = m_channel[i].end - 0x20;
-		vol[i] = m_channel[i].volume;
-		play[i] = m_channel[i].play;
 	}
 
-	i = samples;
-	pSamples = m_rom;
-	outL = outputs[0];
-	outR = outputs[1];
-
-	for (i = 0; i < samples; i++)
+	int run(int limit)
 	{
-		sampleout = 0;
+		if (!m_channel.play)
+			return 0;
 
-		// update the 4 channels inline
-		if (play[0])
+		/* the channel stops after the step that takes it to the end address */
+		UINT64 steps = 1;
+		if (m_channel.pos < m_end)
 		{
-			sampleout += (pSamples[pos[0]] - 0x80) * vol[0];
-			frac[0] += rate[0];
-			pos[0] += frac[0] >> 24;
-			frac[0] &= 0xffffff;
-			play[0] = (pos[0] < end[0]);
-		}
-		if (play[1])
-		{
-			sampleout += (pSamples[pos[1]] - 0x80) * vol[1];
-			frac[1] += rate[1];
-			pos[1] += frac[1] >> 24;
-			frac[1] &= 0xffffff;
-			play[1] = (pos[1] < end[1]);
-		}
-		if (play[2])
-		{
-			sampleout += (pSamples[pos[2]] - 0x80) * vol[2];
-			frac[2] += rate[2];
-			pos[2] += frac[2] >> 24;
-			frac[2] &= 0xffffff;
-			play[2] = (pos[2] < end[2]);
-		}
-		if (play[3])
-		{
-			sampleout += (pSamples[pos[3]] - 0x80) * vol[3];
-			frac[3] += rate[3];
-			pos[3] += frac[3] >> 24;
-			frac[3] &= 0xffffff;
-			play[3] = (pos[3] < end[3]);
+			if (m_channel.rate == 0)
+				return limit;
+			const UINT64 dist = (UINT64(m_end - m_channel.pos) << 24) - m_channel.frac;
+			steps = (dist + m_channel.rate - 1) / m_channel.rate;
 		}
+		if (steps > UINT64(limit))
+			return limit;
+		m_channel.play = 0;
+		return steps;
+	}
+
+	INT32 fetch() const { return m_rom[m_channel.pos] - 0x80; }
+
+	void step()
+	{
+		m_channel.frac += m_channel.rate;
+		m_channel.pos += m_channel.frac >> 24;
+		m_channel.frac &= 0xffffff;
+	}
+
+private:
+	const UINT8 *m_rom;
+	IremGA20_channel_def &m_channel;
+	UINT32 m_end;
+};
+
 
-		sampleout >>= 2;
-		outL[i] = sampleout;
-		outR[i] = sampleout;
+//-------------------------------------------------
+//  sound_stream_update - handle a stream update
+//-------------------------------------------------
+
+void iremga20_device::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
+{
+	stream_sample_t *outL = outputs[0];
+	stream_sample_t *outR = outputs[1];
+
+	memset(outL, 0, samples * sizeof(*outL));
+
+	for (int i = 0; i < 4; i++)
+	{
+		iremga20_voice voice(m_rom, m_channel[i]);
+		pcm_voice_mix(voice, m_channel[i].volume, outL, samples);
 	}
 
-	/* update the regs now */
-	for (i=0; i < 4; i++)
+	for (int i = 0; i < samples; i++)
 	{
-		m_channel[i].pos = pos[i];
-		m_channel[i].frac = frac[i];
-		m_channel[i].play = play[i];
+		outL[i] >>= 2;
+		outR[i] = outL[i];
 	}
 }
 
@@ -0,0 +1,154 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    pcmvoice.h
+
+    Shared voice mixing loop for ROM sample playback chips.
+
+    A chip describes each voice with a small class providing
+
+        int run(int limit);     number of samples (at most limit) that
+                                can be played before the voice has to
+                                check its end address again; handles
+                                looping and returns 0 once stopped
+        INT32 fetch() const;    current sample value
+        void step();            advance to the next output sample
+
+    run() is called once per stretch of samples, so the sample loop
+    itself does no bounds or loop checks and stays branch free.
+
+    Chips that decode into a buffer and resample it can use
+    pcm_interp_mix() for the linear interpolation between two decoded
+    samples instead. It has an SSE2 path on 64-bit x86 builds.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __PCMVOICE_H__
+#define __PCMVOICE_H__
+
+/* use SSE2 on 64-bit implementations, where it can be assumed */
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define PCMVOICE_SSE2 1
+#else
+#define PCMVOICE_SSE2 0
+#endif
+
+
+//-------------------------------------------------
+//  pcm_voice_mix - add a voice to a stereo pair
+//  of buffers; returns the number of samples
+//  played before the voice stopped
+//-------------------------------------------------
+
+template <class Voice>
+inline int pcm_voice_mix(Voice &voice, INT32 lvol, INT32 rvol, stream_sample_t *left, stream_sample_t *right, int samples)
+{
+	int done = 0;
+	while (done < samples)
+	{
+		const int run = voice.run(samples - done);
+		if (run == 0)
+			break;
+		for (int i = done; i < done + run; i++)
+		{
+			const INT32 v = voice.fetch();
+			left[i] += v * lvol;
+			right[i] += v * rvol;
+			voice.step();
+		}
+		done += run;
+	}
+	return done;
+}
+
+
+//-------------------------------------------------
+//  pcm_voice_mix - add a voice to a mono buffer
+//-------------------------------------------------
+
+template <class Voice>
+inline int pcm_voice_mix(Voice &voice, INT32 vol, stream_sample_t *out, int samples)
+{
+	int done = 0;
+	while (done < samples)
+	{
+		const int run = voice.run(samples - done);
+		if (run == 0)
+			break;
+		for (int i = done; i < done + run; i++)
+		{
+			out[i] += voice.fetch() * vol;
+			voice.step();
+		}
+		done += run;
+	}
+	return done;
+}
+
+
+//-------------------------------------------------
+//  pcm_interp_mix - add samples interpolated
+//  between prev and curr to a stereo pair of
+//  buffers, stepping pos until it reaches the
+//  next source sample at 1 << FracBits; returns
+//  the number of samples added
+//-------------------------------------------------
+
+template <int FracBits>
+inline int pcm_interp_mix(INT16 prev, INT16 curr, INT32 &pos, INT32 step, INT32 lvol, INT32 rvol, stream_sample_t *left, stream_sample_t *right, int samples)
+{
+	const INT32 one = 1 << FracBits;
+	if (pos >= one)
+		return 0;
+
+	int count = samples;
+	if (step > 0 && (one - pos + step - 1) / step < count)
+		count = (one - pos + step - 1) / step;
+
+	int i = 0;
+#if PCMVOICE_SSE2
+	// the weights one - p and p fit in 16 bits up to 14 fraction bits,
+	// so one multiply-add per lane does the interpolation
+	if (FracBits <= 14 && lvol >= -32768 && lvol <= 32767 && rvol >= -32768 && rvol <= 32767)
+	{
+		const __m128i pc = _mm_set1_epi32((UINT16)prev | ((UINT32)(UINT16)curr << 16));
+		const __m128i vone = _mm_set1_epi32(one);
+		const __m128i step4 = _mm_set1_epi32(step * 4);
+		const __m128i lv = _mm_set1_epi16(lvol);
+		const __m128i rv = _mm_set1_epi16(rvol);
+		__m128i p = _mm_set_epi32(pos + 3 * step, pos + 2 * step, pos + step, pos);
+		for ( ; i + 8 <= count; i += 8)
+		{
+			const __m128i p1 = _mm_add_epi32(p, step4);
+			const __m128i w0 = _mm_or_si128(_mm_sub_epi32(vone, p), _mm_slli_epi32(p, 16));
+			const __m128i w1 = _mm_or_si128(_mm_sub_epi32(vone, p1), _mm_slli_epi32(p1, 16));
+			const __m128i v = _mm_packs_epi32(_mm_srai_epi32(_mm_madd_epi16(pc, w0), FracBits), _mm_srai_epi32(_mm_madd_epi16(pc, w1), FracBits));
+			p = _mm_add_epi32(p1, step4);
+
+			const __m128i llo = _mm_mullo_epi16(v, lv), lhi = _mm_mulhi_epi16(v, lv);
+			const __m128i rlo = _mm_mullo_epi16(v, rv), rhi = _mm_mulhi_epi16(v, rv);
+			__m128i *l = (__m128i *)&left[i];
+			__m128i *r = (__m128i *)&right[i];
+			_mm_storeu_si128(l, _mm_add_epi32(_mm_loadu_si128(l), _mm_unpacklo_epi16(llo, lhi)));
+			_mm_storeu_si128(l + 1, _mm_add_epi32(_mm_loadu_si128(l + 1), _mm_unpackhi_epi16(llo, lhi)));
+			_mm_storeu_si128(r, _mm_add_epi32(_mm_loadu_si128(r), _mm_unpacklo_epi16(rlo, rhi)));
+			_mm_storeu_si128(r + 1, _mm_add_epi32(_mm_loadu_si128(r + 1), _mm_unpackhi_epi16(rlo, rhi)));
+		}
+	}
+#endif
+	for ( ; i < count; i++)
+	{
+		const INT32 p = pos + i * step;
+		const INT32 v = (prev * (one - p) + curr * p) >> FracBits;
+		left[i] += v * lvol;
+		right[i] += v * rvol;
+	}
+	pos += count * step;
+	return count;
+}
+
+#endif /* __PCMVOICE_H__ */
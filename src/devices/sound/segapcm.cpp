@@ -6,6 +6,7 @@
 
 #include "emu.h"
 #include "segapcm.h"
+#include "pcmvoice.h"
 
 
 // device type definition
@@ -58,6 +59,57 @@ void segapcm_device::device_start()
 }
 
 
+//-------------------------------------------------
+//  segapcm_voice - channel state for pcm_voice_mix
+//-------------------------------------------------
+
+class segapcm_voice
+{
+public:
+	segapcm_voice(const UINT8 *rom, UINT32 mask, UINT8 *regs, UINT32 addr)
+		: m_rom(rom), m_mask(mask), m_regs(regs), m_addr(addr),
+			m_loop((regs[0x05] << 16) | (regs[0x04] << 8)), m_end(regs[6] + 1), m_delta(regs[7])
+	{
+	}
+
+	int run(int limit)
+	{
+		/* handle looping if we've hit the end */
+		if ((m_addr >> 16) == m_end)
+		{
+			if (m_regs[0x86] & 2)
+			{
+				m_regs[0x86] |= 1;
+				return 0;
+			}
+			m_addr = m_loop;
+			return 1;
+		}
+		if (m_delta == 0)
+			return limit;
+
+		/* the delta is below 0x100, so the end page can't be skipped */
+		const UINT32 dist = ((m_end << 16) - m_addr) & 0xffffff;
+		const UINT32 steps = (dist + m_delta - 1) / m_delta;
+		return (steps < UINT32(limit)) ? steps : limit;
+	}
+
+	INT32 fetch() const { return INT8(m_rom[(m_addr >> 8) & m_mask] - 0x80); }
+	void step() { m_addr = (m_addr + m_delta) & 0xffffff; }
+
+	UINT32 addr() const { return m_addr; }
+
+private:
+	const UINT8 *m_rom;
+	UINT32 m_mask;
+	UINT8 *m_regs;
+	UINT32 m_addr;
+	UINT32 m_loop;
+	UINT8 m_end;
+	UINT32 m_delta;
+};
+
+
 //-------------------------------------------------
 //  sound_stream_update - handle a stream update
 //-------------------------------------------------
@@ -98,37 +150,13 @@ void segapcm_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 		if (!(regs[0x86]&1))
 		{
 			const UINT8 *rom = m_rom + ((regs[0x86] & m_bankmask) << m_bankshift);
-			UINT32 addr = (regs[0x85] << 16) | (regs[0x84] << 8) | m_low[ch];
-			UINT32 loop = (regs[0x05] << 16) | (regs[0x04] << 8);
-			UINT8 end = regs[6] + 1;
-			int i;
+			segapcm_voice voice(rom, m_rom.mask(), regs, (regs[0x85] << 16) | (regs[0x84] << 8) | m_low[ch]);
 
-			/* loop over samples on this channel */
-			for (i = 0; i < samples; i++)
-			{
-				INT8 v;
-
-				/* handle looping if we've hit the end */
-				if ((addr >> 16) == end)
-				{
-					if (regs[0x86] & 2)
-					{
-						regs[0x86] |= 1;
-						break;
-					}
-					else addr = loop;
-				}
-
-				/* fetch the sample */
-				v = rom[(addr >> 8) & m_rom.mask()] - 0x80;
-
-				/* apply panning and advance */
-				outputs[0][i] += v * (regs[2] & 0x7f);
-				outputs[1][i] += v * (regs[3] & 0x7f);
-				addr = (addr + regs[7]) & 0xffffff;
-			}
+			/* mix the channel, applying panning */
+			pcm_voice_mix(voice, regs[2] & 0x7f, regs[3] & 0x7f, outputs[0], outputs[1], samples);
 
 			/* store back the updated address */
+			const UINT32 addr = voice.addr();
 			regs[0x84] = addr >> 8;
 			regs[0x85] = addr >> 16;
 			m_low[ch] = regs[0x86] & 1 ? 0 : addr;
@@ -23,6 +23,10 @@
 #define LOG_CYM_FILE 0
 static FILE * cymfile = nullptr;
 
+/* debug: set to 1 to still compute the channels the silence mask skips
+   and stop when one of them would have produced output */
+#define CHECK_SILENT_SKIP 0
+
 
 /* struct describing a single operator */
 struct YM2151Operator
@@ -2091,6 +2095,41 @@ static inline void advance_eg(YM2151 *PSG)
 }
 
 
+/*  A channel whose operators are all in EG_OFF state and which holds no
+*   feedback or MEM data outputs nothing until it is keyed on again. Key on
+*   happens between updates or from CSM, so the mask stays valid for the
+*   rest of an update unless CSM fires.
+*/
+static inline UINT32 active_channels(YM2151 *PSG)
+{
+	UINT32 mask = 0;
+	for (int chan = 0; chan < 8; chan++)
+	{
+		const YM2151Operator *op = &PSG->oper[chan*4];
+		if (op[0].state != EG_OFF || op[1].state != EG_OFF || op[2].state != EG_OFF || op[3].state != EG_OFF ||
+			op->fb_out_prev != 0 || op->fb_out_curr != 0 || op->mem_value != 0)
+			mask |= 1 << chan;
+	}
+	return mask;
+}
+
+/* calculate a channel unless the mask says it is silent */
+static inline void chan_calc_active(YM2151 *PSG, unsigned int chan, UINT32 active)
+{
+	bool skipped = !(active & (1 << chan));
+	if (skipped && !CHECK_SILENT_SKIP)
+		return;
+
+	if (chan == 7)
+		chan7_calc(PSG);
+	else
+		chan_calc(PSG, chan);
+
+	const YM2151Operator *op = &PSG->oper[chan*4];
+	if (skipped && (PSG->chanout[chan] != 0 || op->fb_out_curr != 0 || op->mem_value != 0))
+		fatalerror("YM2151: skipped channel %d is not silent\n", chan);
+}
+
 static inline void advance(YM2151 *PSG)
 {
 	YM2151Operator *op;
@@ -2383,6 +2422,7 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 	int i;
 	signed int outl,outr;
 	SAMP *bufL, *bufR;
+	UINT32 active = active_channels(PSG);
 
 	bufL = buffers[0];
 	bufR = buffers[1];
@@ -2419,21 +2459,22 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 		chanout[6] = 0;
 		chanout[7] = 0;
 
-		chan_calc(PSG, 0);
+		/* silent channels leave chanout at 0 */
+		chan_calc_active(PSG, 0, active);
 		SAVE_SINGLE_CHANNEL(0)
-		chan_calc(PSG, 1);
+		chan_calc_active(PSG, 1, active);
 		SAVE_SINGLE_CHANNEL(1)
-		chan_calc(PSG, 2);
+		chan_calc_active(PSG, 2, active);
 		SAVE_SINGLE_CHANNEL(2)
-		chan_calc(PSG, 3);
+		chan_calc_active(PSG, 3, active);
 		SAVE_SINGLE_CHANNEL(3)
-		chan_calc(PSG, 4);
+		chan_calc_active(PSG, 4, active);
 		SAVE_SINGLE_CHANNEL(4)
-		chan_calc(PSG, 5);
+		chan_calc_active(PSG, 5, active);
 		SAVE_SINGLE_CHANNEL(5)
-		chan_calc(PSG, 6);
+		chan_calc_active(PSG, 6, active);
 		SAVE_SINGLE_CHANNEL(6)
-		chan7_calc(PSG);
+		chan_calc_active(PSG, 7, active);
 		SAVE_SINGLE_CHANNEL(7)
 
 		outl = chanout[0] & PSG->pan[0];
@@ -2485,7 +2526,13 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 			}
 		}
 #endif
-		advance(PSG);
+		if (PSG->csm_req)
+		{
+			advance(PSG);
+			active = active_channels(PSG);
+		}
+		else
+			advance(PSG);
 	}
 }
 
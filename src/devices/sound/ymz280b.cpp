@@ -32,6 +32,7 @@
 
 #include "emu.h"
 #include "ymz280b.h"
+#include "pcmvoice.h"
 
 
 #define MAX_SAMPLE_CHUNK    10000
@@ -471,14 +472,10 @@ void ymz280b_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 
 		/* finish off the current sample */
 		/* interpolate */
-		while (remaining > 0 && voice->output_pos < FRAC_ONE)
-		{
-			int interp_sample = (((INT32)prev * (FRAC_ONE - voice->output_pos)) + ((INT32)curr * voice->output_pos)) >> FRAC_BITS;
-			*ldest++ += interp_sample * lvol;
-			*rdest++ += interp_sample * rvol;
-			voice->output_pos += voice->output_step;
-			remaining--;
-		}
+		int done = pcm_interp_mix<FRAC_BITS>(prev, curr, voice->output_pos, voice->output_step, lvol, rvol, ldest, rdest, remaining);
+		ldest += done;
+		rdest += done;
+		remaining -= done;
 
 		/* if we're over, continue; otherwise, we're done */
 		if (voice->output_pos >= FRAC_ONE)
@@ -535,14 +532,10 @@ void ymz280b_device::sound_stream_update(sound_stream &stream, stream_sample_t *
 		while (remaining > 0)
 		{
 			/* interpolate */
-			while (remaining > 0 && voice->output_pos < FRAC_ONE)
-			{
-				int interp_sample = (((INT32)prev * (FRAC_ONE - voice->output_pos)) + ((INT32)curr * voice->output_pos)) >> FRAC_BITS;
-				*ldest++ += interp_sample * lvol;
-				*rdest++ += interp_sample * rvol;
-				voice->output_pos += voice->output_step;
-				remaining--;
-			}
+			done = pcm_interp_mix<FRAC_BITS>(prev, curr, voice->output_pos, voice->output_step, lvol, rvol, ldest, rdest, remaining);
+			ldest += done;
+			rdest += done;
+			remaining -= done;
 
 			/* if we're over, grab the next samples */
 			if (voice->output_pos >= FRAC_ONE)
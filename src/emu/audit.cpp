@@ -26,7 +26,8 @@
 media_auditor::media_auditor(const driver_enumerator &enumerator)
 	: m_enumerator(enumerator),
 		m_validation(AUDIT_VALIDATE_FULL),
-		m_searchpath(nullptr)
+		m_searchpath(nullptr),
+		m_hash_cache(nullptr)
 {
 }
 
@@ -442,7 +443,10 @@ audit_record *media_auditor::audit_one_rom(const rom_entry *rom)
 		// if it worked, get the actual length and hashes, then stop
 		if (filerr == FILERR_NONE)
 		{
-			record.set_actual(file.hashes(m_validation), file.size());
+			if (m_hash_cache != nullptr)
+				record.set_actual(m_hash_cache->hashes(file, m_validation), file.size());
+			else
+				record.set_actual(file.hashes(m_validation), file.size());
 			break;
 		}
 	}
@@ -606,3 +610,171 @@ audit_record::audit_record(const char *name, media_type type)
 		m_shared_device(nullptr)
 {
 }
+
+
+
+//**************************************************************************
+//  HASH CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  has_hash_types - return true if a collection
+//  holds every one of the given hash types
+//-------------------------------------------------
+
+static bool has_hash_types(const hash_collection &hashes, const char *types)
+{
+	std::string have = hashes.hash_types();
+	for (const char *scan = types; *scan != 0; scan++)
+		if (have.find_first_of(*scan) == std::string::npos)
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  audit_hash_cache - constructor; loads the
+//  cache file if there is one
+//-------------------------------------------------
+
+audit_hash_cache::audit_hash_cache(const char *filename)
+	: m_filename((filename != nullptr) ? filename : ""),
+		m_dirty(false),
+		m_hits(0),
+		m_misses(0)
+{
+	if (m_filename.empty())
+		return;
+
+	util::core_file::ptr file;
+	if (util::core_file::open(m_filename.c_str(), OPEN_FLAG_READ, file) != FILERR_NONE)
+		return;
+
+	// each line is: kind length stamp hashes name
+	char buffer[4096];
+	while (file->gets(buffer, ARRAY_LENGTH(buffer)) != nullptr)
+	{
+		if ((buffer[0] != 'F' && buffer[0] != 'A') || buffer[1] != ' ')
+			continue;
+
+		char *scan;
+		entry cached;
+		cached.length = strtoull(&buffer[2], &scan, 10);
+		cached.stamp = strtoull(scan, &scan, 10);
+		while (*scan == ' ')
+			scan++;
+		char *hashes = scan;
+		while (*scan != ' ' && *scan != 0)
+			scan++;
+		if (*scan != ' ' || scan == hashes)
+			continue;
+		cached.hashes.assign(hashes, scan - hashes);
+
+		std::string name(scan + 1);
+		while (!name.empty() && (name.back() == '\n' || name.back() == '\r'))
+			name.pop_back();
+		if (!name.empty())
+			m_entries[std::string(1, buffer[0]).append(name)] = cached;
+	}
+}
+
+
+//-------------------------------------------------
+//  ~audit_hash_cache - destructor
+//-------------------------------------------------
+
+audit_hash_cache::~audit_hash_cache()
+{
+	save();
+}
+
+
+//-------------------------------------------------
+//  hashes - return the hashes of an open file,
+//  taking them from the cache if the file has
+//  not changed since they were computed
+//-------------------------------------------------
+
+hash_collection audit_hash_cache::hashes(emu_file &file, const char *types)
+{
+	// archive members come with the CRC from the directory; that may be enough
+	const hash_collection &known = file.hashes("");
+	if (has_hash_types(known, types))
+		return known;
+
+	// archive members are identified by that CRC, plain files by modification time
+	std::string key;
+	UINT64 stamp = 0;
+	UINT32 crc;
+	if (known.crc(crc))
+	{
+		key.assign("A").append(file.fullpath()).append("\t").append(file.filename());
+		stamp = crc;
+	}
+	else
+	{
+		osd_directory_entry *stat = osd_stat(file.fullpath());
+		if (stat != nullptr)
+		{
+			stamp = stat->last_modified;
+			osd_free(stat);
+		}
+		key.assign("F").append(file.fullpath());
+	}
+
+	// without a stamp or with an unstorable name, don't cache at all
+	if (stamp == 0 || key.find_first_of("\r\n") != std::string::npos)
+		return file.hashes(types);
+
+	// use the cached hashes if the file looks the same
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		auto found = m_entries.find(key);
+		if (found != m_entries.end() && found->second.length == file.size() && found->second.stamp == stamp)
+		{
+			hash_collection cached;
+			if (cached.from_internal_string(found->second.hashes.c_str()) && has_hash_types(cached, types))
+			{
+				m_hits++;
+				return cached;
+			}
+		}
+		m_misses++;
+	}
+
+	// otherwise read the file (outside the lock) and remember the result
+	const hash_collection &actual = file.hashes(types);
+	if (has_hash_types(actual, types))
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		entry &cached = m_entries[key];
+		cached.length = file.size();
+		cached.stamp = stamp;
+		cached.hashes = actual.internal_string();
+		m_dirty = true;
+	}
+	return actual;
+}
+
+
+//-------------------------------------------------
+//  save - write the cache file back out if we
+//  added to it
+//-------------------------------------------------
+
+void audit_hash_cache::save()
+{
+	if (m_filename.empty() || !m_dirty)
+		return;
+
+	util::core_file::ptr file;
+	if (util::core_file::open(m_filename.c_str(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) != FILERR_NONE)
+	{
+		osd_printf_warning("Unable to write audit cache %s\n", m_filename.c_str());
+		return;
+	}
+
+	for (auto &cached : m_entries)
+		file->printf("%c %s %s %s %s\n", cached.first[0], std::to_string(cached.second.length).c_str(), std::to_string(cached.second.stamp).c_str(), cached.second.hashes.c_str(), cached.first.c_str() + 1);
+	m_dirty = false;
+}
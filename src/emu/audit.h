@@ -15,6 +15,8 @@
 
 #include "drivenum.h"
 #include "hash.h"
+#include <mutex>
+#include <unordered_map>
 
 
 
@@ -121,6 +123,46 @@ private:
 };
 
 
+// ======================> audit_hash_cache
+
+// remembers the hashes of files that have been audited, optionally across
+// runs, so that a file which has not changed is not read again; safe to
+// share between auditors running on different threads
+class audit_hash_cache
+{
+public:
+	// construction/destruction
+	audit_hash_cache(const char *filename = nullptr);
+	~audit_hash_cache();
+
+	// getters
+	int hits() const { return m_hits; }
+	int misses() const { return m_misses; }
+
+	// return the hashes of an open file, reading it only if it changed
+	hash_collection hashes(emu_file &file, const char *types);
+
+	// write the cache back out if anything was added
+	void save();
+
+private:
+	struct entry
+	{
+		UINT64          length;     // size of the file
+		UINT64          stamp;      // modification time, or CRC of an archive member
+		std::string     hashes;     // hashes in internal format
+	};
+
+	// internal state
+	std::string                             m_filename;
+	std::mutex                              m_lock;         // guards the entries and counters
+	std::unordered_map<std::string, entry>  m_entries;
+	bool                                    m_dirty;
+	int                                     m_hits;
+	int                                     m_misses;
+};
+
+
 // ======================> media_auditor
 
 // class which manages auditing of items
@@ -144,6 +186,9 @@ public:
 	audit_record *first() const { return m_record_list.first(); }
 	int count() const { return m_record_list.count(); }
 
+	// setters
+	void set_hash_cache(audit_hash_cache *cache) { m_hash_cache = cache; }
+
 	// audit operations
 	summary audit_media(const char *validation = AUDIT_VALIDATE_FULL);
 	summary audit_device(device_t *device, const char *validation = AUDIT_VALIDATE_FULL);
@@ -163,6 +208,7 @@ private:
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
 	const char *                m_searchpath;
+	audit_hash_cache *          m_hash_cache;
 };
 
 
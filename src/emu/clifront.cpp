@@ -31,6 +31,8 @@
 
 #include <new>
 #include <ctype.h>
+#include <functional>
+#include <unordered_map>
 
 
 
@@ -63,6 +65,50 @@ private:
 };
 
 
+// parallel_auditor runs audits on all processors; each thread gets its own
+// driver_enumerator and media_auditor, and results are left for the caller
+// to report in order
+class parallel_auditor
+{
+public:
+	typedef std::function<void (driver_enumerator &drivlist, media_auditor &auditor, int index)> audit_func;
+
+	// construction/destruction
+	parallel_auditor(cli_options &options, audit_hash_cache &hash_cache);
+	~parallel_auditor();
+
+	// operations
+	void run(int count, audit_func func);
+
+private:
+	struct worker
+	{
+		worker(cli_options &options) : m_drivlist(options), m_auditor(m_drivlist) { }
+
+		driver_enumerator   m_drivlist;
+		media_auditor       m_auditor;
+	};
+
+	struct item
+	{
+		parallel_auditor *  m_owner;
+		int                 m_index;
+	};
+
+	static void *work_item_static(void *param, int threadid);
+
+	// internal state
+	cli_options &           m_options;
+	audit_hash_cache &      m_hash_cache;
+	osd_work_queue *        m_queue;
+	audit_func              m_func;
+	std::unique_ptr<worker> m_worker[WORK_MAX_THREADS + 1];
+};
+
+// sets audited per batch by parallel_auditor before their results are shown
+#define AUDIT_BATCH_SIZE        256
+
+
 //**************************************************************************
 //  CLI FRONTEND
 //**************************************************************************
@@ -285,9 +331,9 @@ void cli_frontend::listxml(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
-	// create the XML and print it to stdout
+	// create the XML and print it to stdout, indexing it if asked to
 	info_xml_creator creator(drivlist);
-	creator.output(stdout);
+	creator.output(stdout, false, m_options.value(CLIOPTION_XMLINDEX));
 }
 
 
@@ -757,54 +803,90 @@ void cli_frontend::verifyroms(const char *gamename)
 	int notfound = 0;
 	int matched = 0;
 
-	// iterate over drivers
+	// audit the sets on all processors
 	media_auditor auditor(drivlist);
+	audit_hash_cache hash_cache(m_options.value(CLIOPTION_AUDITCACHE));
+	auditor.set_hash_cache(&hash_cache);
+	parallel_auditor workers(m_options, hash_cache);
+
+	std::vector<int> drivers;
 	while (drivlist.next())
-	{
-		matched++;
+		drivers.push_back(drivlist.current());
 
-		// audit the ROMs in this set
-		media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+	// a batch at a time, so results keep coming out in order
+	for (size_t base = 0; base < drivers.size(); base += AUDIT_BATCH_SIZE)
+	{
+		size_t count = MIN(AUDIT_BATCH_SIZE, drivers.size() - base);
+		std::vector<media_auditor::summary> summaries(count);
+		std::vector<std::string> summary_strings(count);
+
+		// keep a parent and its clones on one thread, so they find their shared archives cached
+		std::vector<std::vector<size_t>> families;
+		std::unordered_map<int, size_t> family_of;
+		for (size_t index = 0; index < count; index++)
+		{
+			int parent = driver_list::non_bios_clone(drivers[base + index]);
+			auto family = family_of.emplace((parent != -1) ? parent : drivers[base + index], families.size());
+			if (family.second)
+				families.emplace_back();
+			families[family.first->second].push_back(index);
+		}
 
-		// if not found, count that and leave it at that
-		if (summary == media_auditor::NOTFOUND)
-			notfound++;
+		workers.run(families.size(), [&](driver_enumerator &threadlist, media_auditor &threadauditor, int family)
+		{
+			for (size_t index : families[family])
+			{
+				threadlist.set_current(drivers[base + index]);
+				summaries[index] = threadauditor.audit_media(AUDIT_VALIDATE_FAST);
+				if (summaries[index] != media_auditor::NOTFOUND)
+					threadauditor.summarize(threadlist.driver().name, &summary_strings[index]);
+			}
+		});
 
-		// else display information about what we discovered
-		else
+		for (size_t index = 0; index < count; index++)
 		{
-			// output the summary of the audit
-			std::string summary_string;
-			auditor.summarize(drivlist.driver().name,&summary_string);
-			osd_printf_info("%s", summary_string.c_str());
+			drivlist.set_current(drivers[base + index]);
+			matched++;
 
-			// output the name of the driver and its clone
-			osd_printf_info("romset %s ", drivlist.driver().name);
-			int clone_of = drivlist.clone();
-			if (clone_of != -1)
-				osd_printf_info("[%s] ", drivlist.driver(clone_of).name);
+			// if not found, count that and leave it at that
+			media_auditor::summary summary = summaries[index];
+			if (summary == media_auditor::NOTFOUND)
+				notfound++;
 
-			// switch off of the result
-			switch (summary)
+			// else display information about what we discovered
+			else
 			{
-				case media_auditor::INCORRECT:
-					osd_printf_info("is bad\n");
-					incorrect++;
-					break;
-
-				case media_auditor::CORRECT:
-					osd_printf_info("is good\n");
-					correct++;
-					break;
+				// output the summary of the audit
+				osd_printf_info("%s", summary_strings[index].c_str());
 
-				case media_auditor::BEST_AVAILABLE:
-				case media_auditor::NONE_NEEDED:
-					osd_printf_info("is best available\n");
-					correct++;
-					break;
+				// output the name of the driver and its clone
+				osd_printf_info("romset %s ", drivlist.driver().name);
+				int clone_of = drivlist.clone();
+				if (clone_of != -1)
+					osd_printf_info("[%s] ", drivlist.driver(clone_of).name);
 
-				default:
-					break;
+				// switch off of the result
+				switch (summary)
+				{
+					case media_auditor::INCORRECT:
+						osd_printf_info("is bad\n");
+						incorrect++;
+						break;
+
+					case media_auditor::CORRECT:
+						osd_printf_info("is good\n");
+						correct++;
+						break;
+
+					case media_auditor::BEST_AVAILABLE:
+					case media_auditor::NONE_NEEDED:
+						osd_printf_info("is best available\n");
+						correct++;
+						break;
+
+					default:
+						break;
+				}
 			}
 		}
 	}
@@ -1327,6 +1409,79 @@ void cli_frontend::listsoftware(const char *gamename)
 }
 
 
+/*-------------------------------------------------
+    verify_software_list - audit every entry of
+    a software list on all processors and report
+    the results in list order
+-------------------------------------------------*/
+
+static void verify_software_list(parallel_auditor &workers, software_list_device &swlistdev, int &correct, int &incorrect, int &notfound)
+{
+	std::vector<software_info *> entries;
+	for (software_info *swinfo = swlistdev.first_software_info(); swinfo != nullptr; swinfo = swinfo->next())
+		entries.push_back(swinfo);
+
+	// a batch at a time, so results keep coming out in order
+	for (size_t base = 0; base < entries.size(); base += AUDIT_BATCH_SIZE)
+	{
+		size_t count = MIN(AUDIT_BATCH_SIZE, entries.size() - base);
+		std::vector<media_auditor::summary> summaries(count);
+		std::vector<std::string> summary_strings(count);
+
+		workers.run(count, [&](driver_enumerator &threadlist, media_auditor &threadauditor, int index)
+		{
+			software_info *swinfo = entries[base + index];
+			summaries[index] = threadauditor.audit_software(swlistdev.list_name(), swinfo, AUDIT_VALIDATE_FAST);
+			if (summaries[index] != media_auditor::NOTFOUND && summaries[index] != media_auditor::NONE_NEEDED)
+				threadauditor.summarize(swinfo->shortname(), &summary_strings[index]);
+		});
+
+		for (size_t index = 0; index < count; index++)
+		{
+			software_info *swinfo = entries[base + index];
+			media_auditor::summary summary = summaries[index];
+
+			// if not found, count that and leave it at that
+			if (summary == media_auditor::NOTFOUND)
+			{
+				notfound++;
+			}
+			// else display information about what we discovered
+			else if (summary != media_auditor::NONE_NEEDED)
+			{
+				// output the summary of the audit
+				osd_printf_info("%s", summary_strings[index].c_str());
+
+				// display information about what we discovered
+				osd_printf_info("romset %s:%s ", swlistdev.list_name(), swinfo->shortname());
+
+				// switch off of the result
+				switch (summary)
+				{
+					case media_auditor::INCORRECT:
+						osd_printf_info("is bad\n");
+						incorrect++;
+						break;
+
+					case media_auditor::CORRECT:
+						osd_printf_info("is good\n");
+						correct++;
+						break;
+
+					case media_auditor::BEST_AVAILABLE:
+						osd_printf_info("is best available\n");
+						correct++;
+						break;
+
+					default:
+						break;
+				}
+			}
+		}
+	}
+}
+
+
 /*-------------------------------------------------
     verifysoftware - verify roms from the software
     list of the specified driver(s)
@@ -1348,7 +1503,8 @@ void cli_frontend::verifysoftware(const char *gamename)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 	}
 
-	media_auditor auditor(drivlist);
+	audit_hash_cache hash_cache(m_options.value(CLIOPTION_AUDITCACHE));
+	parallel_auditor workers(m_options, hash_cache);
 	while (drivlist.next())
 	{
 		matched++;
@@ -1360,49 +1516,7 @@ void cli_frontend::verifysoftware(const char *gamename)
 					if (swlistdev->first_software_info() != nullptr)
 					{
 						nrlists++;
-						for (software_info *swinfo = swlistdev->first_software_info(); swinfo != nullptr; swinfo = swinfo->next())
-						{
-							media_auditor::summary summary = auditor.audit_software(swlistdev->list_name(), swinfo, AUDIT_VALIDATE_FAST);
-
-							// if not found, count that and leave it at that
-							if (summary == media_auditor::NOTFOUND)
-							{
-								notfound++;
-							}
-							// else display information about what we discovered
-							else if(summary != media_auditor::NONE_NEEDED)
-							{
-								// output the summary of the audit
-								std::string summary_string;
-								auditor.summarize(swinfo->shortname(), &summary_string);
-								osd_printf_info("%s", summary_string.c_str());
-
-								// display information about what we discovered
-								osd_printf_info("romset %s:%s ", swlistdev->list_name(), swinfo->shortname());
-
-								// switch off of the result
-								switch (summary)
-								{
-									case media_auditor::INCORRECT:
-										osd_printf_info("is bad\n");
-										incorrect++;
-										break;
-
-									case media_auditor::CORRECT:
-										osd_printf_info("is good\n");
-										correct++;
-										break;
-
-									case media_auditor::BEST_AVAILABLE:
-										osd_printf_info("is best available\n");
-										correct++;
-										break;
-
-									default:
-										break;
-								}
-							}
-						}
+						verify_software_list(workers, *swlistdev, correct, incorrect, notfound);
 					}
 	}
 
@@ -1470,7 +1584,8 @@ void cli_frontend::verifysoftlist(const char *gamename)
 	int matched = 0;
 
 	driver_enumerator drivlist(m_options);
-	media_auditor auditor(drivlist);
+	audit_hash_cache hash_cache(m_options.value(CLIOPTION_AUDITCACHE));
+	parallel_auditor workers(m_options, hash_cache);
 
 	while (drivlist.next())
 	{
@@ -1482,49 +1597,7 @@ void cli_frontend::verifysoftlist(const char *gamename)
 					matched++;
 
 					// Get the actual software list contents
-					for (software_info *swinfo = swlistdev->first_software_info(); swinfo != nullptr; swinfo = swinfo->next())
-					{
-						media_auditor::summary summary = auditor.audit_software(swlistdev->list_name(), swinfo, AUDIT_VALIDATE_FAST);
-
-						// if not found, count that and leave it at that
-						if (summary == media_auditor::NOTFOUND)
-						{
-							notfound++;
-						}
-						// else display information about what we discovered
-						else if (summary != media_auditor::NONE_NEEDED)
-						{
-							// output the summary of the audit
-							std::string summary_string;
-							auditor.summarize(swinfo->shortname(), &summary_string);
-							osd_printf_info("%s", summary_string.c_str());
-
-							// display information about what we discovered
-							osd_printf_info("romset %s:%s ", swlistdev->list_name(), swinfo->shortname());
-
-							// switch off of the result
-							switch (summary)
-							{
-								case media_auditor::INCORRECT:
-									osd_printf_info("is bad\n");
-									incorrect++;
-									break;
-
-								case media_auditor::CORRECT:
-									osd_printf_info("is good\n");
-									correct++;
-									break;
-
-								case media_auditor::BEST_AVAILABLE:
-									osd_printf_info("is best available\n");
-									correct++;
-									break;
-
-								default:
-									break;
-							}
-						}
-					}
+					verify_software_list(workers, *swlistdev, correct, incorrect, notfound);
 				}
 	}
 
@@ -1765,30 +1838,52 @@ void media_identifier::identify(const char *filename)
 		_7z_error _7zerr = _7z_file_open(filename, &_7z);
 		if (_7zerr == _7ZERR_NONE && _7z != nullptr)
 		{
-			// loop over entries in the .7z, skipping empty files and directories
-			for (int i = 0; i < _7z->db.db.NumFiles; i++)
+			// decompress the files a group at a time, so each solid block is only
+			// decoded once without holding more than the archive's block budget
+			for (int first = 0, last; first < _7z->db.db.NumFiles; first = last)
 			{
-				const CSzFileItem *f = _7z->db.db.Files + i;
-				_7z->curr_file_idx = i;
-				int namelen = SzArEx_GetFileNameUtf16(&_7z->db, i, nullptr);
-				std::vector<UINT16> temp(namelen);
-				dynamic_buffer temp2(namelen+1);
-				UINT8* temp3 = &temp2[0];
-				memset(temp3, 0x00, namelen);
-				SzArEx_GetFileNameUtf16(&_7z->db, i, &temp[0]);
-				// crude, need real UTF16->UTF8 conversion ideally
-				for (int j=0;j<namelen;j++)
+				std::vector<dynamic_buffer> data;
+				std::vector<_7z_request> requests;
+				UINT64 groupsize = 0;
+				for (last = first; last < _7z->db.db.NumFiles; last++)
 				{
-					temp3[j] = (UINT8)temp[j];
+					const CSzFileItem *f = _7z->db.db.Files + last;
+					if (f->IsDir || f->Size == 0)
+						continue;
+					if (!requests.empty() && groupsize + f->Size > _7z_get_block_cache_budget())
+						break;
+					groupsize += f->Size;
+					_7z_request request = { last, nullptr, UINT32(f->Size), _7ZERR_NONE };
+					requests.push_back(request);
 				}
+				data.resize(requests.size());
+				for (size_t reqnum = 0; reqnum < requests.size(); reqnum++)
+				{
+					data[reqnum].resize(requests[reqnum].length);
+					requests[reqnum].buffer = &data[reqnum][0];
+				}
+				if (!requests.empty())
+					_7z_file_decompress_multiple(_7z, &requests[0], requests.size());
 
-				if (!(f->IsDir) && (f->Size != 0))
+				// identify each file we decompressed
+				for (size_t reqnum = 0; reqnum < requests.size(); reqnum++)
 				{
-					// decompress data into RAM and identify it
-					dynamic_buffer data(f->Size);
-					_7zerr = _7z_file_decompress(_7z, &data[0], f->Size);
-					if (_7zerr == _7ZERR_NONE)
-						identify_data((const char*)&temp2[0], &data[0], f->Size);
+					_7z_request &request = requests[reqnum];
+					int i = request.file_index;
+					int namelen = SzArEx_GetFileNameUtf16(&_7z->db, i, nullptr);
+					std::vector<UINT16> temp(namelen);
+					dynamic_buffer temp2(namelen+1);
+					UINT8* temp3 = &temp2[0];
+					memset(temp3, 0x00, namelen);
+					SzArEx_GetFileNameUtf16(&_7z->db, i, &temp[0]);
+					// crude, need real UTF16->UTF8 conversion ideally
+					for (int j=0;j<namelen;j++)
+					{
+						temp3[j] = (UINT8)temp[j];
+					}
+
+					if (request.error == _7ZERR_NONE)
+						identify_data((const char*)&temp2[0], &data[reqnum][0], request.length);
 				}
 			}
 
@@ -1999,3 +2094,83 @@ int media_identifier::find_by_hash(const hash_collection &hashes, int length)
 
 	return found;
 }
+
+
+
+//**************************************************************************
+//  PARALLEL AUDITOR
+//**************************************************************************
+
+//-------------------------------------------------
+//  parallel_auditor - constructor
+//-------------------------------------------------
+
+parallel_auditor::parallel_auditor(cli_options &options, audit_hash_cache &hash_cache)
+	: m_options(options),
+		m_hash_cache(hash_cache),
+		m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI))
+{
+}
+
+
+//-------------------------------------------------
+//  ~parallel_auditor - destructor
+//-------------------------------------------------
+
+parallel_auditor::~parallel_auditor()
+{
+	if (m_queue != nullptr)
+		osd_work_queue_free(m_queue);
+}
+
+
+//-------------------------------------------------
+//  run - call func for indexes 0 to count-1 on
+//  all processors and wait for them to finish
+//-------------------------------------------------
+
+void parallel_auditor::run(int count, audit_func func)
+{
+	std::vector<item> items(count);
+	for (int index = 0; index < count; index++)
+	{
+		items[index].m_owner = this;
+		items[index].m_index = index;
+	}
+
+	m_func = func;
+	if (m_queue != nullptr && count > 1)
+	{
+		osd_work_item_queue_multiple(m_queue, work_item_static, count, &items[0], sizeof(items[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(m_queue, osd_ticks_per_second())) { }
+	}
+	else
+	{
+		for (item &cur : items)
+			work_item_static(&cur, 0);
+	}
+	m_func = nullptr;
+}
+
+
+//-------------------------------------------------
+//  work_item_static - audit one index with the
+//  calling thread's own enumerator and auditor
+//-------------------------------------------------
+
+void *parallel_auditor::work_item_static(void *param, int threadid)
+{
+	item &cur = *reinterpret_cast<item *>(param);
+	parallel_auditor &owner = *cur.m_owner;
+
+	// each thread only ever touches its own slot
+	std::unique_ptr<worker> &state = owner.m_worker[threadid];
+	if (!state)
+	{
+		state = std::make_unique<worker>(owner.m_options);
+		state->m_auditor.set_hash_cache(&owner.m_hash_cache);
+	}
+
+	owner.m_func(state->m_drivlist, state->m_auditor, cur.m_index);
+	return nullptr;
+}
@@ -46,6 +46,11 @@ const options_entry cli_options::s_option_entries[] =
 	{ CLICOMMAND_VERIFYSOFTWARE ";vsoft", "0",     OPTION_COMMAND,    "verify known software for the system" },
 	{ CLICOMMAND_GETSOFTLIST ";glist",  "0",       OPTION_COMMAND,    "retrieve software list by name" },
 	{ CLICOMMAND_VERIFYSOFTLIST ";vlist", "0",     OPTION_COMMAND,    "verify software list by name" },
+
+	/* frontend command options */
+	{ nullptr,                            nullptr,       OPTION_HEADER,     "FRONTEND COMMAND OPTIONS" },
+	{ CLIOPTION_AUDITCACHE,             "",        OPTION_STRING,     "file in which verify commands keep the hashes of files they have read" },
+	{ CLIOPTION_XMLINDEX,               "",        OPTION_STRING,     "file in which listxml writes a binary index of the machines for frontends" },
 	{ nullptr }
 };
 
@@ -48,6 +48,10 @@
 #define CLICOMMAND_GETSOFTLIST          "getsoftlist"
 #define CLICOMMAND_VERIFYSOFTLIST       "verifysoftlist"
 
+// frontend command options
+#define CLIOPTION_AUDITCACHE            "auditcache"
+#define CLIOPTION_XMLINDEX              "xmlindex"
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -0,0 +1,740 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/*************************************************************************
+
+    testuml.cpp
+
+    Example driver for differential testing of the UML back-ends.
+
+    Random UML sequences are compiled for both the C back-end and the
+    native back-end, run from identical starting states, and the
+    resulting registers, flags and scratch memory are compared.  A
+    second pass times a loop of each opcode class on both back-ends.
+
+**************************************************************************/
+
+
+#include "emu.h"
+#include "cpu/drcuml.h"
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+#define TEST_PROGRAMS           2000        // number of random programs to compare
+#define TEST_OPS                48          // operations per random program
+#define TEST_BENCH_OPS          32          // operations per benchmark loop body
+#define TEST_BENCH_ITERATIONS   100000      // benchmark loop iterations
+#define TEST_MEMORY_QWORDS      64          // size of the scratch memory
+#define TEST_IREGS              9           // integer registers used by the programs; I9 is the loop counter
+#define TEST_FREGS              8           // float registers used by the programs
+#define TEST_CACHE_SIZE         (4 * 1024 * 1024)
+
+using namespace uml;
+
+
+// opcode classes; each random operation is drawn from one of these
+enum
+{
+	CLASS_MOVE,
+	CLASS_ARITH,
+	CLASS_LOGIC,
+	CLASS_SHIFT,
+	CLASS_MULDIV,
+	CLASS_BITS,
+	CLASS_MEMORY,
+	CLASS_COND,
+	CLASS_FLOAT,
+	CLASS_COUNT
+};
+
+static const char *const s_class_names[CLASS_COUNT] =
+{
+	"move", "arith", "logic", "shift", "muldiv", "bits", "memory", "cond", "float"
+};
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// state shared between a program and the harness; lives in the near cache of each back-end
+struct uml_test_state
+{
+	UINT64      r[REG_I_COUNT];
+	UINT64      f[REG_F_COUNT];
+	UINT64      mem[TEST_MEMORY_QWORDS];
+	UINT32      flags[TEST_OPS];
+};
+
+
+// a source or destination operand
+struct uml_test_operand
+{
+	enum { REG, IMM, MEM } kind;
+	UINT64      value;                      // register number, immediate value or qword index
+};
+
+
+// a single generated operation; some expand to two UML instructions
+struct uml_test_op
+{
+	opcode_t            opcode;
+	UINT8               size;
+	condition_t         cond;               // condition for CLASS_COND
+	uml_test_operand    dst, edst, src1, src2;
+	operand_size        memsize;            // access size for LOAD/STORE/SEXT
+	UINT32              shift, mask;        // ROLAND/ROLINS arguments
+	bool                carry;              // preceded by CARRY src2,bit
+	bool                compare;            // preceded by CMP src1,src2 (CLASS_COND)
+};
+
+
+// simple reproducible random number source
+class uml_test_random
+{
+public:
+	uml_test_random(UINT64 seed) : m_state(seed * 0x9e3779b97f4a7c15ULL + 1) { }
+
+	UINT64 next()
+	{
+		m_state ^= m_state >> 12;
+		m_state ^= m_state << 25;
+		m_state ^= m_state >> 27;
+		return m_state * 0x2545f4914f6cdd1dULL;
+	}
+	UINT32 range(UINT32 count) { return next() % count; }
+
+private:
+	UINT64 m_state;
+};
+
+
+// one back-end along with its own cache and state
+class uml_test_backend
+{
+public:
+	uml_test_backend(device_t &device, UINT32 flags)
+		: m_cache(TEST_CACHE_SIZE),
+			m_drcuml(device, m_cache, flags, 1, 32, 0),
+			m_state((uml_test_state *)m_cache.alloc_near(sizeof(uml_test_state))),
+			m_entry(m_drcuml.handle_alloc("entry"))
+	{
+	}
+
+	uml_test_state &state() { return *m_state; }
+
+	void build(const std::vector<uml_test_op> &ops, UINT32 iterations);
+	void execute() { m_drcuml.execute(*m_entry); }
+	void dump_listing(int opnum);
+
+private:
+	void emit(drcuml_block &block, const uml_test_op &op, int index, bool record);
+	parameter operand(const uml_test_operand &operand) const;
+
+	drc_cache           m_cache;
+	drcuml_state        m_drcuml;
+	uml_test_state *    m_state;
+	code_handle *       m_entry;
+	std::vector<std::pair<int, instruction>> m_listing;  // unoptimized copy of the last program, tagged by operation
+};
+
+
+
+//**************************************************************************
+//  BACK-END WRAPPER
+//**************************************************************************
+
+//-------------------------------------------------
+//  operand - convert an operand description into
+//  a parameter for this back-end
+//-------------------------------------------------
+
+parameter uml_test_backend::operand(const uml_test_operand &operand) const
+{
+	switch (operand.kind)
+	{
+		case uml_test_operand::REG:     return ireg(operand.value);
+		case uml_test_operand::MEM:     return mem(&m_state->mem[operand.value]);
+		default:                        return parameter(operand.value);
+	}
+}
+
+
+//-------------------------------------------------
+//  dump_listing - print the instructions
+//  generated for one operation of the last
+//  program
+//-------------------------------------------------
+
+void uml_test_backend::dump_listing(int opnum)
+{
+	std::string text;
+	for (auto &entry : m_listing)
+		if (entry.first == opnum)
+			text.append(text.empty() ? "" : "; ").append(entry.second.disasm(&m_drcuml));
+	printf("  %2d: %s\n", opnum, text.c_str());
+}
+
+
+//-------------------------------------------------
+//  build - compile a program; if iterations is
+//  non-zero the body is wrapped in a loop
+//  counting down I9
+//-------------------------------------------------
+
+void uml_test_backend::build(const std::vector<uml_test_op> &ops, UINT32 iterations)
+{
+	m_drcuml.reset();
+	m_listing.clear();
+	drcuml_block *block = m_drcuml.begin_block(ops.size() * 4 + REG_I_COUNT * 2 + REG_F_COUNT * 2 + 16);
+
+	block->append().handle(*m_entry);
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		block->append().dmov(ireg(regnum), mem(&m_state->r[regnum]));
+	for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+		block->append().fdmov(freg(regnum), mem(&m_state->f[regnum]));
+
+	if (iterations != 0)
+	{
+		block->append().mov(I9, iterations);
+		block->append().label(1);
+	}
+
+	for (int opnum = 0; opnum < ops.size(); opnum++)
+		emit(*block, ops[opnum], opnum, iterations == 0);
+
+	if (iterations != 0)
+	{
+		block->append().sub(I9, I9, 1);
+		block->append().jmp(COND_NZ, 1);
+	}
+
+	for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+		block->append().dmov(mem(&m_state->r[regnum]), ireg(regnum));
+	for (int regnum = 0; regnum < REG_F_COUNT; regnum++)
+		block->append().fdmov(mem(&m_state->f[regnum]), freg(regnum));
+	block->append().exit(0);
+
+	block->end();
+}
+
+
+//-------------------------------------------------
+//  emit - emit the instructions for a single
+//  operation, followed by a capture of its flags
+//  when recording
+//-------------------------------------------------
+
+void uml_test_backend::emit(drcuml_block &block, const uml_test_op &op, int index, bool record)
+{
+	bool dword = (op.size == 8);
+	parameter dst = operand(op.dst);
+	parameter edst = operand(op.edst);
+	parameter src1 = operand(op.src1);
+	parameter src2 = operand(op.src2);
+
+	if (op.carry)
+	{
+		instruction &inst = block.append();
+		if (dword) inst.dcarry(src2, op.shift); else inst.carry(src2, op.shift);
+		m_listing.emplace_back(index, inst);
+	}
+	if (op.compare)
+	{
+		instruction &inst = block.append();
+		if (dword) inst.dcmp(src1, src2); else inst.cmp(src1, src2);
+		m_listing.emplace_back(index, inst);
+		if (record)
+			block.append().getflgs(mem(&m_state->flags[index]), inst.output_flags());
+	}
+
+	instruction &inst = block.append();
+	switch (op.opcode)
+	{
+		case OP_MOV:
+			if (op.compare)
+				{ if (dword) inst.dmov(op.cond, dst, src1); else inst.mov(op.cond, dst, src1); }
+			else
+				{ if (dword) inst.dmov(dst, src1); else inst.mov(dst, src1); }
+			break;
+		case OP_SET:    if (dword) inst.dset(op.cond, dst); else inst.set(op.cond, dst); break;
+		case OP_SEXT:   if (dword) inst.dsext(dst, src1, op.memsize); else inst.sext(dst, src1, op.memsize); break;
+		case OP_ROLAND: if (dword) inst.droland(dst, src1, op.shift, op.mask); else inst.roland(dst, src1, op.shift, op.mask); break;
+		case OP_ROLINS: if (dword) inst.drolins(dst, src1, op.shift, op.mask); else inst.rolins(dst, src1, op.shift, op.mask); break;
+		case OP_ADD:    if (dword) inst.dadd(dst, src1, src2); else inst.add(dst, src1, src2); break;
+		case OP_ADDC:   if (dword) inst.daddc(dst, src1, src2); else inst.addc(dst, src1, src2); break;
+		case OP_SUB:    if (dword) inst.dsub(dst, src1, src2); else inst.sub(dst, src1, src2); break;
+		case OP_SUBB:   if (dword) inst.dsubb(dst, src1, src2); else inst.subb(dst, src1, src2); break;
+		case OP_CMP:    if (dword) inst.dcmp(src1, src2); else inst.cmp(src1, src2); break;
+		case OP_MULU:   if (dword) inst.dmulu(dst, edst, src1, src2); else inst.mulu(dst, edst, src1, src2); break;
+		case OP_MULS:   if (dword) inst.dmuls(dst, edst, src1, src2); else inst.muls(dst, edst, src1, src2); break;
+		case OP_DIVU:   if (dword) inst.ddivu(dst, edst, src1, src2); else inst.divu(dst, edst, src1, src2); break;
+		case OP_DIVS:   if (dword) inst.ddivs(dst, edst, src1, src2); else inst.divs(dst, edst, src1, src2); break;
+		case OP_AND:    if (dword) inst.dand(dst, src1, src2); else inst._and(dst, src1, src2); break;
+		case OP_TEST:   if (dword) inst.dtest(src1, src2); else inst.test(src1, src2); break;
+		case OP_OR:     if (dword) inst.dor(dst, src1, src2); else inst._or(dst, src1, src2); break;
+		case OP_XOR:    if (dword) inst.dxor(dst, src1, src2); else inst._xor(dst, src1, src2); break;
+		case OP_LZCNT:  if (dword) inst.dlzcnt(dst, src1); else inst.lzcnt(dst, src1); break;
+		case OP_BSWAP:  if (dword) inst.dbswap(dst, src1); else inst.bswap(dst, src1); break;
+		case OP_SHL:    if (dword) inst.dshl(dst, src1, src2); else inst.shl(dst, src1, src2); break;
+		case OP_SHR:    if (dword) inst.dshr(dst, src1, src2); else inst.shr(dst, src1, src2); break;
+		case OP_SAR:    if (dword) inst.dsar(dst, src1, src2); else inst.sar(dst, src1, src2); break;
+		case OP_ROL:    if (dword) inst.drol(dst, src1, src2); else inst.rol(dst, src1, src2); break;
+		case OP_ROLC:   if (dword) inst.drolc(dst, src1, src2); else inst.rolc(dst, src1, src2); break;
+		case OP_ROR:    if (dword) inst.dror(dst, src1, src2); else inst.ror(dst, src1, src2); break;
+		case OP_RORC:   if (dword) inst.drorc(dst, src1, src2); else inst.rorc(dst, src1, src2); break;
+
+		case OP_LOAD:
+			if (dword) inst.dload(dst, m_state->mem, src1, op.memsize); else inst.load(dst, m_state->mem, src1, op.memsize);
+			break;
+		case OP_LOADS:
+			if (dword) inst.dloads(dst, m_state->mem, src1, op.memsize); else inst.loads(dst, m_state->mem, src1, op.memsize);
+			break;
+		case OP_STORE:
+			if (dword) inst.dstore(m_state->mem, src1, src2, op.memsize); else inst.store(m_state->mem, src1, src2, op.memsize);
+			break;
+
+		// float operations always work on double registers
+		case OP_FMOV:   inst.fdmov(freg(op.dst.value), freg(op.src1.value)); break;
+		case OP_FADD:   inst.fdadd(freg(op.dst.value), freg(op.src1.value), freg(op.src2.value)); break;
+		case OP_FSUB:   inst.fdsub(freg(op.dst.value), freg(op.src1.value), freg(op.src2.value)); break;
+		case OP_FMUL:   inst.fdmul(freg(op.dst.value), freg(op.src1.value), freg(op.src2.value)); break;
+		case OP_FCMP:   inst.fdcmp(freg(op.src1.value), freg(op.src2.value)); break;
+
+		default:
+			fatalerror("testuml: unexpected opcode %d\n", op.opcode);
+	}
+
+	m_listing.emplace_back(index, inst);
+
+	if (record && !op.compare && inst.output_flags() != 0)
+		block.append().getflgs(mem(&m_state->flags[index]), inst.output_flags());
+}
+
+
+
+//**************************************************************************
+//  PROGRAM GENERATION
+//**************************************************************************
+
+class uml_test_generator
+{
+public:
+	uml_test_generator(UINT64 seed) : m_random(seed) { reset(); }
+
+	void reset() { for (auto &width : m_width) width = 8; }
+	void randomize_state(uml_test_state &state);
+	uml_test_op generate(int opclass);
+
+	// the low 32 bits are all that is defined after a 32-bit write
+	UINT64 register_mask(int regnum) const { return (m_width[regnum] == 8) ? ~UINT64(0) : 0xffffffff; }
+
+private:
+	UINT64 immediate(int size);
+	uml_test_operand source(int size, bool allowimm = true);
+	uml_test_operand destination(int size, bool allowmem = true);
+	uml_test_operand reg(int regnum) { uml_test_operand result = { uml_test_operand::REG, UINT64(regnum) }; return result; }
+	uml_test_operand imm(UINT64 value) { uml_test_operand result = { uml_test_operand::IMM, value }; return result; }
+
+	uml_test_random     m_random;
+	UINT8               m_width[TEST_IREGS];    // width of the last write to each register
+};
+
+
+//-------------------------------------------------
+//  randomize_state - pick starting values
+//-------------------------------------------------
+
+void uml_test_generator::randomize_state(uml_test_state &state)
+{
+	memset(&state, 0, sizeof(state));
+	for (auto &value : state.r)
+		value = immediate(8);
+	for (auto &value : state.mem)
+		value = immediate(8);
+
+	// keep float inputs finite and in a sensible range
+	for (auto &value : state.f)
+	{
+		double d = double(INT32(m_random.next())) / double(1 + m_random.range(1000));
+		memcpy(&value, &d, sizeof(value));
+	}
+}
+
+
+//-------------------------------------------------
+//  immediate - pick a value, biased towards the
+//  edge cases that tend to break code generators
+//-------------------------------------------------
+
+UINT64 uml_test_generator::immediate(int size)
+{
+	static const UINT64 specials[] =
+	{
+		0, 1, 2, 0x7f, 0x80, 0xff, 0x7fff, 0x8000, 0xffff, 0x7fffffff, 0x80000000, 0xffffffff,
+		U64(0x7fffffffffffffff), U64(0x8000000000000000), U64(0xffffffffffffffff)
+	};
+	UINT64 value = (m_random.range(4) == 0) ? specials[m_random.range(ARRAY_LENGTH(specials))] : m_random.next();
+	return (size == 4) ? (value & 0xffffffff) : value;
+}
+
+
+//-------------------------------------------------
+//  source - pick a source operand; 64-bit
+//  operations only read registers that hold a
+//  defined 64-bit value
+//-------------------------------------------------
+
+uml_test_operand uml_test_generator::source(int size, bool allowimm)
+{
+	for (int tries = 0; tries < 8; tries++)
+	{
+		int choice = m_random.range(8);
+		if (choice == 0 && allowimm)
+			return imm(immediate(size));
+		if (choice == 1)
+		{
+			uml_test_operand result = { uml_test_operand::MEM, m_random.range(TEST_MEMORY_QWORDS) };
+			return result;
+		}
+		int regnum = m_random.range(TEST_IREGS);
+		if (size == 4 || m_width[regnum] == 8)
+			return reg(regnum);
+	}
+	uml_test_operand result = { uml_test_operand::MEM, m_random.range(TEST_MEMORY_QWORDS) };
+	return result;
+}
+
+
+//-------------------------------------------------
+//  destination - pick a destination operand and
+//  track the width written to registers
+//-------------------------------------------------
+
+uml_test_operand uml_test_generator::destination(int size, bool allowmem)
+{
+	if (allowmem && m_random.range(8) == 0)
+	{
+		uml_test_operand result = { uml_test_operand::MEM, m_random.range(TEST_MEMORY_QWORDS) };
+		return result;
+	}
+	int regnum = m_random.range(TEST_IREGS);
+	m_width[regnum] = size;
+	return reg(regnum);
+}
+
+
+//-------------------------------------------------
+//  generate - generate a random operation of the
+//  given class
+//-------------------------------------------------
+
+uml_test_op uml_test_generator::generate(int opclass)
+{
+	static const opcode_t arith_ops[] = { OP_ADD, OP_ADDC, OP_SUB, OP_SUBB, OP_CMP };
+	static const opcode_t logic_ops[] = { OP_AND, OP_OR, OP_XOR, OP_TEST };
+	static const opcode_t shift_ops[] = { OP_SHL, OP_SHR, OP_SAR, OP_ROL, OP_ROR, OP_ROLC, OP_RORC };
+	static const opcode_t muldiv_ops[] = { OP_MULU, OP_MULS, OP_DIVU, OP_DIVS };
+	static const opcode_t bits_ops[] = { OP_LZCNT, OP_BSWAP, OP_ROLAND, OP_ROLINS };
+	static const opcode_t memory_ops[] = { OP_LOAD, OP_LOADS, OP_STORE };
+	static const opcode_t float_ops[] = { OP_FMOV, OP_FADD, OP_FSUB, OP_FMUL, OP_FCMP };
+	static const condition_t conditions[] = { COND_Z, COND_NZ, COND_S, COND_NS, COND_C, COND_NC, COND_V, COND_NV, COND_A, COND_BE, COND_G, COND_LE, COND_L, COND_GE };
+
+	uml_test_op op;
+	memset(&op, 0, sizeof(op));
+	op.size = m_random.range(2) ? 8 : 4;
+	int bits = op.size * 8;
+
+	switch (opclass)
+	{
+		case CLASS_MOVE:
+			if (m_random.range(2))
+			{
+				op.opcode = OP_MOV;
+				op.src1 = source(op.size);
+			}
+			else
+			{
+				op.opcode = OP_SEXT;
+				op.memsize = operand_size(m_random.range(op.size == 8 ? 3 : 2));
+				op.src1 = source(op.size);
+			}
+			op.dst = destination(op.size);
+			break;
+
+		case CLASS_ARITH:
+			op.opcode = arith_ops[m_random.range(ARRAY_LENGTH(arith_ops))];
+			op.src1 = source(op.size);
+			op.src2 = source(op.size);
+			if (op.opcode == OP_ADDC || op.opcode == OP_SUBB)
+			{
+				op.carry = true;
+				op.shift = m_random.range(bits);
+			}
+			if (op.opcode != OP_CMP)
+				op.dst = destination(op.size);
+			break;
+
+		case CLASS_LOGIC:
+			op.opcode = logic_ops[m_random.range(ARRAY_LENGTH(logic_ops))];
+			op.src1 = source(op.size);
+			op.src2 = source(op.size);
+			if (op.opcode != OP_TEST)
+				op.dst = destination(op.size);
+			break;
+
+		case CLASS_SHIFT:
+			op.opcode = shift_ops[m_random.range(ARRAY_LENGTH(shift_ops))];
+			op.src1 = source(op.size, false);
+			op.src2 = imm(1 + m_random.range(bits - 1));
+			if (op.opcode == OP_ROLC || op.opcode == OP_RORC)
+			{
+				op.carry = true;
+				op.shift = m_random.range(bits);
+			}
+			op.dst = destination(op.size);
+			break;
+
+		case CLASS_MULDIV:
+			op.opcode = muldiv_ops[m_random.range(ARRAY_LENGTH(muldiv_ops))];
+			op.src1 = source(op.size);
+			if (op.opcode == OP_DIVU || op.opcode == OP_DIVS)
+			{
+				// a constant divisor avoids the divide-by-zero and INT_MIN / -1 cases, which are undefined in UML
+				UINT64 divisor;
+				do
+					divisor = immediate(op.size);
+				while (divisor == 0 || divisor == ((op.size == 4) ? 0xffffffff : ~UINT64(0)));
+				op.src2 = imm(divisor);
+			}
+			else
+				op.src2 = source(op.size);
+			op.dst = destination(op.size, false);
+			do
+				op.edst = destination(op.size, false);
+			while (op.edst.value == op.dst.value);
+			break;
+
+		case CLASS_BITS:
+			op.opcode = bits_ops[m_random.range(ARRAY_LENGTH(bits_ops))];
+			op.src1 = source(op.size);
+			op.shift = m_random.range(bits);
+			op.mask = immediate(4);
+			if (op.opcode == OP_ROLINS)
+			{
+				// rolins reads its destination, so only write registers that are defined at this width
+				op.dst = source(op.size, false);
+				if (op.dst.kind == uml_test_operand::REG)
+					m_width[op.dst.value] = op.size;
+			}
+			else
+				op.dst = destination(op.size);
+			break;
+
+		case CLASS_MEMORY:
+		{
+			op.opcode = memory_ops[m_random.range(ARRAY_LENGTH(memory_ops))];
+			op.memsize = operand_size(m_random.range((op.opcode == OP_LOADS || op.size == 4) ? 3 : 4));
+			op.src1 = imm(m_random.range(TEST_MEMORY_QWORDS * 8 >> op.memsize));
+			if (op.opcode == OP_STORE)
+				op.src2 = source(op.size);
+			else
+				op.dst = destination(op.size, false);
+			break;
+		}
+
+		case CLASS_COND:
+			op.compare = true;
+			op.cond = conditions[m_random.range(ARRAY_LENGTH(conditions))];
+			op.src1 = source(op.size);
+			op.src2 = source(op.size);
+			if (m_random.range(2))
+			{
+				op.opcode = OP_SET;
+				op.dst = destination(op.size);
+			}
+			else
+			{
+				// a conditional move may leave the destination alone, so it must already be defined
+				op.opcode = OP_MOV;
+				op.dst = source(op.size, false);
+				if (op.dst.kind == uml_test_operand::REG)
+					m_width[op.dst.value] = op.size;
+			}
+			break;
+
+		case CLASS_FLOAT:
+			op.size = 8;
+			op.opcode = float_ops[m_random.range(ARRAY_LENGTH(float_ops))];
+			op.dst.value = m_random.range(TEST_FREGS);
+			op.src1.value = m_random.range(TEST_FREGS);
+			op.src2.value = m_random.range(TEST_FREGS);
+			break;
+	}
+	return op;
+}
+
+
+
+//**************************************************************************
+//  DRIVER STATE
+//**************************************************************************
+
+class testuml_state : public driver_device
+{
+public:
+	// constructor
+	testuml_state(const machine_config &mconfig, device_type type, const char *tag)
+		: driver_device(mconfig, type, tag)
+	{
+	}
+
+	// timer callback; used to wrest control of the system
+	virtual void device_timer(emu_timer &timer, device_timer_id id, int param, void *ptr) override
+	{
+		uml_test_backend cbe(*this, DRCUML_OPTION_USE_C);
+		uml_test_backend native(*this, DRCUML_OPTION_USE_NATIVE);
+
+		// differential pass
+		int failures = 0;
+		for (int seed = 0; seed < TEST_PROGRAMS; seed++)
+		{
+			uml_test_generator generator(seed);
+			std::vector<uml_test_op> ops;
+			uml_test_state initial;
+
+			generator.randomize_state(initial);
+			for (int opnum = 0; opnum < TEST_OPS; opnum++)
+				ops.push_back(generator.generate(generator_class(seed, opnum)));
+
+			cbe.build(ops, 0);
+			native.build(ops, 0);
+			cbe.state() = initial;
+			native.state() = initial;
+			cbe.execute();
+			native.execute();
+
+			if (!compare(generator, seed, cbe, native, ops))
+				failures++;
+		}
+		printf("%d of %d programs matched\n", TEST_PROGRAMS - failures, TEST_PROGRAMS);
+
+		// benchmark pass
+		printf("\n%-8s %14s %14s %8s\n", "class", "C (Mops/s)", "native", "ratio");
+		for (int opclass = 0; opclass < CLASS_COUNT; opclass++)
+		{
+			uml_test_generator generator(opclass + 0x10000);
+			std::vector<uml_test_op> ops;
+			uml_test_state initial;
+
+			generator.randomize_state(initial);
+			for (int opnum = 0; opnum < TEST_BENCH_OPS; opnum++)
+				ops.push_back(generator.generate(opclass));
+
+			double crate = benchmark(cbe, ops, initial);
+			double nativerate = benchmark(native, ops, initial);
+			printf("%-8s %14.2f %14.2f %7.2fx\n", s_class_names[opclass], crate, nativerate, nativerate / crate);
+		}
+
+		// all done; just bail
+		throw emu_fatalerror(0, "All done");
+	}
+
+	// startup code; set a timer to go off right away
+	virtual void machine_start() override
+	{
+		timer_set(attotime::zero);
+	}
+
+private:
+	// mostly mixed programs, with some concentrating on a single class
+	static int generator_class(int seed, int opnum)
+	{
+		if (seed % 4 == 0)
+			return (seed / 4) % CLASS_COUNT;
+		return (seed * 7 + opnum * 13) % CLASS_COUNT;
+	}
+
+	// compare the outcome of both back-ends and dump the program if they differ
+	bool compare(const uml_test_generator &generator, int seed, uml_test_backend &cbe, uml_test_backend &native, const std::vector<uml_test_op> &ops)
+	{
+		const uml_test_state &a = cbe.state();
+		const uml_test_state &b = native.state();
+		bool matched = true;
+
+		for (int regnum = 0; regnum < TEST_IREGS; regnum++)
+			if ((a.r[regnum] ^ b.r[regnum]) & generator.register_mask(regnum))
+			{
+				printf("seed %d: I%d C=%016llX native=%016llX\n", seed, regnum, (unsigned long long)a.r[regnum], (unsigned long long)b.r[regnum]);
+				matched = false;
+			}
+		for (int regnum = 0; regnum < TEST_FREGS; regnum++)
+			if (a.f[regnum] != b.f[regnum])
+			{
+				printf("seed %d: F%d C=%016llX native=%016llX\n", seed, regnum, (unsigned long long)a.f[regnum], (unsigned long long)b.f[regnum]);
+				matched = false;
+			}
+		for (int index = 0; index < TEST_MEMORY_QWORDS; index++)
+			if (a.mem[index] != b.mem[index])
+			{
+				printf("seed %d: mem[%d] C=%016llX native=%016llX\n", seed, index, (unsigned long long)a.mem[index], (unsigned long long)b.mem[index]);
+				matched = false;
+			}
+		for (int opnum = 0; opnum < TEST_OPS; opnum++)
+			if (a.flags[opnum] != b.flags[opnum])
+			{
+				printf("seed %d: flags after op %d C=%02X native=%02X\n", seed, opnum, a.flags[opnum], b.flags[opnum]);
+				matched = false;
+			}
+
+		if (!matched)
+		{
+			printf("seed %d program:\n", seed);
+			for (int opnum = 0; opnum < ops.size(); opnum++)
+				cbe.dump_listing(opnum);
+		}
+		return matched;
+	}
+
+	// time a program on one back-end, returning millions of operations per second
+	double benchmark(uml_test_backend &backend, const std::vector<uml_test_op> &ops, const uml_test_state &initial)
+	{
+		backend.build(ops, TEST_BENCH_ITERATIONS);
+		backend.state() = initial;
+		osd_ticks_t start = osd_ticks();
+		backend.execute();
+		osd_ticks_t elapsed = osd_ticks() - start;
+		double seconds = double(elapsed) / double(osd_ticks_per_second());
+		return double(ops.size()) * double(TEST_BENCH_ITERATIONS) / (seconds * 1e6);
+	}
+};
+
+
+
+//**************************************************************************
+//  MACHINE DRIVERS
+//**************************************************************************
+
+static MACHINE_CONFIG_START( testuml, testuml_state )
+MACHINE_CONFIG_END
+
+
+
+//**************************************************************************
+//  ROM DEFINITIONS
+//**************************************************************************
+
+ROM_START( testuml )
+	ROM_REGION( 0x10, "user1", ROMREGION_ERASEFF )
+ROM_END
+
+
+
+//**************************************************************************
+//  GAME DRIVERS
+//**************************************************************************
+
+GAME( 2016, testuml, 0, testuml, 0, driver_device, 0, ROT0, "MAME", "UML Back-end Tester", MACHINE_NO_SOUND )
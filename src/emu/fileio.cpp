@@ -907,3 +907,67 @@ file_error emu_file::load__7zped_file()
 	m__7zfile = nullptr;
 	return FILERR_NONE;
 }
+
+
+//-------------------------------------------------
+//  load_deferred_7z - load the deferred _7Zped
+//  members of several files, decoding each solid
+//  block they share only once; members that fail
+//  are left to be loaded on their own
+//-------------------------------------------------
+
+void emu_file::load_deferred_7z(const std::vector<emu_file *> &files)
+{
+	std::vector<bool> claimed(files.size(), false);
+	std::vector<emu_file *> decoders;
+	for (size_t first = 0; first < files.size(); first++)
+	{
+		if (claimed[first] || !files[first]->deferred_7z())
+			continue;
+
+		// every file has its own handle on the archive; the first one decodes for all of them
+		_7z_file *archive = files[first]->m__7zfile;
+		std::vector<emu_file *> members;
+		std::vector<_7z_request> requests;
+		for (size_t filenum = first; filenum < files.size(); filenum++)
+		{
+			emu_file &file = *files[filenum];
+			if (claimed[filenum] || !file.deferred_7z() || file.m__7zlength == 0 || strcmp(file.m__7zfile->filename, archive->filename) != 0)
+				continue;
+			claimed[filenum] = true;
+
+			file.m__7zdata.resize(file.m__7zlength);
+			_7z_request request = { file.m__7zfile->curr_file_idx, &file.m__7zdata[0], UINT32(file.m__7zlength), _7ZERR_NONE };
+			members.push_back(&file);
+			requests.push_back(request);
+		}
+		if (requests.empty())
+			continue;
+		_7z_file_decompress_multiple(archive, &requests[0], requests.size());
+
+		// convert to RAM files and close out the _7Z files; the handle holding the
+		// decoded blocks is closed last so the others can't push it out of the cache
+		for (size_t memnum = 0; memnum < members.size(); memnum++)
+		{
+			emu_file &file = *members[memnum];
+			if (requests[memnum].error != _7ZERR_NONE || util::core_file::open_ram(&file.m__7zdata[0], file.m__7zdata.size(), file.m_openflags, file.m_file) != FILERR_NONE)
+			{
+				file.m__7zdata.clear();
+				continue;
+			}
+			if (file.m__7zfile == archive)
+			{
+				decoders.push_back(&file);
+				continue;
+			}
+			_7z_file_close(file.m__7zfile);
+			file.m__7zfile = nullptr;
+		}
+	}
+
+	for (emu_file *file : decoders)
+	{
+		_7z_file_close(file->m__7zfile);
+		file->m__7zfile = nullptr;
+	}
+}
@@ -96,6 +96,7 @@ public:
 	const char *fullpath() const { return m_fullpath.c_str(); }
 	UINT32 openflags() const { return m_openflags; }
 	hash_collection &hashes(const char *types);
+	bool deferred_7z() const { return m__7zfile != nullptr; }  // 7-Zip member opened with OPEN_FLAG_NO_PRELOAD and not read yet
 	bool restrict_to_mediapath() { return m_restrict_to_mediapath; }
 	bool part_of_mediapath(std::string path);
 
@@ -141,6 +142,9 @@ public:
 	// buffers
 	void flush();
 
+	// decompress the deferred 7-Zip members of several files at once
+	static void load_deferred_7z(const std::vector<emu_file *> &files);
+
 private:
 	bool compressed_file_ready(void);
 
@@ -18,10 +18,40 @@
 #include "softlist.h"
 
 #include <ctype.h>
+#include <unordered_map>
 
 #define XML_ROOT                "mame"
 #define XML_TOP                 "machine"
 
+// drivers described per batch before their output is written
+#define INFO_BATCH_SIZE         256
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// a creator of our own for each worker thread
+struct info_xml_creator::worker
+{
+	worker(emu_options &options) : m_drivlist(options), m_creator(m_drivlist) { }
+
+	driver_enumerator   m_drivlist;
+	info_xml_creator    m_creator;
+};
+
+
+// drivers described together on one thread
+struct info_xml_creator::job
+{
+	info_xml_creator *          m_owner;
+	std::vector<int>            m_drivers;      // drivers to describe, in output order
+	std::vector<std::string>    m_output;       // XML for each machine or device
+	std::vector<std::string>    m_shortnames;   // device pass only: short name of each device
+	std::vector<index_entry>    m_index;        // binary index entry for each machine or device
+};
+
+
 //**************************************************************************
 //  GLOBAL VARIABLES
 //**************************************************************************
@@ -178,33 +208,49 @@ const char info_xml_creator::s_dtd_string[] =
 //-------------------------------------------------
 
 info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
-	: m_output(nullptr),
-		m_drivlist(drivlist),
-		m_lookup_options(m_drivlist.options())
+	: m_drivlist(drivlist),
+		m_lookup_options(m_drivlist.options()),
+		m_indexing(false),
+		m_offset(0),
+		m_indexcount(0)
 {
 	m_lookup_options.remove_device_options();
 }
 
 
+//-------------------------------------------------
+//  ~info_xml_creator - destructor
+//-------------------------------------------------
+
+info_xml_creator::~info_xml_creator()
+{
+}
+
+
 //-------------------------------------------------
 //  output_mame_xml - print the XML information
 //  for all known games
 //-------------------------------------------------
 
-void info_xml_creator::output(FILE *out, bool nodevices)
+void info_xml_creator::output(FILE *out, bool nodevices, const char *indexfile)
 {
-	m_output = out;
+	// start an empty index, with offset 0 as the empty string
+	m_indexing = (indexfile != nullptr && indexfile[0] != 0);
+	m_index.clear();
+	m_indexcount = 0;
+	m_strings.assign(1, '\0');
+	m_stringoffs.clear();
 
 	// output the DTD
-	fprintf(m_output, "<?xml version=\"1.0\"?>\n");
+	m_offset = MAX(fprintf(out, "<?xml version=\"1.0\"?>\n"), 0);
 	std::string dtd(s_dtd_string);
 	strreplace(dtd, "__XML_ROOT__", XML_ROOT);
 	strreplace(dtd, "__XML_TOP__", XML_TOP);
 
-	fprintf(m_output, "%s\n\n", dtd.c_str());
+	m_offset += MAX(fprintf(out, "%s\n\n", dtd.c_str()), 0);
 
 	// top-level tag
-	fprintf(m_output, "<%s build=\"%s\" debug=\""
+	m_offset += MAX(fprintf(out, "<%s build=\"%s\" debug=\""
 #ifdef MAME_DEBUG
 		"yes"
 #else
@@ -212,20 +258,71 @@ void info_xml_creator::output(FILE *out, bool nodevices)
 #endif
 		"\" mameconfig=\"%d\">\n",
 		XML_ROOT,
-		xml_normalize_string(build_version),
+		normalize(build_version),
 		CONFIG_VERSION
-	);
+	), 0);
 
-	// iterate through the drivers, outputting one at a time
+	// describe the drivers on all processors
+	std::vector<int> drivers;
 	while (m_drivlist.next())
-		output_one();
+		drivers.push_back(m_drivlist.current());
+
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	output_machines(out, queue, drivers);
 
 	// output devices (both devices with roms and slot devices)
 	if (!nodevices)
-		output_devices();
+		output_devices(out, queue, drivers);
+
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
 
 	// close the top level tag
-	fprintf(m_output, "</%s>\n",XML_ROOT);
+	fprintf(out, "</%s>\n",XML_ROOT);
+
+	if (m_indexing)
+		save_index(indexfile);
+}
+
+
+//-------------------------------------------------
+//  output_machines - print the XML information
+//  for each driver, in the order given
+//-------------------------------------------------
+
+void info_xml_creator::output_machines(FILE *out, osd_work_queue *queue, const std::vector<int> &drivers)
+{
+	for (size_t base = 0; base < drivers.size(); base += INFO_BATCH_SIZE)
+	{
+		size_t count = MIN(INFO_BATCH_SIZE, drivers.size() - base);
+
+		// keep a parent and its clones on one thread, so merge names come from a cached config
+		std::vector<job> jobs;
+		std::unordered_map<int, size_t> family_of;
+		std::vector<std::pair<size_t, size_t>> where(count);
+		for (size_t index = 0; index < count; index++)
+		{
+			int parent = driver_list::non_bios_clone(drivers[base + index]);
+			auto family = family_of.emplace((parent != -1) ? parent : drivers[base + index], jobs.size());
+			if (family.second)
+			{
+				jobs.emplace_back();
+				jobs.back().m_owner = this;
+			}
+			job &cur = jobs[family.first->second];
+			where[index] = std::make_pair(family.first->second, cur.m_drivers.size());
+			cur.m_drivers.push_back(drivers[base + index]);
+		}
+
+		run_jobs(queue, jobs, output_machines_static);
+
+		// write them out in the original order
+		for (size_t index = 0; index < count; index++)
+		{
+			job &cur = jobs[where[index].first];
+			write_xml(out, cur.m_output[where[index].second], &cur.m_index[where[index].second]);
+		}
+	}
 }
 
 
@@ -250,8 +347,10 @@ void info_xml_creator::output_one()
 		portlist.append(*device, errors);
 
 	// print the header and the game name
-	fprintf(m_output, "\t<%s",XML_TOP);
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(driver.name));
+	util::stream_format(m_output, "\t<%s",XML_TOP);
+	util::stream_format(m_output, " name=\"%s\"", normalize(driver.name));
+	m_entry = index_entry();
+	m_entry.m_name = driver.name;
 
 	// strip away any path information from the source_file and output it
 	const char *start = strrchr(driver.source_file, '/');
@@ -259,38 +358,63 @@ void info_xml_creator::output_one()
 		start = strrchr(driver.source_file, '\\');
 	if (start == nullptr)
 		start = driver.source_file - 1;
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(start + 1));
+	util::stream_format(m_output, " sourcefile=\"%s\"", normalize(start + 1));
+	m_entry.m_sourcefile = start + 1;
 
 	// append bios and runnable flags
 	if (driver.flags & MACHINE_IS_BIOS_ROOT)
-		fprintf(m_output, " isbios=\"yes\"");
+	{
+		util::stream_format(m_output, " isbios=\"yes\"");
+		m_entry.m_flags |= INFO_INDEX_FLAG_BIOS;
+	}
 	if (driver.flags & MACHINE_NO_STANDALONE)
-		fprintf(m_output, " runnable=\"no\"");
+	{
+		util::stream_format(m_output, " runnable=\"no\"");
+		m_entry.m_flags |= INFO_INDEX_FLAG_NOT_RUNNABLE;
+	}
 	if (driver.flags & MACHINE_MECHANICAL)
-		fprintf(m_output, " ismechanical=\"yes\"");
+	{
+		util::stream_format(m_output, " ismechanical=\"yes\"");
+		m_entry.m_flags |= INFO_INDEX_FLAG_MECHANICAL;
+	}
 
 	// display clone information
 	int clone_of = m_drivlist.find(driver.parent);
 	if (clone_of != -1 && !(m_drivlist.driver(clone_of).flags & MACHINE_IS_BIOS_ROOT))
-		fprintf(m_output, " cloneof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+	{
+		util::stream_format(m_output, " cloneof=\"%s\"", normalize(m_drivlist.driver(clone_of).name));
+		m_entry.m_cloneof = m_drivlist.driver(clone_of).name;
+	}
 	if (clone_of != -1)
-		fprintf(m_output, " romof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+	{
+		util::stream_format(m_output, " romof=\"%s\"", normalize(m_drivlist.driver(clone_of).name));
+		m_entry.m_romof = m_drivlist.driver(clone_of).name;
+	}
 
 	// display sample information and close the game tag
 	output_sampleof();
-	fprintf(m_output, ">\n");
+	util::stream_format(m_output, ">\n");
 
 	// output game description
 	if (driver.description != nullptr)
-		fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(driver.description));
+	{
+		util::stream_format(m_output, "\t\t<description>%s</description>\n", normalize(driver.description));
+		m_entry.m_description = driver.description;
+	}
 
 	// print the year only if is a number or another allowed character (? or +)
 	if (driver.year != nullptr && strspn(driver.year, "0123456789?+") == strlen(driver.year))
-		fprintf(m_output, "\t\t<year>%s</year>\n", xml_normalize_string(driver.year));
+	{
+		util::stream_format(m_output, "\t\t<year>%s</year>\n", normalize(driver.year));
+		m_entry.m_year = driver.year;
+	}
 
 	// print the manufacturer information
 	if (driver.manufacturer != nullptr)
-		fprintf(m_output, "\t\t<manufacturer>%s</manufacturer>\n", xml_normalize_string(driver.manufacturer));
+	{
+		util::stream_format(m_output, "\t\t<manufacturer>%s</manufacturer>\n", normalize(driver.manufacturer));
+		m_entry.m_manufacturer = driver.manufacturer;
+	}
 
 	// now print various additional information
 	output_bios();
@@ -312,7 +436,7 @@ void info_xml_creator::output_one()
 	output_ramoptions();
 
 	// close the topmost tag
-	fprintf(m_output, "\t</%s>\n",XML_TOP);
+	util::stream_format(m_output, "\t</%s>\n",XML_TOP);
 }
 
 
@@ -344,16 +468,22 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 			}
 
 	// start to output info
-	fprintf(m_output, "\t<%s", XML_TOP);
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(device.shortname()));
+	util::stream_format(m_output, "\t<%s", XML_TOP);
+	util::stream_format(m_output, " name=\"%s\"", normalize(device.shortname()));
 	std::string src(device.source());
 	strreplace(src,"../", "");
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(src.c_str()));
-	fprintf(m_output, " isdevice=\"yes\"");
-	fprintf(m_output, " runnable=\"no\"");
+	util::stream_format(m_output, " sourcefile=\"%s\"", normalize(src.c_str()));
+	util::stream_format(m_output, " isdevice=\"yes\"");
+	util::stream_format(m_output, " runnable=\"no\"");
 	output_sampleof();
-	fprintf(m_output, ">\n");
-	fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(device.name()));
+	util::stream_format(m_output, ">\n");
+	util::stream_format(m_output, "\t\t<description>%s</description>\n", normalize(device.name()));
+
+	m_entry = index_entry();
+	m_entry.m_name = device.shortname();
+	m_entry.m_sourcefile = src;
+	m_entry.m_description = device.name();
+	m_entry.m_flags = INFO_INDEX_FLAG_DEVICE | INFO_INDEX_FLAG_NOT_RUNNABLE;
 
 	output_rom(device);
 
@@ -371,7 +501,7 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 	output_adjusters(portlist);
 	output_images(device, devtag);
 	output_slots(device, devtag);
-	fprintf(m_output, "\t</%s>\n", XML_TOP);
+	util::stream_format(m_output, "\t</%s>\n", XML_TOP);
 }
 
 
@@ -387,61 +517,260 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 //  directly to a driver as device or sub-device)
 //-------------------------------------------------
 
-void info_xml_creator::output_devices()
+void info_xml_creator::output_devices(FILE *out, osd_work_queue *queue, const std::vector<int> &drivers)
 {
-	m_drivlist.reset();
-	std::unordered_set<std::string> shortnames;
+	m_shortnames.clear();
 
-	while (m_drivlist.next())
+	for (size_t base = 0; base < drivers.size(); base += INFO_BATCH_SIZE)
 	{
-		// first, run through devices with roms which belongs to the default configuration
-		device_iterator deviter(m_drivlist.config().root_device());
-		for (device_t *device = deviter.first(); device != nullptr; device = deviter.next())
+		size_t count = MIN(INFO_BATCH_SIZE, drivers.size() - base);
+		std::vector<job> jobs(count);
+		for (size_t index = 0; index < count; index++)
 		{
-			if (device->owner() != nullptr && device->shortname()!= nullptr && device->shortname()[0]!='\0')
-			{
-				if (shortnames.insert(device->shortname()).second)
-					output_one_device(*device, device->tag());
-			}
+			jobs[index].m_owner = this;
+			jobs[index].m_drivers.push_back(drivers[base + index]);
 		}
 
-		// then, run through slot devices
-		slot_interface_iterator iter(m_drivlist.config().root_device());
-		for (const device_slot_interface *slot = iter.first(); slot != nullptr; slot = iter.next())
+		// m_shortnames only changes between batches, so the workers may read it
+		run_jobs(queue, jobs, output_devices_static);
+
+		// the first driver to use a device gets to describe it
+		for (job &cur : jobs)
+			for (size_t index = 0; index < cur.m_output.size(); index++)
+				if (m_shortnames.insert(cur.m_shortnames[index]).second)
+					write_xml(out, cur.m_output[index], &cur.m_index[index]);
+	}
+}
+
+
+//-------------------------------------------------
+//  output_current_devices - describe the devices
+//  of the current driver that have not been
+//  written yet
+//-------------------------------------------------
+
+void info_xml_creator::output_current_devices(job &cur)
+{
+	const std::unordered_set<std::string> &written = cur.m_owner->m_shortnames;
+	std::unordered_set<std::string> shortnames;
+	auto output_device = [&](device_t &device, const char *devtag)
+	{
+		if (written.find(device.shortname()) == written.end() && shortnames.insert(device.shortname()).second)
 		{
-			for (const device_slot_option *option = slot->first_option(); option != nullptr; option = option->next())
-			{
-				std::string temptag("_");
-				temptag.append(option->name());
-				device_t *dev = const_cast<machine_config &>(m_drivlist.config()).device_add(&m_drivlist.config().root_device(), temptag.c_str(), option->devtype(), 0);
-
-				// notify this device and all its subdevices that they are now configured
-				device_iterator subiter(*dev);
-				for (device_t *device = subiter.first(); device != nullptr; device = subiter.next())
-					if (!device->configured())
-						device->config_complete();
-
-				if (shortnames.insert(dev->shortname()).second)
-					output_one_device(*dev, temptag.c_str());
-
-				// also, check for subdevices with ROMs (a few devices are missed otherwise, e.g. MPU401)
-				device_iterator deviter2(*dev);
-				for (device_t *device = deviter2.first(); device != nullptr; device = deviter2.next())
-				{
-					if (device->owner() == dev && device->shortname()!= nullptr && device->shortname()[0]!='\0')
-					{
-						if (shortnames.insert(device->shortname()).second)
-							output_one_device(*device, device->tag());
-					}
-				}
+			m_output.str("");
+			output_one_device(device, devtag);
+			cur.m_output.push_back(m_output.str());
+			cur.m_shortnames.push_back(device.shortname());
+			cur.m_index.push_back(m_entry);
+		}
+	};
+
+	// first, run through devices with roms which belongs to the default configuration
+	device_iterator deviter(m_drivlist.config().root_device());
+	for (device_t *device = deviter.first(); device != nullptr; device = deviter.next())
+	{
+		if (device->owner() != nullptr && device->shortname()!= nullptr && device->shortname()[0]!='\0')
+			output_device(*device, device->tag());
+	}
 
-				const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), temptag.c_str());
+	// then, run through slot devices
+	slot_interface_iterator iter(m_drivlist.config().root_device());
+	for (const device_slot_interface *slot = iter.first(); slot != nullptr; slot = iter.next())
+	{
+		for (const device_slot_option *option = slot->first_option(); option != nullptr; option = option->next())
+		{
+			std::string temptag("_");
+			temptag.append(option->name());
+			device_t *dev = const_cast<machine_config &>(m_drivlist.config()).device_add(&m_drivlist.config().root_device(), temptag.c_str(), option->devtype(), 0);
+
+			// notify this device and all its subdevices that they are now configured
+			device_iterator subiter(*dev);
+			for (device_t *device = subiter.first(); device != nullptr; device = subiter.next())
+				if (!device->configured())
+					device->config_complete();
+
+			output_device(*dev, temptag.c_str());
+
+			// also, check for subdevices with ROMs (a few devices are missed otherwise, e.g. MPU401)
+			device_iterator deviter2(*dev);
+			for (device_t *device = deviter2.first(); device != nullptr; device = deviter2.next())
+			{
+				if (device->owner() == dev && device->shortname()!= nullptr && device->shortname()[0]!='\0')
+					output_device(*device, device->tag());
 			}
+
+			const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), temptag.c_str());
 		}
 	}
 }
 
 
+//-------------------------------------------------
+//  run_jobs - run a callback for each job on all
+//  processors and wait for them to finish
+//-------------------------------------------------
+
+void info_xml_creator::run_jobs(osd_work_queue *queue, std::vector<job> &jobs, osd_work_callback callback)
+{
+	if (queue != nullptr && jobs.size() > 1)
+	{
+		osd_work_item_queue_multiple(queue, callback, jobs.size(), &jobs[0], sizeof(jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+	}
+	else
+	{
+		for (job &cur : jobs)
+			(*callback)(&cur, 0);
+	}
+}
+
+
+//-------------------------------------------------
+//  thread_creator - return the creator used by
+//  the given worker thread
+//-------------------------------------------------
+
+info_xml_creator &info_xml_creator::thread_creator(int threadid)
+{
+	// each thread only ever touches its own slot
+	std::unique_ptr<worker> &state = m_worker[threadid];
+	if (!state)
+		state = std::make_unique<worker>(m_drivlist.options());
+	return state->m_creator;
+}
+
+
+//-------------------------------------------------
+//  output_machines_static - describe the drivers
+//  of one job
+//-------------------------------------------------
+
+void *info_xml_creator::output_machines_static(void *param, int threadid)
+{
+	job &cur = *reinterpret_cast<job *>(param);
+	info_xml_creator &creator = cur.m_owner->thread_creator(threadid);
+	for (int driver : cur.m_drivers)
+	{
+		creator.m_drivlist.set_current(driver);
+		creator.m_output.str("");
+		creator.output_one();
+		cur.m_output.push_back(creator.m_output.str());
+		cur.m_index.push_back(creator.m_entry);
+	}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  output_devices_static - describe the devices
+//  of the driver of one job
+//-------------------------------------------------
+
+void *info_xml_creator::output_devices_static(void *param, int threadid)
+{
+	job &cur = *reinterpret_cast<job *>(param);
+	info_xml_creator &creator = cur.m_owner->thread_creator(threadid);
+	for (int driver : cur.m_drivers)
+	{
+		creator.m_drivlist.set_current(driver);
+		creator.output_current_devices(cur);
+	}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  put_le - append a little-endian value to a
+//  binary index buffer
+//-------------------------------------------------
+
+static void put_le(std::vector<UINT8> &buffer, UINT64 value, int bytes)
+{
+	for (int byte = 0; byte < bytes; byte++)
+		buffer.push_back(UINT8(value >> (8 * byte)));
+}
+
+
+//-------------------------------------------------
+//  write_xml - write the XML for one machine,
+//  adding it to the binary index if requested
+//-------------------------------------------------
+
+void info_xml_creator::write_xml(FILE *out, const std::string &xml, const index_entry *entry)
+{
+	// positions come from the file where possible, as text mode may change line endings
+	bool indexed = (m_indexing && entry != nullptr && !xml.empty());
+	long start = indexed ? ftell(out) : -1;
+	fwrite(xml.data(), 1, xml.length(), out);
+	long end = indexed ? ftell(out) : -1;
+	UINT64 offset = m_offset;
+	UINT64 length = xml.length();
+	m_offset += xml.length();
+	if (!indexed)
+		return;
+	if (start >= 0 && end >= start)
+	{
+		offset = start;
+		length = end - start;
+	}
+
+	put_le(m_index, offset, 8);
+	put_le(m_index, length, 4);
+	put_le(m_index, entry->m_flags, 4);
+	put_le(m_index, index_string(entry->m_name), 4);
+	put_le(m_index, index_string(entry->m_sourcefile), 4);
+	put_le(m_index, index_string(entry->m_description), 4);
+	put_le(m_index, index_string(entry->m_year), 4);
+	put_le(m_index, index_string(entry->m_manufacturer), 4);
+	put_le(m_index, index_string(entry->m_cloneof), 4);
+	put_le(m_index, index_string(entry->m_romof), 4);
+	m_indexcount++;
+}
+
+
+//-------------------------------------------------
+//  index_string - return the offset of a string
+//  in the binary index, adding it if needed
+//-------------------------------------------------
+
+UINT32 info_xml_creator::index_string(const std::string &string)
+{
+	if (string.empty())
+		return 0;
+
+	// manufacturers and source files repeat a lot, so each is stored once
+	auto found = m_stringoffs.emplace(string, UINT32(m_strings.size()));
+	if (found.second)
+		m_strings.append(string).push_back('\0');
+	return found.first->second;
+}
+
+
+//-------------------------------------------------
+//  save_index - write the binary index out
+//-------------------------------------------------
+
+void info_xml_creator::save_index(const char *indexfile)
+{
+	std::vector<UINT8> header(INFO_INDEX_MAGIC, INFO_INDEX_MAGIC + 8);
+	UINT32 build = index_string(build_version);
+	put_le(header, m_indexcount, 4);
+	put_le(header, m_strings.size(), 4);
+	put_le(header, build, 4);
+
+	util::core_file::ptr file;
+	if (util::core_file::open(indexfile, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file) != FILERR_NONE)
+	{
+		osd_printf_warning("Unable to write XML index %s\n", indexfile);
+		return;
+	}
+	file->write(&header[0], header.size());
+	if (!m_index.empty())
+		file->write(&m_index[0], m_index.size());
+	file->write(m_strings.data(), m_strings.size());
+}
+
+
 //------------------------------------------------
 //  output_device_roms - when a driver uses roms
 //  included in a device set, print a reference
@@ -452,7 +781,7 @@ void info_xml_creator::output_device_roms()
 	device_iterator deviter(m_drivlist.config().root_device());
 	for (device_t *device = deviter.first(); device != nullptr; device = deviter.next())
 		if (device->owner() != nullptr && device->shortname()!= nullptr && device->shortname()[0]!='\0')
-			fprintf(m_output, "\t\t<device_ref name=\"%s\"/>\n", xml_normalize_string(device->shortname()));
+			util::stream_format(m_output, "\t\t<device_ref name=\"%s\"/>\n", normalize(device->shortname()));
 }
 
 
@@ -470,7 +799,7 @@ void info_xml_creator::output_sampleof()
 		samples_iterator sampiter(*device);
 		if (sampiter.altbasename() != nullptr)
 		{
-			fprintf(m_output, " sampleof=\"%s\"", xml_normalize_string(sampiter.altbasename()));
+			util::stream_format(m_output, " sampleof=\"%s\"", normalize(sampiter.altbasename()));
 
 			// must stop here, as there can only be one attribute of the same name
 			return;
@@ -495,12 +824,12 @@ void info_xml_creator::output_bios()
 		if (ROMENTRY_ISSYSTEM_BIOS(rom))
 		{
 			// output extracted name and descriptions
-			fprintf(m_output, "\t\t<biosset");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(ROM_GETNAME(rom)));
-			fprintf(m_output, " description=\"%s\"", xml_normalize_string(ROM_GETHASHDATA(rom)));
+			util::stream_format(m_output, "\t\t<biosset");
+			util::stream_format(m_output, " name=\"%s\"", normalize(ROM_GETNAME(rom)));
+			util::stream_format(m_output, " description=\"%s\"", normalize(ROM_GETHASHDATA(rom)));
 			if (ROM_GETBIOSFLAGS(rom) == 1)
-				fprintf(m_output, " default=\"yes\"");
-			fprintf(m_output, "/>\n");
+				util::stream_format(m_output, " default=\"yes\"");
+			util::stream_format(m_output, "/>\n");
 		}
 }
 
@@ -564,11 +893,11 @@ void info_xml_creator::output_rom(device_t &device)
 
 				// add name, merge, bios, and size tags */
 				if (name != nullptr && name[0] != 0)
-					util::stream_format(output, " name=\"%s\"", xml_normalize_string(name));
+					util::stream_format(output, " name=\"%s\"", normalize(name));
 				if (merge_name != nullptr)
-					util::stream_format(output, " merge=\"%s\"", xml_normalize_string(merge_name));
+					util::stream_format(output, " merge=\"%s\"", normalize(merge_name));
 				if (bios_name[0] != 0)
-					util::stream_format(output, " bios=\"%s\"", xml_normalize_string(bios_name));
+					util::stream_format(output, " bios=\"%s\"", normalize(bios_name));
 				if (!is_disk)
 					util::stream_format(output, " size=\"%d\"", rom_file_size(rom));
 
@@ -601,7 +930,7 @@ void info_xml_creator::output_rom(device_t &device)
 
 				output << "/>\n";
 
-				fprintf(m_output, "%s", output.str().c_str());
+				m_output << output.str();
 			}
 		}
 }
@@ -627,7 +956,7 @@ void info_xml_creator::output_sample(device_t &device)
 				continue;
 
 			// output the sample name
-			fprintf(m_output, "\t\t<sample name=\"%s\"/>\n", xml_normalize_string(samplename));
+			util::stream_format(m_output, "\t\t<sample name=\"%s\"/>\n", normalize(samplename));
 		}
 	}
 }
@@ -649,12 +978,12 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(exec->device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"cpu\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(exec->device().name()));
-			fprintf(m_output, " clock=\"%d\"", exec->device().clock());
-			fprintf(m_output, "/>\n");
+			util::stream_format(m_output, "\t\t<chip");
+			util::stream_format(m_output, " type=\"cpu\"");
+			util::stream_format(m_output, " tag=\"%s\"", normalize(newtag.c_str()));
+			util::stream_format(m_output, " name=\"%s\"", normalize(exec->device().name()));
+			util::stream_format(m_output, " clock=\"%d\"", exec->device().clock());
+			util::stream_format(m_output, "/>\n");
 		}
 	}
 
@@ -667,13 +996,13 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(sound->device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"audio\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(sound->device().name()));
+			util::stream_format(m_output, "\t\t<chip");
+			util::stream_format(m_output, " type=\"audio\"");
+			util::stream_format(m_output, " tag=\"%s\"", normalize(newtag.c_str()));
+			util::stream_format(m_output, " name=\"%s\"", normalize(sound->device().name()));
 			if (sound->device().clock() != 0)
-				fprintf(m_output, " clock=\"%d\"", sound->device().clock());
-			fprintf(m_output, "/>\n");
+				util::stream_format(m_output, " clock=\"%d\"", sound->device().clock());
+			util::stream_format(m_output, "/>\n");
 		}
 	}
 }
@@ -695,43 +1024,43 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			std::string newtag(screendev->tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<display");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
+			util::stream_format(m_output, "\t\t<display");
+			util::stream_format(m_output, " tag=\"%s\"", normalize(newtag.c_str()));
 
 			switch (screendev->screen_type())
 			{
-				case SCREEN_TYPE_RASTER:    fprintf(m_output, " type=\"raster\"");  break;
-				case SCREEN_TYPE_VECTOR:    fprintf(m_output, " type=\"vector\"");  break;
-				case SCREEN_TYPE_LCD:       fprintf(m_output, " type=\"lcd\"");     break;
-				default:                    fprintf(m_output, " type=\"unknown\""); break;
+				case SCREEN_TYPE_RASTER:    util::stream_format(m_output, " type=\"raster\"");  break;
+				case SCREEN_TYPE_VECTOR:    util::stream_format(m_output, " type=\"vector\"");  break;
+				case SCREEN_TYPE_LCD:       util::stream_format(m_output, " type=\"lcd\"");     break;
+				default:                    util::stream_format(m_output, " type=\"unknown\""); break;
 			}
 
 			// output the orientation as a string
 			switch (m_drivlist.driver().flags & ORIENTATION_MASK)
 			{
 				case ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"0\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"0\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"180\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\"");
+					util::stream_format(m_output, " rotate=\"180\"");
 					break;
 				case ORIENTATION_SWAP_XY:
-					fprintf(m_output, " rotate=\"90\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"90\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"90\"");
+					util::stream_format(m_output, " rotate=\"90\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\"");
+					util::stream_format(m_output, " rotate=\"270\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"270\" flipx=\"yes\"");
 					break;
 				default:
-					fprintf(m_output, " rotate=\"0\"");
+					util::stream_format(m_output, " rotate=\"0\"");
 					break;
 			}
 
@@ -739,12 +1068,12 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			if (screendev->screen_type() != SCREEN_TYPE_VECTOR)
 			{
 				const rectangle &visarea = screendev->visible_area();
-				fprintf(m_output, " width=\"%d\"", visarea.width());
-				fprintf(m_output, " height=\"%d\"", visarea.height());
+				util::stream_format(m_output, " width=\"%d\"", visarea.width());
+				util::stream_format(m_output, " height=\"%d\"", visarea.height());
 			}
 
 			// output refresh rate
-			fprintf(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds()));
+			util::stream_format(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds()));
 
 			// output raw video parameters only for games that are not vector
 			// and had raw parameters specified
@@ -752,15 +1081,15 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			{
 				int pixclock = screendev->width() * screendev->height() * ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds());
 
-				fprintf(m_output, " pixclock=\"%d\"", pixclock);
-				fprintf(m_output, " htotal=\"%d\"", screendev->width());
-				fprintf(m_output, " hbend=\"%d\"", screendev->visible_area().min_x);
-				fprintf(m_output, " hbstart=\"%d\"", screendev->visible_area().max_x+1);
-				fprintf(m_output, " vtotal=\"%d\"", screendev->height());
-				fprintf(m_output, " vbend=\"%d\"", screendev->visible_area().min_y);
-				fprintf(m_output, " vbstart=\"%d\"", screendev->visible_area().max_y+1);
+				util::stream_format(m_output, " pixclock=\"%d\"", pixclock);
+				util::stream_format(m_output, " htotal=\"%d\"", screendev->width());
+				util::stream_format(m_output, " hbend=\"%d\"", screendev->visible_area().min_x);
+				util::stream_format(m_output, " hbstart=\"%d\"", screendev->visible_area().max_x+1);
+				util::stream_format(m_output, " vtotal=\"%d\"", screendev->height());
+				util::stream_format(m_output, " vbend=\"%d\"", screendev->visible_area().min_y);
+				util::stream_format(m_output, " vbstart=\"%d\"", screendev->visible_area().max_y+1);
 			}
-			fprintf(m_output, " />\n");
+			util::stream_format(m_output, " />\n");
 		}
 	}
 }
@@ -781,7 +1110,7 @@ void info_xml_creator::output_sound(device_t &device)
 	if (snditer.first() == nullptr)
 		speakers = 0;
 
-	fprintf(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
+	util::stream_format(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
 }
 
 
@@ -990,17 +1319,17 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 		}
 
 	// output the basic info
-	fprintf(m_output, "\t\t<input");
-	fprintf(m_output, " players=\"%d\"", nplayer);
+	util::stream_format(m_output, "\t\t<input");
+	util::stream_format(m_output, " players=\"%d\"", nplayer);
 	if (nbutton != 0)
-		fprintf(m_output, " buttons=\"%d\"", nbutton);
+		util::stream_format(m_output, " buttons=\"%d\"", nbutton);
 	if (ncoin != 0)
-		fprintf(m_output, " coins=\"%d\"", ncoin);
+		util::stream_format(m_output, " coins=\"%d\"", ncoin);
 	if (service)
-		fprintf(m_output, " service=\"yes\"");
+		util::stream_format(m_output, " service=\"yes\"");
 	if (tilt)
-		fprintf(m_output, " tilt=\"yes\"");
-	fprintf(m_output, ">\n");
+		util::stream_format(m_output, " tilt=\"yes\"");
+	util::stream_format(m_output, ">\n");
 
 	// output the joystick types
 	if (joytype[1]==0 && joytype[2]!=0) { joytype[1] = joytype[2]; joytype[2] = 0; }
@@ -1009,7 +1338,7 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 	if (joytype[0] != 0)
 	{
 		const char *joys = (joytype[2]!=0) ? "triple" : (joytype[1]!=0) ? "double" : "";
-		fprintf(m_output, "\t\t\t<control type=\"%sjoy\"", joys);
+		util::stream_format(m_output, "\t\t\t<control type=\"%sjoy\"", joys);
 		for (int lp=0; lp<3 && joytype[lp]!=0; lp++)
 		{
 			const char *plural = (lp==2) ? "3" : (lp==1) ? "2" : "";
@@ -1041,46 +1370,46 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 					ways = "strange2";
 					break;
 			}
-			fprintf(m_output, " ways%s=\"%s\"", plural,ways);
+			util::stream_format(m_output, " ways%s=\"%s\"", plural,ways);
 		}
-		fprintf(m_output, "/>\n");
+		util::stream_format(m_output, "/>\n");
 	}
 
 	// output analog types
 	for (auto & elem : control_info)
 		if (elem.type != nullptr)
 		{
-			fprintf(m_output, "\t\t\t<control type=\"%s\"", xml_normalize_string(elem.type));
+			util::stream_format(m_output, "\t\t\t<control type=\"%s\"", normalize(elem.type));
 			if (elem.min != 0 || elem.max != 0)
 			{
-				fprintf(m_output, " minimum=\"%d\"", elem.min);
-				fprintf(m_output, " maximum=\"%d\"", elem.max);
+				util::stream_format(m_output, " minimum=\"%d\"", elem.min);
+				util::stream_format(m_output, " maximum=\"%d\"", elem.max);
 			}
 			if (elem.sensitivity != 0)
-				fprintf(m_output, " sensitivity=\"%d\"", elem.sensitivity);
+				util::stream_format(m_output, " sensitivity=\"%d\"", elem.sensitivity);
 			if (elem.keydelta != 0)
-				fprintf(m_output, " keydelta=\"%d\"", elem.keydelta);
+				util::stream_format(m_output, " keydelta=\"%d\"", elem.keydelta);
 			if (elem.reverse)
-				fprintf(m_output, " reverse=\"yes\"");
+				util::stream_format(m_output, " reverse=\"yes\"");
 
-			fprintf(m_output, "/>\n");
+			util::stream_format(m_output, "/>\n");
 		}
 
 	// output keypad and keyboard
 	if (keypad)
-		fprintf(m_output, "\t\t\t<control type=\"keypad\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"keypad\"/>\n");
 	if (keyboard)
-		fprintf(m_output, "\t\t\t<control type=\"keyboard\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"keyboard\"/>\n");
 
 	// misc
 	if (mahjong)
-		fprintf(m_output, "\t\t\t<control type=\"mahjong\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"mahjong\"/>\n");
 	if (hanafuda)
-		fprintf(m_output, "\t\t\t<control type=\"hanafuda\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"hanafuda\"/>\n");
 	if (gambling)
-		fprintf(m_output, "\t\t\t<control type=\"gambling\"/>\n");
+		util::stream_format(m_output, "\t\t\t<control type=\"gambling\"/>\n");
 
-	fprintf(m_output, "\t\t</input>\n");
+	util::stream_format(m_output, "\t\t</input>\n");
 }
 
 
@@ -1102,20 +1431,20 @@ void info_xml_creator::output_switches(const ioport_list &portlist, const char *
 				newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 				// output the switch name information
-				std::string normalized_field_name(xml_normalize_string(field->name()));
-				std::string normalized_newtag(xml_normalize_string(newtag.c_str()));
+				std::string normalized_field_name(normalize(field->name()));
+				std::string normalized_newtag(normalize(newtag.c_str()));
 				util::stream_format(output,"\t\t<%s name=\"%s\" tag=\"%s\" mask=\"%u\">\n", outertag, normalized_field_name.c_str(), normalized_newtag.c_str(), field->mask());
 
 				// loop over settings
 				for (ioport_setting *setting = field->first_setting(); setting != nullptr; setting = setting->next())
 				{
-					util::stream_format(output,"\t\t\t<%s name=\"%s\" value=\"%u\"%s/>\n", innertag, xml_normalize_string(setting->name()), setting->value(), setting->value() == field->defvalue() ? " default=\"yes\"" : "");
+					util::stream_format(output,"\t\t\t<%s name=\"%s\" value=\"%u\"%s/>\n", innertag, normalize(setting->name()), setting->value(), setting->value() == field->defvalue() ? " default=\"yes\"" : "");
 				}
 
 				// terminate the switch entry
 				util::stream_format(output,"\t\t</%s>\n", outertag);
 
-				fprintf(m_output, "%s", output.str().c_str());
+				m_output << output.str();
 			}
 }
 
@@ -1128,14 +1457,14 @@ void info_xml_creator::output_ports(const ioport_list &portlist)
 	// cycle through ports
 	for (ioport_port *port = portlist.first(); port != nullptr; port = port->next())
 	{
-		fprintf(m_output,"\t\t<port tag=\"%s\">\n",port->tag());
+		util::stream_format(m_output, "\t\t<port tag=\"%s\">\n",port->tag());
 		for (ioport_field *field = port->first_field(); field != nullptr; field = field->next())
 		{
 			if(field->is_analog())
-				fprintf(m_output,"\t\t\t<analog mask=\"%u\"/>\n",field->mask());
+				util::stream_format(m_output, "\t\t\t<analog mask=\"%u\"/>\n",field->mask());
 		}
 		// close element
-		fprintf(m_output,"\t\t</port>\n");
+		util::stream_format(m_output, "\t\t</port>\n");
 	}
 
 }
@@ -1151,7 +1480,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 	for (ioport_port *port = portlist.first(); port != nullptr; port = port->next())
 		for (ioport_field *field = port->first_field(); field != nullptr; field = field->next())
 			if (field->type() == IPT_ADJUSTER)
-				fprintf(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", xml_normalize_string(field->name()), field->defvalue());
+				util::stream_format(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", normalize(field->name()), field->defvalue());
 }
 
 
@@ -1161,7 +1490,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 
 void info_xml_creator::output_driver()
 {
-	fprintf(m_output, "\t\t<driver");
+	util::stream_format(m_output, "\t\t<driver");
 
 	/* The status entry is an hint for frontend authors */
 	/* to select working and not working games without */
@@ -1172,48 +1501,48 @@ void info_xml_creator::output_driver()
 	/* don't work or have major emulation problems. */
 
 	if (m_drivlist.driver().flags & (MACHINE_NOT_WORKING | MACHINE_UNEMULATED_PROTECTION | MACHINE_NO_SOUND | MACHINE_WRONG_COLORS | MACHINE_MECHANICAL))
-		fprintf(m_output, " status=\"preliminary\"");
+		util::stream_format(m_output, " status=\"preliminary\"");
 	else if (m_drivlist.driver().flags & (MACHINE_IMPERFECT_COLORS | MACHINE_IMPERFECT_SOUND | MACHINE_IMPERFECT_GRAPHICS))
-		fprintf(m_output, " status=\"imperfect\"");
+		util::stream_format(m_output, " status=\"imperfect\"");
 	else
-		fprintf(m_output, " status=\"good\"");
+		util::stream_format(m_output, " status=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NOT_WORKING)
-		fprintf(m_output, " emulation=\"preliminary\"");
+		util::stream_format(m_output, " emulation=\"preliminary\"");
 	else
-		fprintf(m_output, " emulation=\"good\"");
+		util::stream_format(m_output, " emulation=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_WRONG_COLORS)
-		fprintf(m_output, " color=\"preliminary\"");
+		util::stream_format(m_output, " color=\"preliminary\"");
 	else if (m_drivlist.driver().flags & MACHINE_IMPERFECT_COLORS)
-		fprintf(m_output, " color=\"imperfect\"");
+		util::stream_format(m_output, " color=\"imperfect\"");
 	else
-		fprintf(m_output, " color=\"good\"");
+		util::stream_format(m_output, " color=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NO_SOUND)
-		fprintf(m_output, " sound=\"preliminary\"");
+		util::stream_format(m_output, " sound=\"preliminary\"");
 	else if (m_drivlist.driver().flags & MACHINE_IMPERFECT_SOUND)
-		fprintf(m_output, " sound=\"imperfect\"");
+		util::stream_format(m_output, " sound=\"imperfect\"");
 	else
-		fprintf(m_output, " sound=\"good\"");
+		util::stream_format(m_output, " sound=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_IMPERFECT_GRAPHICS)
-		fprintf(m_output, " graphic=\"imperfect\"");
+		util::stream_format(m_output, " graphic=\"imperfect\"");
 	else
-		fprintf(m_output, " graphic=\"good\"");
+		util::stream_format(m_output, " graphic=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NO_COCKTAIL)
-		fprintf(m_output, " cocktail=\"preliminary\"");
+		util::stream_format(m_output, " cocktail=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & MACHINE_UNEMULATED_PROTECTION)
-		fprintf(m_output, " protection=\"preliminary\"");
+		util::stream_format(m_output, " protection=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & MACHINE_SUPPORTS_SAVE)
-		fprintf(m_output, " savestate=\"supported\"");
+		util::stream_format(m_output, " savestate=\"supported\"");
 	else
-		fprintf(m_output, " savestate=\"unsupported\"");
+		util::stream_format(m_output, " savestate=\"unsupported\"");
 
-	fprintf(m_output, "/>\n");
+	util::stream_format(m_output, "/>\n");
 }
 
 
@@ -1233,42 +1562,46 @@ void info_xml_creator::output_images(device_t &device, const char *root_tag)
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<device type=\"%s\"", xml_normalize_string(imagedev->image_type_name()));
+			util::stream_format(m_output, "\t\t<device type=\"%s\"", normalize(imagedev->image_type_name()));
 
 			// does this device have a tag?
 			if (imagedev->device().tag())
-				fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
+				util::stream_format(m_output, " tag=\"%s\"", normalize(newtag.c_str()));
 
 			// is this device mandatory?
 			if (imagedev->must_be_loaded())
-				fprintf(m_output, " mandatory=\"1\"");
+				util::stream_format(m_output, " mandatory=\"1\"");
 
 			if (imagedev->image_interface() && imagedev->image_interface()[0])
-				fprintf(m_output, " interface=\"%s\"", xml_normalize_string(imagedev->image_interface()));
+				util::stream_format(m_output, " interface=\"%s\"", normalize(imagedev->image_interface()));
 
 			// close the XML tag
-			fprintf(m_output, ">\n");
+			util::stream_format(m_output, ">\n");
 
 			const char *name = imagedev->instance_name();
 			const char *shortname = imagedev->brief_instance_name();
 
-			fprintf(m_output, "\t\t\t<instance");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(name));
-			fprintf(m_output, " briefname=\"%s\"", xml_normalize_string(shortname));
-			fprintf(m_output, "/>\n");
+			util::stream_format(m_output, "\t\t\t<instance");
+			util::stream_format(m_output, " name=\"%s\"", normalize(name));
+			util::stream_format(m_output, " briefname=\"%s\"", normalize(shortname));
+			util::stream_format(m_output, "/>\n");
 
 			std::string extensions(imagedev->file_extensions());
-
-			char *ext = strtok((char *)extensions.c_str(), ",");
-			while (ext != nullptr)
+			for (size_t start = 0, end; start < extensions.length(); start = end + 1)
 			{
-				fprintf(m_output, "\t\t\t<extension");
-				fprintf(m_output, " name=\"%s\"", xml_normalize_string(ext));
-				fprintf(m_output, "/>\n");
-				ext = strtok(nullptr, ",");
+				end = extensions.find(',', start);
+				if (end == std::string::npos)
+					end = extensions.length();
+				if (end == start)
+					continue;
+
+				std::string ext(extensions, start, end - start);
+				util::stream_format(m_output, "\t\t\t<extension");
+				util::stream_format(m_output, " name=\"%s\"", normalize(ext.c_str()));
+				util::stream_format(m_output, "/>\n");
 			}
 
-			fprintf(m_output, "\t\t</device>\n");
+			util::stream_format(m_output, "\t\t</device>\n");
 		}
 	}
 }
@@ -1291,11 +1624,11 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<slot name=\"%s\">\n", xml_normalize_string(newtag.c_str()));
+			util::stream_format(m_output, "\t\t<slot name=\"%s\">\n", normalize(newtag.c_str()));
 
 			/*
 			 if (slot->slot_interface()[0])
-			 fprintf(m_output, " interface=\"%s\"", xml_normalize_string(slot->slot_interface()));
+			 util::stream_format(m_output, " interface=\"%s\"", normalize(slot->slot_interface()));
 			 */
 
 			for (const device_slot_option *option = slot->first_option(); option != nullptr; option = option->next())
@@ -1306,17 +1639,17 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 					if (!dev->configured())
 						dev->config_complete();
 
-					fprintf(m_output, "\t\t\t<slotoption");
-					fprintf(m_output, " name=\"%s\"", xml_normalize_string(option->name()));
-					fprintf(m_output, " devname=\"%s\"", xml_normalize_string(dev->shortname()));
+					util::stream_format(m_output, "\t\t\t<slotoption");
+					util::stream_format(m_output, " name=\"%s\"", normalize(option->name()));
+					util::stream_format(m_output, " devname=\"%s\"", normalize(dev->shortname()));
 					if (slot->default_option() != nullptr && strcmp(slot->default_option(),option->name())==0)
-						fprintf(m_output, " default=\"yes\"");
-					fprintf(m_output, "/>\n");
+						util::stream_format(m_output, " default=\"yes\"");
+					util::stream_format(m_output, "/>\n");
 					const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), "dummy");
 				}
 			}
 
-			fprintf(m_output, "\t\t</slot>\n");
+			util::stream_format(m_output, "\t\t</slot>\n");
 		}
 	}
 }
@@ -1332,12 +1665,12 @@ void info_xml_creator::output_software_list()
 	software_list_device_iterator iter(m_drivlist.config().root_device());
 	for (const software_list_device *swlist = iter.first(); swlist != nullptr; swlist = iter.next())
 	{
-		fprintf(m_output, "\t\t<softwarelist name=\"%s\" ", swlist->list_name());
-		fprintf(m_output, "status=\"%s\" ", (swlist->list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
+		util::stream_format(m_output, "\t\t<softwarelist name=\"%s\" ", swlist->list_name());
+		util::stream_format(m_output, "status=\"%s\" ", (swlist->list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
 		if (swlist->filter()) {
-			fprintf(m_output, "filter=\"%s\" ", swlist->filter());
+			util::stream_format(m_output, "filter=\"%s\" ", swlist->filter());
 		}
-		fprintf(m_output, "/>\n");
+		util::stream_format(m_output, "/>\n");
 	}
 }
 
@@ -1353,7 +1686,7 @@ void info_xml_creator::output_ramoptions()
 	ram_device_iterator iter(m_drivlist.config().root_device());
 	for (const ram_device *ram = iter.first(); ram != nullptr; ram = iter.next())
 	{
-		fprintf(m_output, "\t\t<ramoption default=\"1\">%u</ramoption>\n", ram->default_size());
+		util::stream_format(m_output, "\t\t<ramoption default=\"1\">%u</ramoption>\n", ram->default_size());
 
 		if (ram->extra_options() != nullptr)
 		{
@@ -1362,7 +1695,7 @@ void info_xml_creator::output_ramoptions()
 			{
 				std::string option;
 				option.assign(options.substr(start, (end == -1) ? -1 : end - start));
-				fprintf(m_output, "\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option.c_str()));
+				util::stream_format(m_output, "\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option.c_str()));
 				if (end == -1)
 					break;
 			}
@@ -1399,3 +1732,31 @@ const char *info_xml_creator::get_merge_name(const hash_collection &romhashes)
 
 	return merge_name;
 }
+
+
+//-------------------------------------------------
+//  normalize - escape a string for use in XML;
+//  like xml_normalize_string, but with a buffer
+//  of our own so creators can run in parallel
+//-------------------------------------------------
+
+const char *info_xml_creator::normalize(const char *string)
+{
+	m_normalized.clear();
+	if (string != nullptr)
+	{
+		for ( ; *string != 0; string++)
+		{
+			switch (*string)
+			{
+				case '\"' : m_normalized.append("&quot;"); break;
+				case '&'  : m_normalized.append("&amp;"); break;
+				case '<'  : m_normalized.append("&lt;"); break;
+				case '>'  : m_normalized.append("&gt;"); break;
+				default:
+					m_normalized.push_back(*string);
+			}
+		}
+	}
+	return m_normalized.c_str();
+}
@@ -15,6 +15,38 @@
 
 #include "drivenum.h"
 
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+//**************************************************************************
+//  BINARY INDEX
+//**************************************************************************
+
+// -xmlindex writes a binary index of the -listxml output, so that frontends
+// can list machines without parsing the XML; all values are little-endian:
+//
+//   header:    "MAMEIDX1", UINT32 machine count, UINT32 string table size,
+//              UINT32 build version string
+//   machines:  UINT64 offset and UINT32 length of the machine's element in
+//              the XML file, UINT32 flags, then UINT32 strings for name,
+//              sourcefile, description, year, manufacturer, cloneof, romof
+//   strings:   NUL-terminated UTF-8; strings are given as offsets into this
+//              table, and offset 0 is the empty string
+//
+// an index is only valid for the XML output it was written with
+
+#define INFO_INDEX_MAGIC            "MAMEIDX1"
+
+#define INFO_INDEX_FLAG_BIOS        0x01
+#define INFO_INDEX_FLAG_DEVICE      0x02
+#define INFO_INDEX_FLAG_NOT_RUNNABLE 0x04
+#define INFO_INDEX_FLAG_MECHANICAL  0x08
+
+
 
 //**************************************************************************
 //  FUNCTION PROTOTYPES
@@ -26,11 +58,36 @@ class info_xml_creator
 public:
 	// construction/destruction
 	info_xml_creator(driver_enumerator &drivlist);
+	~info_xml_creator();
 
-	// output
-	void output(FILE *out, bool nodevices = false);
+	// output, optionally with a binary index of the machines
+	void output(FILE *out, bool nodevices = false, const char *indexfile = nullptr);
 
 private:
+	struct worker;
+	struct job;
+
+	// what the binary index records about a machine
+	struct index_entry
+	{
+		std::string         m_name;
+		std::string         m_sourcefile;
+		std::string         m_description;
+		std::string         m_year;
+		std::string         m_manufacturer;
+		std::string         m_cloneof;
+		std::string         m_romof;
+		UINT32              m_flags;
+	};
+
+	// parallel output
+	void output_machines(FILE *out, osd_work_queue *queue, const std::vector<int> &drivers);
+	void output_devices(FILE *out, osd_work_queue *queue, const std::vector<int> &drivers);
+	void run_jobs(osd_work_queue *queue, std::vector<job> &jobs, osd_work_callback callback);
+	info_xml_creator &thread_creator(int threadid);
+	static void *output_machines_static(void *param, int threadid);
+	static void *output_devices_static(void *param, int threadid);
+
 	// internal helper
 	void output_one();
 	void output_sampleof();
@@ -52,15 +109,37 @@ private:
 	void output_ramoptions();
 
 	void output_one_device(device_t &device, const char *devtag);
-	void output_devices();
+	void output_current_devices(job &cur);
+
+	// binary index
+	void write_xml(FILE *out, const std::string &xml, const index_entry *entry);
+	UINT32 index_string(const std::string &string);
+	void save_index(const char *indexfile);
 
 	const char *get_merge_name(const hash_collection &romhashes);
+	const char *normalize(const char *string);
 
 	// internal state
-	FILE *                  m_output;
+	std::ostringstream      m_output;
+	std::string             m_normalized;
 	driver_enumerator &     m_drivlist;
 	emu_options             m_lookup_options;
 
+	// devices already written by output_devices
+	std::unordered_set<std::string> m_shortnames;
+
+	// binary index, if requested
+	bool                    m_indexing;
+	UINT64                  m_offset;           // bytes of XML written so far
+	index_entry             m_entry;            // entry for the machine just described
+	std::vector<UINT8>      m_index;            // machine records
+	UINT32                  m_indexcount;
+	std::string             m_strings;          // string table
+	std::unordered_map<std::string, UINT32> m_stringoffs;
+
+	// one creator per worker thread
+	std::unique_ptr<worker> m_worker[WORK_MAX_THREADS + 1];
+
 	static const char s_dtd_string[];
 };
 
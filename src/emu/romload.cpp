@@ -24,6 +24,10 @@
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
 
+/* files opened before they are read and hashed in parallel */
+#define LOAD_BATCH_MAX_FILES    64
+#define LOAD_BATCH_MAX_SIZE     (64 * 1024 * 1024)
+
 /***************************************************************************
     HELPERS (also used by diimage.cpp)
  ***************************************************************************/
@@ -40,9 +44,9 @@ static file_error common_process_file(emu_options &options, const char *location
 	return filerr;
 }
 
-std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, file_error &filerr)
+std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, file_error &filerr, UINT32 openflags)
 {
-	auto image_file = std::make_unique<emu_file>(options.media_path(), OPEN_FLAG_READ);
+	auto image_file = std::make_unique<emu_file>(options.media_path(), openflags);
 
 	if (has_crc)
 		filerr = image_file->open(location, PATH_SEPARATOR, ROM_GETNAME(romp), crc);
@@ -543,19 +547,16 @@ void rom_load_manager::region_post_process(const char *rgntag, bool invert)
 
 
 /*-------------------------------------------------
-    open_rom_file - open a ROM file, searching
-    up the parent and loading by checksum
+    find_rom_file - open a ROM file into m_file,
+    searching up the parent and loading by
+    checksum
 -------------------------------------------------*/
 
-int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+file_error rom_load_manager::find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, UINT32 openflags)
 {
 	file_error filerr = FILERR_NOT_FOUND;
-	UINT32 romsize = rom_file_size(romp);
 	tried_file_names = "";
 
-	/* update status display */
-	display_loading_rom_message(ROM_GETNAME(romp), from_list);
-
 	/* extract CRC to use for searching */
 	UINT32 crc = 0;
 	bool has_crc = hash_collection(ROM_GETHASHDATA(romp)).crc(crc);
@@ -567,7 +568,7 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		if (tried_file_names.length() != 0)
 			tried_file_names += " ";
 		tried_file_names += driver_list::driver(drv).name;
-		m_file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
+		m_file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr, openflags);
 	}
 
 	/* if the region is load by name, load the ROM from there */
@@ -620,7 +621,7 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		if (!is_list)
 		{
 			tried_file_names += " " + tag1;
-			m_file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
+			m_file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr, openflags);
 		}
 		else
 		{
@@ -628,29 +629,47 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 			if ((m_file == nullptr) && (tag2.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag2;
-				m_file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
+				m_file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr, openflags);
 			}
 			// try to load from list/parentname
 			if ((m_file == nullptr) && has_parent && (tag3.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag3;
-				m_file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
+				m_file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr, openflags);
 			}
 			// try to load from setname
 			if ((m_file == nullptr) && (tag4.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag4;
-				m_file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
+				m_file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr, openflags);
 			}
 			// try to load from parentname
 			if ((m_file == nullptr) && has_parent && (tag5.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag5;
-				m_file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
+				m_file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr, openflags);
 			}
 		}
 	}
 
+	return filerr;
+}
+
+
+/*-------------------------------------------------
+    open_rom_file - open a ROM file, leaving any
+    decompression to preload_rom_batch
+-------------------------------------------------*/
+
+int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+{
+	UINT32 romsize = rom_file_size(romp);
+
+	/* update status display */
+	display_loading_rom_message(ROM_GETNAME(romp), from_list);
+
+	file_error filerr = find_rom_file(regiontag, romp, tried_file_names, OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD);
+
 	/* update counters */
 	m_romsloaded++;
 	m_romsloadedsize += romsize;
@@ -851,16 +870,18 @@ void rom_load_manager::copy_rom_data(const rom_entry *romp)
 
 
 /*-------------------------------------------------
-    process_rom_entries - process all ROM entries
-    for a region
+    open_rom_batch - open the files named by the
+    next few entries in order, stopping early
+    once enough data is pending; returns the
+    first entry not covered
 -------------------------------------------------*/
 
-void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list)
+const rom_entry *rom_load_manager::open_rom_batch(const char *regiontag, const rom_entry *romp, device_t *device, bool from_list, std::vector<pending_rom> &batch)
 {
-	UINT32 lastflags = 0;
+	UINT64 batchsize = 0;
 
-	/* loop until we hit the end of this region */
-	while (!ROMENTRY_ISREGIONEND(romp))
+	batch.clear();
+	while (!ROMENTRY_ISREGIONEND(romp) && batch.size() < LOAD_BATCH_MAX_FILES && batchsize < LOAD_BATCH_MAX_SIZE)
 	{
 		/* if this is a continue entry, it's invalid */
 		if (ROMENTRY_ISCONTINUE(romp))
@@ -874,81 +895,202 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 		if (ROMENTRY_ISRELOAD(romp))
 			fatalerror("Error in RomModule definition: ROM_RELOAD not preceded by ROM_LOAD\n");
 
-		/* handle fills */
-		if (ROMENTRY_ISFILL(romp))
-			fill_rom_data(romp++);
+		/* fills, copies and anything else are handled by process_rom_entries */
+		if (!ROMENTRY_ISFILE(romp))
+		{
+			romp++;
+			continue;
+		}
 
-		/* handle copies */
-		else if (ROMENTRY_ISCOPY(romp))
-			copy_rom_data(romp++);
+		batch.emplace_back();
+		pending_rom &pending = batch.back();
 
-		/* handle files */
-		else if (ROMENTRY_ISFILE(romp))
+		/* open the file if it is a non-BIOS or matches the current BIOS */
+		if (ROM_GETBIOSFLAGS(romp) == 0 || ROM_GETBIOSFLAGS(romp) == device->system_bios())
 		{
-			int irrelevantbios = (ROM_GETBIOSFLAGS(romp) != 0 && ROM_GETBIOSFLAGS(romp) != device->system_bios());
-			const rom_entry *baserom = romp;
-			int explength = 0;
-
-			/* open the file if it is a non-BIOS or matches the current BIOS */
 			LOG(("Opening ROM file: %s\n", ROM_GETNAME(romp)));
-			std::string tried_file_names;
-			if (!irrelevantbios && !open_rom_file(regiontag, romp, tried_file_names, from_list))
-				handle_missing_file(romp, tried_file_names, CHDERR_NONE);
+			open_rom_file(regiontag, romp, pending.tried_file_names, from_list);
+			pending.file = std::move(m_file);
+			pending.hash_types = hash_collection(ROM_GETHASHDATA(romp)).hash_types();
+			batchsize += rom_file_size(romp);
+		}
 
-			/* loop until we run out of reloads */
-			do
-			{
-				/* loop until we run out of continues/ignores */
-				do
-				{
-					rom_entry modified_romp = *romp++;
-					//int readresult;
+		/* skip over the continues, ignores and reloads that belong to it */
+		do
+			romp++;
+		while (ROMENTRY_ISCONTINUE(romp) || ROMENTRY_ISIGNORE(romp) || ROMENTRY_ISRELOAD(romp));
+	}
+	return romp;
+}
 
-					/* handle flag inheritance */
-					if (!ROM_INHERITSFLAGS(&modified_romp))
-						lastflags = modified_romp._flags;
-					else
-						modified_romp._flags = (modified_romp._flags & ~ROM_INHERITEDFLAGS) | lastflags;
 
-					explength += ROM_GETLENGTH(&modified_romp);
+/*-------------------------------------------------
+    preload_rom_static - read, decompress and
+    hash a single pending file
+-------------------------------------------------*/
 
-					/* attempt to read using the modified entry */
-					if (!ROMENTRY_ISIGNORE(&modified_romp) && !irrelevantbios)
-						/*readresult = */read_rom_data(parent_region, &modified_romp);
-				}
-				while (ROMENTRY_ISCONTINUE(romp) || ROMENTRY_ISIGNORE(romp));
+void *rom_load_manager::preload_rom_static(void *param, int threadid)
+{
+	pending_rom &pending = *reinterpret_cast<pending_rom *>(param);
 
-				/* if this was the first use of this file, verify the length and CRC */
-				if (baserom)
-				{
-					LOG(("Verifying length (%X) and checksums\n", explength));
-					verify_length_and_hash(ROM_GETNAME(baserom), explength, hash_collection(ROM_GETHASHDATA(baserom)));
-					LOG(("Verify finished\n"));
-				}
+	/* seeking decompresses an archive member; hashing reads in a plain file */
+	if (pending.file != nullptr)
+	{
+		pending.file->seek(0, SEEK_SET);
+		pending.file->hashes(pending.hash_types.c_str());
+	}
+	return nullptr;
+}
 
-				/* reseek to the start and clear the baserom so we don't reverify */
-				if (m_file != nullptr)
-					m_file->seek(0, SEEK_SET);
-				baserom = nullptr;
-				explength = 0;
-			}
-			while (ROMENTRY_ISRELOAD(romp));
 
-			/* close the file */
-			if (m_file != nullptr)
-			{
-				LOG(("Closing ROM file\n"));
-				m_file = nullptr;
-			}
+/*-------------------------------------------------
+    preload_rom_batch - read and hash a batch of
+    files on all processors
+-------------------------------------------------*/
+
+void rom_load_manager::preload_rom_batch(osd_work_queue *&queue, std::vector<pending_rom> &batch)
+{
+	/* 7-Zip members are decompressed together first, so the solid blocks they
+	   share are decoded once and independent blocks in parallel */
+	std::vector<emu_file *> deferred_7z;
+	for (pending_rom &pending : batch)
+		if (pending.file != nullptr && pending.file->deferred_7z())
+			deferred_7z.push_back(pending.file.get());
+	if (!deferred_7z.empty())
+		emu_file::load_deferred_7z(deferred_7z);
+
+	/* the queue is made on first use and kept for the rest of the region */
+	if (queue == nullptr && batch.size() > 1)
+		queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
+	if (queue != nullptr && batch.size() > 1)
+	{
+		osd_work_item_queue_multiple(queue, preload_rom_static, batch.size(), &batch[0], sizeof(batch[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+	}
+	else
+	{
+		for (pending_rom &pending : batch)
+			preload_rom_static(&pending, 0);
+	}
+}
+
+
+/*-------------------------------------------------
+    load_rom_file - copy a preloaded file into the
+    region and verify it; returns the entry
+    following its continues, ignores and reloads
+-------------------------------------------------*/
+
+const rom_entry *rom_load_manager::load_rom_file(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, pending_rom &pending, UINT32 &lastflags)
+{
+	int irrelevantbios = (ROM_GETBIOSFLAGS(romp) != 0 && ROM_GETBIOSFLAGS(romp) != device->system_bios());
+	const rom_entry *baserom = romp;
+	int explength = 0;
+
+	/* an archive member that failed to decompress is searched for again the
+	   old way, so it is reported exactly as it would have been at open time */
+	m_file = std::move(pending.file);
+	if (m_file != nullptr && !m_file->is_open())
+	{
+		m_file = nullptr;
+		find_rom_file(regiontag, romp, pending.tried_file_names, OPEN_FLAG_READ);
+	}
+	if (!irrelevantbios && m_file == nullptr)
+		handle_missing_file(romp, pending.tried_file_names, CHDERR_NONE);
+
+	/* loop until we run out of reloads */
+	do
+	{
+		/* loop until we run out of continues/ignores */
+		do
+		{
+			rom_entry modified_romp = *romp++;
+			//int readresult;
+
+			/* handle flag inheritance */
+			if (!ROM_INHERITSFLAGS(&modified_romp))
+				lastflags = modified_romp._flags;
+			else
+				modified_romp._flags = (modified_romp._flags & ~ROM_INHERITEDFLAGS) | lastflags;
+
+			explength += ROM_GETLENGTH(&modified_romp);
+
+			/* attempt to read using the modified entry */
+			if (!ROMENTRY_ISIGNORE(&modified_romp) && !irrelevantbios)
+				/*readresult = */read_rom_data(parent_region, &modified_romp);
 		}
-		else
+		while (ROMENTRY_ISCONTINUE(romp) || ROMENTRY_ISIGNORE(romp));
+
+		/* if this was the first use of this file, verify the length and CRC */
+		if (baserom)
 		{
-			romp++; /* something else; skip */
+			LOG(("Verifying length (%X) and checksums\n", explength));
+			verify_length_and_hash(ROM_GETNAME(baserom), explength, hash_collection(ROM_GETHASHDATA(baserom)));
+			LOG(("Verify finished\n"));
 		}
+
+		/* reseek to the start and clear the baserom so we don't reverify */
+		if (m_file != nullptr)
+			m_file->seek(0, SEEK_SET);
+		baserom = nullptr;
+		explength = 0;
 	}
+	while (ROMENTRY_ISRELOAD(romp));
+
+	/* close the file */
+	if (m_file != nullptr)
+	{
+		LOG(("Closing ROM file\n"));
+		m_file = nullptr;
+	}
+	return romp;
 }
 
 
+/*-------------------------------------------------
+    process_rom_entries - process all ROM entries
+    for a region
+-------------------------------------------------*/
+
+void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list)
+{
+	std::vector<pending_rom> batch;
+	osd_work_queue *queue = nullptr;
+	UINT32 lastflags = 0;
+
+	/* loop until we hit the end of this region */
+	while (!ROMENTRY_ISREGIONEND(romp))
+	{
+		/* open the next few files in order, then read and hash them in parallel */
+		const rom_entry *batchstart = romp;
+		romp = open_rom_batch(regiontag, romp, device, from_list, batch);
+		preload_rom_batch(queue, batch);
+
+		/* walk the same entries again to fill the region in order */
+		auto pending = batch.begin();
+		for (const rom_entry *entry = batchstart; entry != romp; )
+		{
+			/* handle fills */
+			if (ROMENTRY_ISFILL(entry))
+				fill_rom_data(entry++);
+
+			/* handle copies */
+			else if (ROMENTRY_ISCOPY(entry))
+				copy_rom_data(entry++);
+
+			/* handle files */
+			else if (ROMENTRY_ISFILE(entry))
+				entry = load_rom_file(regiontag, parent_region, entry, device, *pending++, lastflags);
+
+			else
+				entry++; /* something else; skip */
+		}
+	}
+
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
+}
 /*-------------------------------------------------
     open_disk_image - open a disk image,
     searching up the parent and loading by
@@ -279,6 +279,14 @@ class rom_load_manager
 		chd_file            m_diffchd;              /* handle to the diff CHD */
 	};
 
+	/* a ROM file opened ahead of being copied into its region */
+	struct pending_rom
+	{
+		std::unique_ptr<emu_file>   file;               /* the file, or nullptr if not opened */
+		std::string                 tried_file_names;   /* locations searched, for errors */
+		std::string                 hash_types;         /* hashes to compute ahead of verifying */
+	};
+
 public:
 	// construction/destruction
 	rom_load_manager(running_machine &machine);
@@ -314,11 +322,16 @@ private:
 	void display_loading_rom_message(const char *name, bool from_list);
 	void display_rom_load_results(bool from_list);
 	void region_post_process(const char *rgntag, bool invert);
+	file_error find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, UINT32 openflags);
 	int open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list);
 	int rom_fread(UINT8 *buffer, int length, const rom_entry *parent_region);
 	int read_rom_data(const rom_entry *parent_region, const rom_entry *romp);
 	void fill_rom_data(const rom_entry *romp);
 	void copy_rom_data(const rom_entry *romp);
+	const rom_entry *open_rom_batch(const char *regiontag, const rom_entry *romp, device_t *device, bool from_list, std::vector<pending_rom> &batch);
+	static void *preload_rom_static(void *param, int threadid);
+	void preload_rom_batch(osd_work_queue *&queue, std::vector<pending_rom> &batch);
+	const rom_entry *load_rom_file(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, pending_rom &pending, UINT32 &lastflags);
 	void process_rom_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list);
 	chd_error open_disk_diff(emu_options &options, const rom_entry *romp, chd_file &source, chd_file &diff_chd);
 	void process_disk_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, const char *locationtag);
@@ -350,7 +363,7 @@ private:
 
 /* ----- Helpers ----- */
 
-std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, file_error &filerr);
+std::unique_ptr<emu_file> common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, file_error &filerr, UINT32 openflags = OPEN_FLAG_READ);
 
 /* return pointer to the first ROM region within a source */
 const rom_entry *rom_first_region(const device_t &device);
@@ -15,9 +15,13 @@
 
 
 //**************************************************************************
-//  TYPE DEFINITIONS
+//  CONSTANTS
 //**************************************************************************
 
+// drivers checked per batch before their results are output
+#define VALIDITY_BATCH_SIZE     256
+
+
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
@@ -42,10 +46,11 @@ inline const char *validity_checker::ioport_string_from_index(UINT32 index)
 inline int validity_checker::get_defstr_index(const char *string, bool suppress_error)
 {
 	// check for strings that should be DEF_STR
-	auto strindex = m_defstr_map.find(string);
-	if (!suppress_error && strindex != m_defstr_map.end() && string != ioport_string_from_index(strindex->second))
+	const int_map &defstr_map = root().m_defstr_map;
+	auto strindex = defstr_map.find(string);
+	if (!suppress_error && strindex != defstr_map.end() && string != ioport_string_from_index(strindex->second))
 		osd_printf_error("Must use DEF_STR( %s )\n", string);
-	return (strindex != m_defstr_map.end()) ? strindex->second : 0;
+	return (strindex != defstr_map.end()) ? strindex->second : 0;
 }
 
 
@@ -116,7 +121,9 @@ validity_checker::validity_checker(emu_options &options)
 		m_current_driver(nullptr),
 		m_current_config(nullptr),
 		m_current_device(nullptr),
-		m_current_ioport(nullptr)
+		m_current_ioport(nullptr),
+		m_current_order(0),
+		m_parent(nullptr)
 {
 	// pre-populate the defstr map with all the default strings
 	for (int strnum = 1; strnum < INPUT_STRING_COUNT; strnum++)
@@ -127,6 +134,25 @@ validity_checker::validity_checker(emu_options &options)
 	}
 }
 
+//-------------------------------------------------
+//  validity_checker - constructor for a worker
+//  thread, sharing the parent's maps
+//-------------------------------------------------
+
+validity_checker::validity_checker(validity_checker &parent)
+	: m_drivlist(parent.m_drivlist.options()),
+		m_errors(0),
+		m_warnings(0),
+		m_print_verbose(parent.m_print_verbose),
+		m_current_driver(nullptr),
+		m_current_config(nullptr),
+		m_current_device(nullptr),
+		m_current_ioport(nullptr),
+		m_current_order(0),
+		m_parent(&parent)
+{
+}
+
 //-------------------------------------------------
 //  validity_checker - destructor
 //-------------------------------------------------
@@ -144,7 +170,7 @@ void validity_checker::check_driver(const game_driver &driver)
 {
 	// simply validate the one driver
 	validate_begin();
-	validate_one(driver);
+	validate_drivers(std::vector<int>(1, driver_list::find(driver)));
 	validate_end();
 }
 
@@ -160,10 +186,12 @@ void validity_checker::check_shared_source(const game_driver &driver)
 	validate_begin();
 
 	// then iterate over all drivers and check the ones that share the same source file
+	std::vector<int> drivers;
 	m_drivlist.reset();
 	while (m_drivlist.next())
 		if (strcmp(driver.source_file, m_drivlist.driver().source_file) == 0)
-			validate_one(m_drivlist.driver());
+			drivers.push_back(m_drivlist.current());
+	validate_drivers(drivers);
 
 	// cleanup
 	validate_end();
@@ -185,21 +213,24 @@ bool validity_checker::check_all_matching(const char *string)
 	// if we had warnings or errors, output
 	if (m_errors > 0 || m_warnings > 0 || !m_verbose_text.empty())
 	{
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Core: %d errors, %d warnings\n", m_errors, m_warnings);
+		std::string report = string_format("Core: %d errors, %d warnings\n", m_errors, m_warnings);
 		if (m_errors > 0)
-			output_indented_errors(m_error_text, "Errors");
+			append_indented_errors(report, m_error_text, "Errors");
 		if (m_warnings > 0)
-			output_indented_errors(m_warning_text, "Warnings");
+			append_indented_errors(report, m_warning_text, "Warnings");
 		if (!m_verbose_text.empty())
-			output_indented_errors(m_verbose_text, "Messages");
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "\n");
+			append_indented_errors(report, m_verbose_text, "Messages");
+		report.append("\n");
+		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "%s", report.c_str());
 	}
 
 	// then iterate over all drivers and check them
+	std::vector<int> drivers;
 	m_drivlist.reset();
 	while (m_drivlist.next())
 		if (m_drivlist.matches(string, m_drivlist.driver().name))
-			validate_one(m_drivlist.driver());
+			drivers.push_back(m_drivlist.current());
+	validate_drivers(drivers);
 
 	// cleanup
 	validate_end();
@@ -246,10 +277,114 @@ void validity_checker::validate_end()
 
 
 //-------------------------------------------------
-//  validate_drivers - master validity checker
+//  validate_drivers - check the given drivers on
+//  all processors, outputting the results in the
+//  order given
+//-------------------------------------------------
+
+void validity_checker::validate_drivers(const std::vector<int> &drivers)
+{
+	// claim names and descriptions in order, so duplicates are reported against the same driver as before
+	for (int index : drivers)
+	{
+		const game_driver &driver = driver_list::driver(index);
+		m_names_map.insert(std::make_pair(driver.name, &driver));
+		m_descriptions_map.insert(std::make_pair(driver.description, &driver));
+	}
+
+	osd_work_queue *queue = (drivers.size() > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	for (size_t base = 0; base < drivers.size(); base += VALIDITY_BATCH_SIZE)
+	{
+		size_t count = MIN(VALIDITY_BATCH_SIZE, drivers.size() - base);
+		std::vector<job> jobs(count);
+		for (size_t index = 0; index < count; index++)
+		{
+			jobs[index].m_owner = this;
+			jobs[index].m_driver = &driver_list::driver(drivers[base + index]);
+			jobs[index].m_order = base + index;
+		}
+
+		if (queue != nullptr && count > 1)
+		{
+			osd_work_item_queue_multiple(queue, validate_job_static, count, &jobs[0], sizeof(jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+		}
+		else
+		{
+			for (job &cur : jobs)
+				validate_job_static(&cur, 0);
+		}
+
+		// a driver that asked already_checked before an earlier one in the batch
+		// got the wrong answer; check it again now that the answers are final
+		for (job &cur : jobs)
+			for (auto &checked : cur.m_checked)
+				if ((m_already_checked.find(checked.first)->second == cur.m_order) != checked.second)
+				{
+					validate_job_static(&cur, 0);
+					break;
+				}
+
+		// merge the results in driver order
+		for (job &cur : jobs)
+		{
+			m_errors += cur.m_errors;
+			m_warnings += cur.m_warnings;
+			if (!cur.m_report.empty())
+				output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "%s", cur.m_report.c_str());
+		}
+	}
+
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
+}
+
+
+//-------------------------------------------------
+//  validate_job_static - check one driver with
+//  the calling thread's own checker
+//-------------------------------------------------
+
+void *validity_checker::validate_job_static(void *param, int threadid)
+{
+	job &cur = *reinterpret_cast<job *>(param);
+	validity_checker &owner = *cur.m_owner;
+
+	// each thread only ever touches its own slot
+	std::unique_ptr<validity_checker> &checker = owner.m_worker[threadid];
+	if (!checker)
+		checker.reset(new validity_checker(owner));
+
+	// route this thread's messages to its checker while it works
+	{
+		std::lock_guard<std::mutex> guard(owner.m_lock);
+		owner.m_thread_checkers[std::this_thread::get_id()] = checker.get();
+	}
+
+	checker->m_errors = 0;
+	checker->m_warnings = 0;
+	checker->m_current_order = cur.m_order;
+	checker->m_checked_here.clear();
+	checker->m_checked.clear();
+	checker->validate_one(*cur.m_driver, cur.m_report);
+	cur.m_errors = checker->m_errors;
+	cur.m_warnings = checker->m_warnings;
+	cur.m_checked.swap(checker->m_checked);
+
+	{
+		std::lock_guard<std::mutex> guard(owner.m_lock);
+		owner.m_thread_checkers.erase(std::this_thread::get_id());
+	}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  validate_one - check one driver, leaving the
+//  text to output in report
 //-------------------------------------------------
 
-void validity_checker::validate_one(const game_driver &driver)
+void validity_checker::validate_one(const game_driver &driver, std::string &report)
 {
 	// set the current driver
 	m_current_driver = &driver;
@@ -282,16 +417,17 @@ void validity_checker::validate_one(const game_driver &driver)
 	}
 
 	// if we had warnings or errors, output
+	report.clear();
 	if (m_errors > start_errors || m_warnings > start_warnings || !m_verbose_text.empty())
 	{
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "Driver %s (file %s): %d errors, %d warnings\n", driver.name, core_filename_extract_base(driver.source_file).c_str(), m_errors - start_errors, m_warnings - start_warnings);
+		report = string_format("Driver %s (file %s): %d errors, %d warnings\n", driver.name, core_filename_extract_base(driver.source_file).c_str(), m_errors - start_errors, m_warnings - start_warnings);
 		if (m_errors > start_errors)
-			output_indented_errors(m_error_text, "Errors");
+			append_indented_errors(report, m_error_text, "Errors");
 		if (m_warnings > start_warnings)
-			output_indented_errors(m_warning_text, "Warnings");
+			append_indented_errors(report, m_warning_text, "Warnings");
 		if (!m_verbose_text.empty())
-			output_indented_errors(m_verbose_text, "Messages");
-		output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "\n");
+			append_indented_errors(report, m_verbose_text, "Messages");
+		report.append("\n");
 	}
 
 	// reset the driver/device
@@ -487,19 +623,15 @@ void validity_checker::validate_inlines()
 
 void validity_checker::validate_driver()
 {
-	// check for duplicate names
-	if (!m_names_map.insert(std::make_pair(m_current_driver->name, m_current_driver)).second)
-	{
-		const game_driver *match = m_names_map.find(m_current_driver->name)->second;
+	// check for duplicate names; validate_drivers has already claimed them in order
+	const game_driver *match = root().m_names_map.find(m_current_driver->name)->second;
+	if (match != m_current_driver)
 		osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(match->source_file).c_str(), match->name);
-	}
 
 	// check for duplicate descriptions
-	if (!m_descriptions_map.insert(std::make_pair(m_current_driver->description, m_current_driver)).second)
-	{
-		const game_driver *match = m_descriptions_map.find(m_current_driver->description)->second;
+	match = root().m_descriptions_map.find(m_current_driver->description)->second;
+	if (match != m_current_driver)
 		osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(match->source_file).c_str(), match->name);
-	}
 
 	// determine if we are a clone
 	bool is_clone = (strcmp(m_current_driver->parent, "0") != 0);
@@ -1017,6 +1149,17 @@ void validity_checker::build_output_prefix(std::string &str)
 
 void validity_checker::output_callback(osd_output_channel channel, const char *msg, va_list args)
 {
+	// messages from a worker thread belong to the driver it is checking
+	if (m_parent == nullptr)
+	{
+		validity_checker *checker = thread_checker();
+		if (checker != nullptr)
+		{
+			checker->output_callback(channel, msg, args);
+			return;
+		}
+	}
+
 	std::string output;
 	switch (channel)
 	{
@@ -1054,11 +1197,51 @@ void validity_checker::output_callback(osd_output_channel channel, const char *m
 			m_verbose_text.append(output);
 			break;
 		default:
-			chain_output(channel, msg, args);
+			root().chain_output(channel, msg, args);
 			break;
 	}
 }
 
+
+//-------------------------------------------------
+//  thread_checker - return the worker checker
+//  running on the calling thread, if any
+//-------------------------------------------------
+
+validity_checker *validity_checker::thread_checker()
+{
+	std::lock_guard<std::mutex> guard(m_lock);
+	auto found = m_thread_checkers.find(std::this_thread::get_id());
+	return (found != m_thread_checkers.end()) ? found->second : nullptr;
+}
+
+
+//-------------------------------------------------
+//  already_checked - note that something has
+//  been checked, returning false if it already
+//  was
+//-------------------------------------------------
+
+bool validity_checker::already_checked(const char *string)
+{
+	// only the first time a driver asks can be the first time overall
+	if (!m_checked_here.insert(string).second)
+		return false;
+
+	// the earliest driver in output order to ask wins, whichever thread got there first
+	bool first;
+	{
+		validity_checker &shared = root();
+		std::lock_guard<std::mutex> guard(shared.m_lock);
+		auto found = shared.m_already_checked.emplace(string, m_current_order);
+		if (found.first->second > m_current_order)
+			found.first->second = m_current_order;
+		first = (found.first->second == m_current_order);
+	}
+	m_checked.push_back(std::make_pair(std::string(string), first));
+	return first;
+}
+
 //-------------------------------------------------
 //  output_via_delegate - helper to output a
 //  message via a varargs string, so the argptr
@@ -1076,14 +1259,15 @@ void validity_checker::output_via_delegate(osd_output_channel channel, const cha
 }
 
 //-------------------------------------------------
-//  output_indented_errors - helper to output error
+//  append_indented_errors - helper to add error
 //  and warning messages with header and indents
+//  to a report
 //-------------------------------------------------
-void validity_checker::output_indented_errors(std::string &text, const char *header)
+void validity_checker::append_indented_errors(std::string &report, std::string &text, const char *header)
 {
 	// remove trailing newline
 	if (text[text.size()-1] == '\n')
 		text.erase(text.size()-1, 1);
 	strreplace(text, "\n", "\n   ");
-	output_via_delegate(OSD_OUTPUT_CHANNEL_ERROR, "%s:\n   %s\n", header, text.c_str());
+	report.append(header).append(":\n   ").append(text).append("\n");
 }
@@ -16,6 +16,11 @@
 #include "emu.h"
 #include "drivenum.h"
 
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -32,6 +37,18 @@ class validity_checker : public osd_output
 	typedef std::unordered_map<std::string,const game_driver *> game_driver_map;
 	typedef std::unordered_map<std::string,FPTR> int_map;
 
+	// a driver checked on a worker thread
+	struct job
+	{
+		validity_checker *      m_owner;
+		const game_driver *     m_driver;
+		int                     m_order;        // position in the order of output
+		int                     m_errors;
+		int                     m_warnings;
+		std::string             m_report;       // text to output, empty if nothing to say
+		std::vector<std::pair<std::string, bool>> m_checked; // already_checked answers given
+	};
+
 public:
 	validity_checker(emu_options &options);
 	~validity_checker();
@@ -52,8 +69,9 @@ public:
 	void validate_tag(const char *tag);
 	int region_length(const char *tag) { return m_region_map.find(tag)->second; }
 
-	// generic registry of already-checked stuff
-	bool already_checked(const char *string) { return m_already_checked.insert(string).second; }
+	// generic registry of already-checked stuff, shared by all threads; the
+	// first driver in output order to ask gets true, as in a serial run
+	bool already_checked(const char *string);
 
 	// osd_output interface
 
@@ -61,14 +79,20 @@ protected:
 	virtual void output_callback(osd_output_channel channel, const char *msg, va_list args) override;
 
 private:
+	// construction for worker threads
+	validity_checker(validity_checker &parent);
+
 	// internal helpers
+	validity_checker &root() { return (m_parent != nullptr) ? *m_parent : *this; }
 	const char *ioport_string_from_index(UINT32 index);
 	int get_defstr_index(const char *string, bool suppress_error = false);
 
 	// core helpers
 	void validate_begin();
 	void validate_end();
-	void validate_one(const game_driver &driver);
+	void validate_one(const game_driver &driver, std::string &report);
+	void validate_drivers(const std::vector<int> &drivers);
+	static void *validate_job_static(void *param, int threadid);
 
 	// internal sub-checks
 	void validate_core();
@@ -84,7 +108,8 @@ private:
 	// output helpers
 	void build_output_prefix(std::string &str);
 	void output_via_delegate(osd_output_channel channel, const char *format, ...) ATTR_PRINTF(3,4);
-	void output_indented_errors(std::string &text, const char *header);
+	void append_indented_errors(std::string &report, std::string &text, const char *header);
+	validity_checker *thread_checker();
 
 	// internal driver list
 	driver_enumerator       m_drivlist;
@@ -109,8 +134,16 @@ private:
 	const device_t *        m_current_device;
 	const char *            m_current_ioport;
 	int_map                 m_region_map;
-	std::unordered_set<std::string>   m_already_checked;
-
+	int                     m_current_order;
+	std::unordered_map<std::string, int> m_already_checked; // first driver to ask, by order
+	std::unordered_set<std::string> m_checked_here;         // asked by the current driver
+	std::vector<std::pair<std::string, bool>> m_checked;    // answers given to the current driver
+
+	// parallel checking; workers share the maps above through m_parent
+	validity_checker *      m_parent;
+	std::mutex              m_lock;
+	std::unordered_map<std::thread::id, validity_checker *> m_thread_checkers;
+	std::unique_ptr<validity_checker> m_worker[WORK_MAX_THREADS + 1];
 };
 
 #endif
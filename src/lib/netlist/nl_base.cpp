@@ -95,10 +95,11 @@ void queue_t::on_pre_save()
 	netlist().log().debug("on_pre_save\n");
 	m_qsize = this->count();
 	netlist().log().debug("current time {1} qsize {2}\n", netlist().time().as_double(), m_qsize);
+	const entry_t *list = this->listptr();
 	for (int i = 0; i < m_qsize; i++ )
 	{
-		m_times[i] =  this->listptr()[i].exec_time().as_raw();
-		pstring p = this->listptr()[i].object()->name();
+		m_times[i] =  list[i].exec_time().as_raw();
+		pstring p = list[i].object()->name();
 		int n = p.len();
 		n = std::min(63, n);
 		std::strncpy(m_names[i].m_buf, p.cstr(), n);
@@ -172,6 +173,10 @@ ATTR_COLD void device_object_t::init_object(core_device_t &dev,
 
 netlist_t::netlist_t()
 	:   object_t(NETLIST, GENERIC), pstate_manager_t(),
+#if (NL_KEEP_STATISTICS)
+		m_perf_out_processed(0),
+		m_perf_queue_pushes(0),
+#endif
 		m_stop(netlist_time::zero),
 		m_time(netlist_time::zero),
 		m_use_deactivate(0),
@@ -660,7 +665,7 @@ ATTR_COLD void net_t::save_register()
 
 ATTR_HOT /* inline */ void core_terminal_t::update_dev(const UINT32 mask)
 {
-	inc_stat(netdev().stat_call_count);
+	inc_stat(device().stat_call_count);
 	if ((state() & mask) != 0)
 	{
 		device().update_dev();
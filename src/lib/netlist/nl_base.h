@@ -1047,7 +1047,7 @@ namespace netlist
 
 	#if (NL_KEEP_STATISTICS)
 		/* stats */
-		osd_ticks_t stat_total_time;
+		INT64 stat_total_time;
 		INT32 stat_update_count;
 		INT32 stat_call_count;
 	#endif
@@ -1248,9 +1248,8 @@ namespace netlist
 
 	#if (NL_KEEP_STATISTICS)
 		// performance
-		int m_perf_out_processed;
-		int m_perf_inp_processed;
-		int m_perf_inp_active;
+		INT64 m_perf_out_processed;
+		INT64 m_perf_queue_pushes;
 	#endif
 
 	private:
@@ -1398,6 +1397,7 @@ namespace netlist
 
 	ATTR_HOT inline void netlist_t::push_to_queue(net_t &out, const netlist_time &attime)
 	{
+		add_to_stat(m_perf_queue_pushes, 1);
 		m_queue.push(queue_t::entry_t(attime, &out));
 	}
 
@@ -89,6 +89,19 @@
 #define NL_FCONST(x) x
 
 
+//============================================================
+//  Queue defines
+//============================================================
+
+/* Use a binary heap for the event queue instead of a sorted list.
+ * The list wins as long as only a few dozen events are pending, which
+ * covers pong; the heap pulls ahead at a couple of hundred.
+ * "nltool -c queuebench" compares the two.
+ */
+#if !defined(NL_USE_HEAP_QUEUE)
+#define NL_USE_HEAP_QUEUE       (0)
+#endif
+
 //============================================================
 //  Solver defines
 //============================================================
@@ -105,7 +118,11 @@
 //============================================================
 
 #define NL_DEBUG                    (false)
+
+/* per device and queue counters, reported by "nltool -c bench" */
+#ifndef NL_KEEP_STATISTICS
 #define NL_KEEP_STATISTICS          (0)
+#endif
 
 //============================================================
 //  General Macros
@@ -122,7 +139,17 @@
 //============================================================
 
 #if NL_KEEP_STATISTICS
+#if (PSTANDALONE)
+/* no eminline.h here, use the time stamp counter where we know it */
+#include <ctime>
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+static inline INT64 get_profile_ticks() { return (INT64) __builtin_ia32_rdtsc(); }
+#else
+static inline INT64 get_profile_ticks() { return (INT64) std::clock(); }
+#endif
+#else
 #include "eminline.h"
+#endif
 #define add_to_stat(v,x)        do { v += (x); } while (0)
 #define inc_stat(v)             add_to_stat(v, 1)
 #define begin_timing(v)         do { v -= get_profile_ticks(); } while (0)
@@ -10,6 +10,8 @@
 #ifndef NLLISTS_H_
 #define NLLISTS_H_
 
+#include <algorithm>
+
 #include "nl_config.h"
 #include "plib/plists.h"
 
@@ -19,10 +21,12 @@
 
 namespace netlist
 {
+	// sorted list; push is an insertion sort, pop takes the last element
+
 	template <class _Element, class _Time>
-	class timed_queue
+	class timed_queue_linear
 	{
-		P_PREVENT_COPYING(timed_queue)
+		P_PREVENT_COPYING(timed_queue_linear)
 	public:
 
 		class entry_t
@@ -45,7 +49,7 @@ namespace netlist
 			_Element m_object;
 		};
 
-		timed_queue(unsigned list_size)
+		timed_queue_linear(unsigned list_size)
 		: m_list(list_size)
 		{
 	#if HAS_OPENMP && USE_OPENMP
@@ -153,6 +157,189 @@ namespace netlist
 
 	};
 
+	// binary heap; entries with equal times pop in the same order as
+	// with timed_queue_linear, i.e. the one pushed last comes out first
+
+	template <class _Element, class _Time>
+	class timed_queue_heap
+	{
+		P_PREVENT_COPYING(timed_queue_heap)
+	public:
+
+		typedef typename timed_queue_linear<_Element, _Time>::entry_t entry_t;
+
+		timed_queue_heap(unsigned list_size)
+		: m_heap(list_size), m_sorted(list_size)
+		{
+	#if HAS_OPENMP && USE_OPENMP
+			m_lock = 0;
+	#endif
+			clear();
+		}
+
+		ATTR_HOT  std::size_t capacity() const { return m_heap.size(); }
+		ATTR_HOT  bool is_empty() const { return (m_count == 0); }
+		ATTR_HOT  bool is_not_empty() const { return (m_count > 0); }
+
+		ATTR_HOT void push(const entry_t &e)
+		{
+	#if HAS_OPENMP && USE_OPENMP
+			/* Lock */
+			while (atomic_exchange32(&m_lock, 1)) { }
+	#endif
+			sift_up(m_count++, node_t(e, m_seq++));
+			inc_stat(m_prof_call);
+	#if HAS_OPENMP && USE_OPENMP
+			m_lock = 0;
+	#endif
+		}
+
+		ATTR_HOT  const entry_t *pop()
+		{
+			m_popped = m_heap[0].m_entry;
+			if (--m_count > 0)
+				sift_down(0, m_heap[m_count]);
+			return &m_popped;
+		}
+
+		ATTR_HOT  const entry_t *peek() const
+		{
+			return &m_heap[0].m_entry;
+		}
+
+		ATTR_HOT  void remove(const _Element &elem)
+		{
+			/* Lock */
+	#if HAS_OPENMP && USE_OPENMP
+			while (atomic_exchange32(&m_lock, 1)) { }
+	#endif
+			for (unsigned i = 0; i < m_count; i++)
+			{
+				if (m_heap[i].m_entry.object() == elem)
+				{
+					/* move the last node into the hole and restore the heap */
+					if (i < --m_count)
+					{
+						if (i > 0 && before(m_heap[m_count], m_heap[(i - 1) / 2]))
+							sift_up(i, m_heap[m_count]);
+						else
+							sift_down(i, m_heap[m_count]);
+					}
+					break;
+				}
+			}
+	#if HAS_OPENMP && USE_OPENMP
+			m_lock = 0;
+	#endif
+		}
+
+		ATTR_COLD void clear()
+		{
+			m_count = 0;
+			m_seq = 0;
+		}
+
+		// save state support & mame disasm
+		// the entries are presented in timed_queue_linear order, so
+		// pushing them back in sequence recreates the same queue
+
+		ATTR_COLD  const entry_t *listptr() const
+		{
+			parray_t<node_t> nodes(m_count);
+			for (unsigned i = 0; i < m_count; i++)
+				nodes[i] = m_heap[i];
+			std::sort(nodes.data(), nodes.data() + m_count, later);
+			for (unsigned i = 0; i < m_count; i++)
+				m_sorted[i] = nodes[i].m_entry;
+			return &m_sorted[0];
+		}
+		ATTR_HOT  int count() const { return m_count; }
+		ATTR_COLD  const entry_t & operator[](const int & index) const { return listptr()[index]; }
+
+	#if (NL_KEEP_STATISTICS)
+		// profiling
+		INT32   m_prof_sortmove;
+		INT32   m_prof_call;
+	#endif
+
+	private:
+
+		struct node_t
+		{
+			node_t() : m_entry(), m_seq(0) {}
+			node_t(const entry_t &e, UINT64 seq) : m_entry(e), m_seq(seq) {}
+
+			entry_t m_entry;
+			UINT64  m_seq;
+		};
+
+		static inline bool before(const node_t &a, const node_t &b)
+		{
+			if (a.m_entry.exec_time() < b.m_entry.exec_time())
+				return true;
+			if (b.m_entry.exec_time() < a.m_entry.exec_time())
+				return false;
+			return a.m_seq > b.m_seq;
+		}
+
+		static bool later(const node_t &a, const node_t &b) { return before(b, a); }
+
+		ATTR_HOT void sift_up(unsigned i, const node_t n)
+		{
+			while (i > 0)
+			{
+				const unsigned parent = (i - 1) / 2;
+				if (!before(n, m_heap[parent]))
+					break;
+				m_heap[i] = m_heap[parent];
+				i = parent;
+				inc_stat(m_prof_sortmove);
+			}
+			m_heap[i] = n;
+		}
+
+		ATTR_HOT void sift_down(unsigned i, const node_t n)
+		{
+			unsigned child;
+			while ((child = 2 * i + 1) < m_count)
+			{
+				if (child + 1 < m_count && before(m_heap[child + 1], m_heap[child]))
+					child++;
+				if (!before(m_heap[child], n))
+					break;
+				m_heap[i] = m_heap[child];
+				i = child;
+				inc_stat(m_prof_sortmove);
+			}
+			m_heap[i] = n;
+		}
+
+	#if HAS_OPENMP && USE_OPENMP
+		volatile INT32 m_lock;
+	#endif
+		unsigned m_count;
+		UINT64 m_seq;
+		entry_t m_popped;
+		parray_t<node_t> m_heap;
+		mutable parray_t<entry_t> m_sorted;
+	};
+
+	// the implementation used by the netlist, see NL_USE_HEAP_QUEUE
+
+	template <bool _Heap, class _Element, class _Time>
+	struct timed_queue_select { typedef timed_queue_linear<_Element, _Time> type; };
+
+	template <class _Element, class _Time>
+	struct timed_queue_select<true, _Element, _Time> { typedef timed_queue_heap<_Element, _Time> type; };
+
+	template <class _Element, class _Time>
+	class timed_queue : public timed_queue_select<NL_USE_HEAP_QUEUE, _Element, _Time>::type
+	{
+	public:
+		timed_queue(unsigned list_size)
+		: timed_queue_select<NL_USE_HEAP_QUEUE, _Element, _Time>::type(list_size) { }
+	};
+
 }
 
 #endif /* NLLISTS_H_ */
@@ -870,7 +870,7 @@ void setup_t::print_stats() const
 		for (std::size_t i = 0; i < netlist().m_started_devices.size(); i++)
 		{
 			core_device_t *entry = netlist().m_started_devices[i];
-			printf("Device %20s : %12d %12d %15ld\n", entry->name(), entry->stat_call_count, entry->stat_update_count, (long int) entry->stat_total_time / (entry->stat_update_count + 1));
+			printf("Device %20s : %12d %12d %15ld\n", entry->name().cstr(), entry->stat_call_count, entry->stat_update_count, (long int) entry->stat_total_time / (entry->stat_update_count + 1));
 		}
 		printf("Queue Pushes %15d\n", netlist().queue().m_prof_call);
 		printf("Queue Moves  %15d\n", netlist().queue().m_prof_sortmove);
@@ -23,6 +23,15 @@ typedef __uint128_t UINT128;
 typedef __int128_t INT128;
 #endif
 
+/* std::thread and friends; the standalone build may still be C++98 */
+#ifndef PHAS_THREADS
+#if (__cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define PHAS_THREADS (1)
+#else
+#define PHAS_THREADS (0)
+#endif
+#endif
+
 
 #if !(PSTANDALONE)
 #include "osdcore.h"
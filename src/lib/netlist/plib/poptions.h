@@ -116,6 +116,25 @@ private:
 	double m_val;
 };
 
+class poption_long : public poption
+{
+public:
+	poption_long(pstring ashort, pstring along, long defval, pstring help, poptions *parent = NULL)
+	: poption(ashort, along, help, true, parent), m_val(defval)
+	{}
+
+	virtual int parse(pstring argument) override
+	{
+		bool err = false;
+		m_val = argument.as_long(&err);
+		return (err ? 1 : 0);
+	}
+
+	long operator ()() { return m_val; }
+private:
+	long m_val;
+};
+
 class poptions
 {
 public:
@@ -0,0 +1,130 @@
+// license:GPL-2.0+
+// copyright-holders:MAMEdev Team
+/*
+ * pthreadpool.cpp
+ *
+ */
+
+#include "pthreadpool.h"
+
+#if (PHAS_THREADS)
+
+/* polls of m_generation before an idle worker parks */
+static const unsigned SPIN_COUNT = 20000;
+
+pthreadpool_t::pthreadpool_t(unsigned threads)
+: m_generation(0), m_parked(0), m_busy(0), m_next(0), m_exit(false),
+	m_count(0), m_func(NULL), m_param(NULL)
+{
+	unsigned cores = std::thread::hardware_concurrency();
+	if (cores == 0)
+		cores = 1;
+	if (threads == 0 || threads > cores)
+		threads = cores;
+	for (unsigned i = 1; i < threads; i++)
+		m_threads.push_back(std::thread(&pthreadpool_t::worker, this));
+}
+
+pthreadpool_t::~pthreadpool_t()
+{
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_exit = true;
+		m_generation++;
+	}
+	m_wake.notify_all();
+	for (std::size_t i = 0; i < m_threads.size(); i++)
+		m_threads[i].join();
+}
+
+unsigned pthreadpool_t::size() const
+{
+	return m_threads.size() + 1;
+}
+
+void pthreadpool_t::dispatch(const std::size_t count, job_func_t func, void *param)
+{
+	if (m_threads.size() == 0 || count < 2)
+	{
+		for (std::size_t i = 0; i < count; i++)
+			func(param, i);
+		return;
+	}
+
+	m_func = func;
+	m_param = param;
+	m_count = count;
+	m_next = 0;
+	m_busy = m_threads.size();
+	m_generation++;
+
+	/* a worker that parks after this sees the new generation first */
+	if (m_parked > 0)
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_wake.notify_all();
+	}
+
+	work();
+
+	for (unsigned spin = 0; m_busy > 0; spin++)
+		if (spin >= SPIN_COUNT)
+			std::this_thread::yield();
+}
+
+void pthreadpool_t::work()
+{
+	std::size_t i;
+	while ((i = m_next++) < m_count)
+		m_func(m_param, i);
+}
+
+void pthreadpool_t::worker()
+{
+	/* no job can have been dispatched before the pool was constructed */
+	unsigned seen = 0;
+
+	for (;;)
+	{
+		for (unsigned spin = 0; spin < SPIN_COUNT && m_generation == seen; spin++)
+			;
+		if (m_generation == seen)
+		{
+			std::unique_lock<std::mutex> guard(m_lock);
+			m_parked++;
+			while (m_generation == seen)
+				m_wake.wait(guard);
+			m_parked--;
+		}
+		if (m_exit)
+			return;
+
+		/* the caller waits for us, so this can't skip a generation */
+		seen = m_generation;
+		work();
+		m_busy--;
+	}
+}
+
+#else
+
+pthreadpool_t::pthreadpool_t(unsigned threads)
+{
+}
+
+pthreadpool_t::~pthreadpool_t()
+{
+}
+
+unsigned pthreadpool_t::size() const
+{
+	return 1;
+}
+
+void pthreadpool_t::dispatch(const std::size_t count, job_func_t func, void *param)
+{
+	for (std::size_t i = 0; i < count; i++)
+		func(param, i);
+}
+
+#endif
@@ -0,0 +1,74 @@
+// license:GPL-2.0+
+// copyright-holders:MAMEdev Team
+/*
+ * pthreadpool.h
+ *
+ */
+
+#ifndef PTHREADPOOL_H_
+#define PTHREADPOOL_H_
+
+#include "pconfig.h"
+
+#if (PHAS_THREADS)
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+// ----------------------------------------------------------------------------------------
+// pthreadpool_t: persistent workers for short fork/join jobs
+//
+// run() hands the indices 0 .. count-1 to the workers and the calling
+// thread and returns once all of them are done. Jobs are expected to
+// follow each other within microseconds, so idle workers spin for a
+// while before they park on a condition variable.
+// Without thread support everything runs on the caller.
+// ----------------------------------------------------------------------------------------
+
+class pthreadpool_t
+{
+	P_PREVENT_COPYING(pthreadpool_t)
+public:
+	/* threads includes the caller; 0 sizes the pool to the host */
+	pthreadpool_t(unsigned threads = 0);
+	~pthreadpool_t();
+
+	/* number of threads taking part in run() */
+	unsigned size() const;
+
+	template <typename F>
+	void run(const std::size_t count, F &func)
+	{
+		dispatch(count, &call<F>, &func);
+	}
+
+private:
+	typedef void (*job_func_t)(void *param, const std::size_t index);
+
+	template <typename F>
+	static void call(void *param, const std::size_t index) { (*static_cast<F *>(param))(index); }
+
+	void dispatch(const std::size_t count, job_func_t func, void *param);
+
+#if (PHAS_THREADS)
+	void worker();
+	void work();
+
+	std::vector<std::thread> m_threads;
+	std::mutex m_lock;
+	std::condition_variable m_wake;
+	std::atomic<unsigned> m_generation;     /* bumped for every job */
+	std::atomic<unsigned> m_parked;         /* workers waiting on m_wake */
+	std::atomic<unsigned> m_busy;           /* workers still on the current job */
+	std::atomic<std::size_t> m_next;        /* next index to hand out */
+	std::atomic<bool> m_exit;
+	std::size_t m_count;
+	job_func_t m_func;
+	void *m_param;
+#endif
+};
+
+#endif /* PTHREADPOOL_H_ */
@@ -9,6 +9,11 @@
 ****************************************************************************/
 
 #include <cstdio>
+#include <cstdlib>
+#include <typeinfo>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
 
 #ifdef PSTANDALONE
 #if (PSTANDALONE)
@@ -24,6 +29,7 @@
 #include "nl_factory.h"
 #include "nl_parser.h"
 #include "devices/net_lib.h"
+#include "solver/nld_solver.h"
 #include "tools/nl_convert.h"
 
 
@@ -100,11 +106,12 @@ public:
 	tool_options_t() :
 		poptions(),
 		opt_ttr ("t", "time_to_run", 1.0,   "time to run the emulation (seconds)", this),
+		opt_reps("r", "repeat",      5,     "number of runs for bench", this),
 		opt_name("n", "name",        "",      "netlist in file to run; default is first one", this),
 		opt_logs("l", "logs",        "",      "colon separated list of terminals to log", this),
 		opt_file("f", "file",        "-",     "file to process (default is stdin)", this),
 		opt_type("y", "type",        "spice", "spice:eagle", "type of file to be converted: spice,eagle", this),
-		opt_cmd ("c", "cmd",         "run",   "run|convert|listdevices", this),
+		opt_cmd ("c", "cmd",         "run",   "run|convert|listdevices|queuebench|static|bench", this),
 		opt_inp( "i", "input",       "",      "input file to process (default is none)", this),
 		opt_verb("v", "verbose",              "be verbose - this produces lots of output", this),
 		opt_quiet("q", "quiet",               "be quiet - no warnings", this),
@@ -112,6 +119,7 @@ public:
 	{}
 
 	poption_double opt_ttr;
+	poption_long   opt_reps;
 	poption_str    opt_name;
 	poption_str    opt_logs;
 	poption_str    opt_file;
@@ -192,6 +200,11 @@ public:
 
 	tool_options_t *m_opts;
 
+#if (NL_KEEP_STATISTICS)
+	INT64 perf_events() const { return m_perf_out_processed; }
+	INT64 perf_queue_pushes() const { return m_perf_queue_pushes; }
+#endif
+
 protected:
 
 	void vlog(const plog_level &l, const pstring &ls) const override
@@ -279,6 +292,22 @@ plist_t<input_t> *read_input(netlist::netlist_t *netlist, pstring fname)
 	return ret;
 }
 
+static void process_inputs(netlist_tool_t &nt, plist_t<input_t> *inps, double ttr)
+{
+	unsigned pos = 0;
+	netlist::netlist_time nlt = netlist::netlist_time::zero;
+
+	while (pos < inps->size() && (*inps)[pos].m_time < netlist::netlist_time::from_double(ttr))
+	{
+		nt.process_queue((*inps)[pos].m_time - nlt);
+		(*inps)[pos].setparam();
+		nlt = (*inps)[pos].m_time;
+		pos++;
+	}
+	nt.process_queue(netlist::netlist_time::from_double(ttr) - nlt);
+	nt.stop();
+}
+
 static void run(tool_options_t &opts)
 {
 	netlist_tool_t nt;
@@ -302,24 +331,264 @@ static void run(tool_options_t &opts)
 	pout("runnning ...\n");
 	t = osd_ticks();
 
-	unsigned pos = 0;
-	netlist::netlist_time nlt = netlist::netlist_time::zero;
-
-	while (pos < inps->size() && (*inps)[pos].m_time < netlist::netlist_time::from_double(ttr))
-	{
-		nt.process_queue((*inps)[pos].m_time - nlt);
-		(*inps)[pos].setparam();
-		nlt = (*inps)[pos].m_time;
-		pos++;
-	}
-	nt.process_queue(netlist::netlist_time::from_double(ttr) - nlt);
-	nt.stop();
+	process_inputs(nt, inps, ttr);
 	pfree(inps);
 
 	double emutime = (double) (osd_ticks() - t) / (double) osd_ticks_per_second();
 	pout("{1:f} seconds emulation took {2:f} real time ==> {3:5.2f}%\n", ttr, emutime, ttr/emutime*100.0);
 }
 
+/*-------------------------------------------------
+    bench - run a netlist several times and print
+    tab separated records for tracking performance
+
+    run     <n> <seconds> <events> <queue pushes>
+    solver  <name> <nets> <vsolve calls> <calculations>
+            <newton loops> <gs loops> <gs fails> <ticks>
+    device  <type> <instances> <updates> <calls> <ticks>
+
+    solver and device records are totals over all
+    runs. Events, pushes, device records and ticks
+    need a build with NL_KEEP_STATISTICS=1; "-" is
+    printed where a value is not available.
+-------------------------------------------------*/
+
+struct bench_solver_t
+{
+	bench_solver_t() : nets(0), vsolver_calls(0), calculations(0), newton_raphson(0),
+		iterative_total(0), iterative_fail(0), ticks(0) { }
+
+	pstring name;
+	unsigned nets;
+	INT64 vsolver_calls;
+	INT64 calculations;
+	INT64 newton_raphson;
+	INT64 iterative_total;
+	INT64 iterative_fail;
+	INT64 ticks;
+};
+
+struct bench_device_t
+{
+	bench_device_t() : instances(0), updates(0), calls(0), ticks(0) { }
+
+	pstring name;
+	INT64 instances;
+	INT64 updates;
+	INT64 calls;
+	INT64 ticks;
+};
+
+template <class T>
+static T &bench_entry(plist_t<T> &list, const pstring &key)
+{
+	for (std::size_t i = 0; i < list.size(); i++)
+		if (list[i].name == key)
+			return list[i];
+	T e;
+	e.name = key;
+	list.add(e);
+	return list[list.size() - 1];
+}
+
+#if (NL_KEEP_STATISTICS)
+static pstring device_type(const netlist::core_device_t *dev)
+{
+	pstring ret(typeid(*dev).name());
+#if defined(__GNUC__)
+	int status = 0;
+	char *dm = abi::__cxa_demangle(typeid(*dev).name(), NULL, NULL, &status);
+	if (dm != NULL)
+	{
+		ret = pstring(dm).replace("netlist::devices::", "").replace("netlist::", "");
+		free(dm);
+	}
+#endif
+	return ret;
+}
+#endif
+
+static pstring bench_value(const INT64 v)
+{
+	return NL_KEEP_STATISTICS ? pstring(pfmt("{1}")(v)) : pstring("-");
+}
+
+static void bench(tool_options_t &opts)
+{
+	const double ttr = opts.opt_ttr();
+	const long reps = opts.opt_reps();
+	plist_t<bench_solver_t> solvers;
+	plist_t<bench_device_t> devices;
+
+	pout("# file\t{1}\tnetlist\t{2}\ttime\t{3}\truns\t{4}\n",
+			opts.opt_file(), opts.opt_name(), ttr, reps);
+	pout("# run\tn\tseconds\tevents\tqueue_pushes\n");
+
+	for (long r = 0; r < reps; r++)
+	{
+		netlist_tool_t nt;
+
+		nt.m_opts = &opts;
+		nt.init();
+		nt.log().verbose.set_enabled(false);
+		nt.log().warning.set_enabled(false);
+
+		nt.read_netlist(opts.opt_file(), opts.opt_name());
+		plist_t<input_t> *inps = read_input(&nt, opts.opt_inp());
+
+		osd_ticks_t t = osd_ticks();
+		process_inputs(nt, inps, ttr);
+		double emutime = (double) (osd_ticks() - t) / (double) osd_ticks_per_second();
+		pfree(inps);
+
+#if (NL_KEEP_STATISTICS)
+		pout("run\t{1}\t{2:f}\t{3}\t{4}\n", r, emutime,
+				bench_value(nt.perf_events()), bench_value(nt.perf_queue_pushes()));
+#else
+		pout("run\t{1}\t{2:f}\t-\t-\n", r, emutime);
+#endif
+
+		netlist::devices::NETLIB_NAME(solver) *solver =
+				nt.get_single_device<netlist::devices::NETLIB_NAME(solver)>("solver");
+		if (solver != NULL)
+		{
+			const netlist::devices::matrix_solver_t::list_t &ms = solver->solvers();
+			for (std::size_t i = 0; i < ms.size(); i++)
+			{
+				bench_solver_t &s = bench_entry(solvers, ms[i]->name());
+				s.nets = ms[i]->stat_nets();
+				s.vsolver_calls += ms[i]->stat_vsolver_calls();
+				s.calculations += ms[i]->stat_calculations();
+				s.newton_raphson += ms[i]->stat_newton_raphson();
+				s.iterative_total += ms[i]->stat_iterative_total();
+				s.iterative_fail += ms[i]->stat_iterative_fail();
+				s.ticks += ms[i]->stat_solve_time();
+			}
+		}
+
+#if (NL_KEEP_STATISTICS)
+		for (std::size_t i = 0; i < nt.m_started_devices.size(); i++)
+		{
+			netlist::core_device_t *dev = nt.m_started_devices[i];
+			bench_device_t &d = bench_entry(devices, device_type(dev));
+			d.instances++;
+			d.updates += dev->stat_update_count;
+			d.calls += dev->stat_call_count;
+			d.ticks += dev->stat_total_time;
+		}
+#endif
+	}
+
+	pout("# solver\tname\tnets\tvsolve_calls\tcalculations\tnewton_loops\tgs_loops\tgs_fails\tticks\n");
+	for (std::size_t i = 0; i < solvers.size(); i++)
+	{
+		const bench_solver_t &s = solvers[i];
+		pout("{1}\n", pstring(pfmt("solver\t{1}\t{2}\t{3}\t{4}\t{5}\t{6}\t{7}\t{8}")
+				(s.name)(s.nets)(s.vsolver_calls)(s.calculations)(s.newton_raphson)
+				(s.iterative_total)(s.iterative_fail)(bench_value(s.ticks))));
+	}
+
+	pout("# device\ttype\tinstances\tupdates\tcalls\tticks\n");
+#if !(NL_KEEP_STATISTICS)
+	pout("# event, device and tick counters need a build with NL_KEEP_STATISTICS=1\n");
+#endif
+	for (std::size_t i = 0; i < devices.size(); i++)
+	{
+		const bench_device_t &d = devices[i];
+		pout("device\t{1}\t{2}\t{3}\t{4}\t{5}\n", d.name, d.instances,
+				d.updates, d.calls, d.ticks);
+	}
+}
+
+/*-------------------------------------------------
+    static_solvers - write code for the sparse
+    matrix groups of a netlist, see nld_ms_static.cpp
+-------------------------------------------------*/
+
+static void static_solvers(tool_options_t &opts)
+{
+	netlist_tool_t nt;
+
+	nt.m_opts = &opts;
+	nt.init();
+
+	/* log output goes to stdout as well */
+	nt.log().verbose.set_enabled(false);
+	nt.log().warning.set_enabled(false);
+
+	nt.read_netlist(opts.opt_file(), opts.opt_name());
+
+	netlist::devices::NETLIB_NAME(solver) *solver =
+			nt.get_single_device<netlist::devices::NETLIB_NAME(solver)>("solver");
+	if (solver == NULL)
+		throw netlist::fatalerror_e("netlist has no solver\n");
+	solver->create_solver_code(pout_strm);
+}
+
+/*-------------------------------------------------
+    queuebench - time both event queue variants
+    on the same synthetic load
+-------------------------------------------------*/
+
+class queuebench_rnd
+{
+public:
+	queuebench_rnd() : m_seed(0x12345678) { }
+	unsigned operator()() { m_seed = m_seed * 1103515245 + 12345; return (m_seed >> 16) & 0x7fff; }
+
+	// gate delays of a few discrete values, so equal times are common
+	netlist::netlist_time delay() { return netlist::netlist_time::from_nsec(10 + ((*this)() & 3) * 5); }
+
+private:
+	UINT32 m_seed;
+};
+
+template <class _Queue>
+static double queuebench_run(unsigned size, unsigned iterations, UINT64 &checksum)
+{
+	typedef typename _Queue::entry_t entry_t;
+	_Queue q(size + 1);
+	queuebench_rnd rnd;
+
+	for (unsigned i = 0; i < size; i++)
+		q.push(entry_t(netlist::netlist_time::from_nsec(rnd() % 100), i + 1));
+
+	checksum = 0;
+	osd_ticks_t t = osd_ticks();
+	for (unsigned i = 0; i < iterations; i++)
+	{
+		const entry_t e = *q.pop();
+		checksum = checksum * 31 + e.object() + (UINT64) e.exec_time().as_raw();
+		q.push(entry_t(e.exec_time() + rnd.delay(), e.object()));
+
+		// every so often an output changes again before its event fires
+		if ((i & 7) == 0)
+		{
+			unsigned obj = rnd() % size + 1;
+			q.remove(obj);
+			q.push(entry_t(e.exec_time() + rnd.delay(), obj));
+		}
+	}
+	return (double) (osd_ticks() - t) / (double) osd_ticks_per_second();
+}
+
+static void queuebench()
+{
+	static const unsigned sizes[] = { 4, 16, 64, 256 };
+	const unsigned iterations = 10000000;
+
+	pout("{1} events per queue size\n", iterations);
+	for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+	{
+		const unsigned size = sizes[i];
+		UINT64 sum_linear, sum_heap;
+		double t_linear = queuebench_run<netlist::timed_queue_linear<unsigned, netlist::netlist_time> >(size, iterations, sum_linear);
+		double t_heap = queuebench_run<netlist::timed_queue_heap<unsigned, netlist::netlist_time> >(size, iterations, sum_heap);
+		pout("size {1:3}: linear {2:6.3f}s heap {3:6.3f}s ==> {4:5.2f}x {5}\n", size, t_linear, t_heap,
+				t_linear / t_heap, (sum_linear == sum_heap) ? "" : "ORDER MISMATCH");
+	}
+}
+
 /*-------------------------------------------------
     listdevices - list all known devices
 -------------------------------------------------*/
@@ -418,6 +687,12 @@ int main(int argc, char *argv[])
 		listdevices();
 	else if (cmd == "run")
 		run(opts);
+	else if (cmd == "queuebench")
+		queuebench();
+	else if (cmd == "static")
+		static_solvers(opts);
+	else if (cmd == "bench")
+		bench(opts);
 	else if (cmd == "convert")
 	{
 		pstring contents;
@@ -0,0 +1,377 @@
+// license:GPL-2.0+
+// copyright-holders:MAMEdev Team
+/*
+ * nld_ms_sparse.h
+ *
+ * Sparse LU solver
+ *
+ * vsetup() orders the nets by minimum degree and runs the elimination
+ * symbolically once. This yields the fill-in pattern in compressed row
+ * format and the list of operations the numeric factorization has to do.
+ * Per step only the numbers are refactored, the pattern never changes.
+ *
+ */
+
+#ifndef NLD_MS_SPARSE_H_
+#define NLD_MS_SPARSE_H_
+
+#include <algorithm>
+
+#include "solver/mat_cr.h"
+#include "solver/nld_ms_direct.h"
+#include "solver/nld_solver.h"
+
+NETLIB_NAMESPACE_DEVICES_START()
+
+template <unsigned m_N, unsigned _storage_N>
+class matrix_solver_sparse_t: public matrix_solver_direct_t<m_N, _storage_N>
+{
+public:
+
+	matrix_solver_sparse_t(const solver_parameters_t *params, const int size)
+		: matrix_solver_direct_t<m_N, _storage_N>(matrix_solver_t::GAUSSIAN_ELIMINATION, params, size)
+		, m_static(NULL)
+		{
+		}
+
+	virtual ~matrix_solver_sparse_t() {}
+
+	virtual void vsetup(analog_net_t::list_t &nets) override;
+	ATTR_HOT inline int vsolve_non_dynamic(const bool newton_raphson);
+
+	virtual pstring static_solver_name() override;
+	virtual void create_solver_code(postream &strm) override;
+protected:
+	ATTR_HOT virtual nl_double vsolve() override;
+
+private:
+	ATTR_COLD void order_min_degree();
+	ATTR_COLD void build_pattern();
+
+	ATTR_HOT void LU_factorize();
+
+	plist_t<int> m_term_cr[_storage_N];
+
+	/* numeric factorization, one entry per element left of the diagonal:
+	 * pk, diag(k), n, followed by n pairs of (i, j) <- (k, j) updates
+	 */
+	plist_t<unsigned> m_ops;
+
+	bool m_fill[_storage_N][_storage_N];
+
+	mat_cr_t<_storage_N> mat;
+
+	nl_double m_A[_storage_N * _storage_N];
+
+	static_solver_func_t m_static;
+};
+
+// ----------------------------------------------------------------------------------------
+// matrix_solver - sparse LU
+// ----------------------------------------------------------------------------------------
+
+template <unsigned m_N, unsigned _storage_N>
+void matrix_solver_sparse_t<m_N, _storage_N>::vsetup(analog_net_t::list_t &nets)
+{
+	matrix_solver_direct_t<m_N, _storage_N>::vsetup(nets);
+
+	order_min_degree();
+	build_pattern();
+
+	this->log().verbose("sparse LU: {1} nets, {2} elements after fill-in, {3} update ops",
+			this->N(), mat.nz_num, (unsigned) m_ops.size());
+
+	m_static = find_static_solver(static_solver_name());
+	if (m_static != NULL)
+		this->log().verbose("sparse LU: using static solver {1}", static_solver_name());
+}
+
+template <unsigned m_N, unsigned _storage_N>
+pstring matrix_solver_sparse_t<m_N, _storage_N>::static_solver_name()
+{
+	/* the pattern determines the elimination, so it is all the name needs */
+	UINT64 hash = U64(0xcbf29ce484222325);
+	for (unsigned k = 0; k <= this->N(); k++)
+		hash = (hash ^ mat.ia[k]) * U64(0x100000001b3);
+	for (unsigned k = 0; k < mat.nz_num; k++)
+		hash = (hash ^ mat.ja[k]) * U64(0x100000001b3);
+
+	return pfmt("nl_gcr_{1}_{2}_{3}")(this->N())(mat.nz_num).x(hash, "016");
+}
+
+template <unsigned m_N, unsigned _storage_N>
+void matrix_solver_sparse_t<m_N, _storage_N>::create_solver_code(postream &strm)
+{
+	const unsigned iN = this->N();
+
+	strm.writeline(pfmt("static void {1}(nl_double * RESTRICT m_A, nl_double * RESTRICT V)")(static_solver_name()));
+	strm.writeline("{");
+
+	/* factorization, see LU_factorize() */
+	const unsigned *op = m_ops.data();
+	const unsigned *e = op + m_ops.size();
+	for (unsigned fn = 0; op < e; fn++)
+	{
+		if (op[2] == 0)
+			strm.writeline(pfmt("\tm_A[{1}] = m_A[{2}] / m_A[{3}];")(op[0])(op[0])(op[1]));
+		else
+			strm.writeline(pfmt("\tconst nl_double f{1} = m_A[{2}] = m_A[{3}] / m_A[{4}];")(fn)(op[0])(op[0])(op[1]));
+		const unsigned *oe = op + 3 + 2 * op[2];
+		for (op += 3; op < oe; op += 2)
+			strm.writeline(pfmt("\tm_A[{1}] -= f{2} * m_A[{3}];")(op[0])(fn)(op[1]));
+	}
+
+	/* forward and back substitution, see mat_cr_t::solveLUx() */
+	for (unsigned i = 1; i < iN; i++)
+		for (unsigned j = mat.ia[i]; j < mat.diag[i]; j++)
+			strm.writeline(pfmt("\tV[{1}] -= m_A[{2}] * V[{3}];")(i)(j)(mat.ja[j]));
+	for (unsigned i = iN; i-- > 0; )
+	{
+		pstring line = pfmt("\tV[{1}] = (V[{2}]")(i)(i);
+		for (unsigned j = mat.diag[i] + 1; j < mat.ia[i + 1]; j++)
+			line += pfmt(" - m_A[{1}] * V[{2}]")(j)(mat.ja[j]);
+		line += pfmt(") / m_A[{1}];")(mat.diag[i]);
+		strm.writeline(line);
+	}
+
+	strm.writeline("}");
+}
+
+template <unsigned m_N, unsigned _storage_N>
+ATTR_COLD void matrix_solver_sparse_t<m_N, _storage_N>::order_min_degree()
+{
+	/*
+	 * Greedy minimum degree ordering. Eliminating a net connects all of
+	 * its remaining neighbours, so m_fill ends up holding the pattern of
+	 * L + U in the original numbering.
+	 */
+	const unsigned iN = this->N();
+	unsigned order[_storage_N];
+	bool done[_storage_N];
+
+	for (unsigned k = 0; k < iN; k++)
+	{
+		done[k] = false;
+		for (unsigned j = 0; j < iN; j++)
+			m_fill[k][j] = (j == k);
+	}
+	for (unsigned k = 0; k < iN; k++)
+	{
+		const int *other = this->m_terms[k]->net_other();
+		for (unsigned i = 0; i < this->m_terms[k]->m_railstart; i++)
+		{
+			m_fill[k][other[i]] = true;
+			m_fill[other[i]][k] = true;
+		}
+	}
+
+	for (unsigned p = 0; p < iN; p++)
+	{
+		unsigned best = iN;
+		unsigned best_deg = iN + 1;
+		for (unsigned k = 0; k < iN; k++)
+		{
+			if (done[k])
+				continue;
+			unsigned deg = 0;
+			for (unsigned j = 0; j < iN; j++)
+				if (!done[j] && m_fill[k][j])
+					deg++;
+			if (deg < best_deg)
+			{
+				best = k;
+				best_deg = deg;
+			}
+		}
+
+		order[p] = best;
+		done[best] = true;
+		for (unsigned i = 0; i < iN; i++)
+			if (!done[i] && m_fill[best][i])
+				for (unsigned j = 0; j < iN; j++)
+					if (!done[j] && m_fill[best][j])
+						m_fill[i][j] = true;
+	}
+
+	/* renumber the nets, m_fill follows */
+	terms_t *terms[_storage_N];
+	analog_net_t *anets[_storage_N];
+	bool fill[_storage_N][_storage_N];
+
+	for (unsigned k = 0; k < iN; k++)
+	{
+		terms[k] = this->m_terms[order[k]];
+		anets[k] = this->m_nets[order[k]];
+		for (unsigned j = 0; j < iN; j++)
+			fill[k][j] = m_fill[order[k]][order[j]];
+	}
+	for (unsigned k = 0; k < iN; k++)
+	{
+		this->m_terms[k] = terms[k];
+		this->m_nets[k] = anets[k];
+		for (unsigned j = 0; j < iN; j++)
+			m_fill[k][j] = fill[k][j];
+	}
+
+	for (unsigned k = 0; k < iN; k++)
+	{
+		int *other = this->m_terms[k]->net_other();
+		for (unsigned i = 0; i < this->m_terms[k]->count(); i++)
+			if (other[i] != -1)
+				other[i] = this->get_net_idx(&this->m_terms[k]->terms()[i]->m_otherterm->net());
+	}
+}
+
+template <unsigned m_N, unsigned _storage_N>
+ATTR_COLD void matrix_solver_sparse_t<m_N, _storage_N>::build_pattern()
+{
+	const unsigned iN = this->N();
+	unsigned nz = 0;
+
+	for (unsigned k = 0; k < iN; k++)
+	{
+		mat.ia[k] = nz;
+		for (unsigned j = 0; j < iN; j++)
+			if (m_fill[k][j])
+			{
+				mat.ja[nz] = j;
+				if (j == k)
+					mat.diag[k] = nz;
+				nz++;
+			}
+
+		/* build pointers into the compressed row format matrix for each terminal */
+		m_term_cr[k].clear();
+		for (unsigned i = 0; i < this->m_terms[k]->m_railstart; i++)
+		{
+			const int other = this->m_terms[k]->net_other()[i];
+			for (unsigned p = mat.ia[k]; p < nz; p++)
+				if ((int) mat.ja[p] == other)
+				{
+					m_term_cr[k].add(p);
+					break;
+				}
+		}
+		nl_assert(m_term_cr[k].size() == this->m_terms[k]->m_railstart);
+	}
+	mat.ia[iN] = nz;
+	mat.nz_num = nz;
+
+	/* replay the elimination on the pattern and record the element indices */
+	m_ops.clear();
+	for (unsigned i = 1; i < iN; i++)
+	{
+		for (unsigned pk = mat.ia[i]; pk < mat.diag[i]; pk++)
+		{
+			const unsigned k = mat.ja[pk];
+			m_ops.add(pk);
+			m_ops.add(mat.diag[k]);
+			const unsigned cnt_pos = m_ops.size();
+			m_ops.add(0);
+
+			unsigned pj = pk + 1;
+			for (unsigned pt = mat.diag[k] + 1; pt < mat.ia[k + 1]; pt++)
+			{
+				/* the fill-in guarantees (i, ja[pt]) exists */
+				while (mat.ja[pj] < mat.ja[pt])
+					pj++;
+				m_ops.add(pj);
+				m_ops.add(pt);
+				m_ops[cnt_pos]++;
+			}
+		}
+	}
+}
+
+template <unsigned m_N, unsigned _storage_N>
+ATTR_HOT void matrix_solver_sparse_t<m_N, _storage_N>::LU_factorize()
+{
+	/* in place, L has an implicit unit diagonal */
+	const unsigned * RESTRICT op = m_ops.data();
+	const unsigned * const RESTRICT e = op + m_ops.size();
+
+	while (op < e)
+	{
+		const unsigned pk = op[0];
+		const nl_double f = m_A[pk] = m_A[pk] / m_A[op[1]];
+		const unsigned * const RESTRICT oe = op + 3 + 2 * op[2];
+		for (op += 3; op < oe; op += 2)
+			m_A[op[0]] -= f * m_A[op[1]];
+	}
+}
+
+template <unsigned m_N, unsigned _storage_N>
+ATTR_HOT nl_double matrix_solver_sparse_t<m_N, _storage_N>::vsolve()
+{
+	this->solve_base(this);
+	return this->compute_next_timestep();
+}
+
+template <unsigned m_N, unsigned _storage_N>
+ATTR_HOT inline int matrix_solver_sparse_t<m_N, _storage_N>::vsolve_non_dynamic(const bool newton_raphson)
+{
+	const unsigned iN = this->N();
+
+	ATTR_ALIGN nl_double new_V[_storage_N];
+
+	for (unsigned i=0, e=mat.nz_num; i<e; i++)
+		m_A[i] = 0.0;
+
+	for (unsigned k = 0; k < iN; k++)
+	{
+		nl_double gtot_t = 0.0;
+		nl_double RHS_t = 0.0;
+
+		const unsigned term_count = this->m_terms[k]->count();
+		const unsigned railstart = this->m_terms[k]->m_railstart;
+		const nl_double * const RESTRICT gt = this->m_terms[k]->gt();
+		const nl_double * const RESTRICT go = this->m_terms[k]->go();
+		const nl_double * const RESTRICT Idr = this->m_terms[k]->Idr();
+		const nl_double * const * RESTRICT other_cur_analog = this->m_terms[k]->other_curanalog();
+
+		for (unsigned i = 0; i < term_count; i++)
+		{
+			gtot_t = gtot_t + gt[i];
+			RHS_t = RHS_t + Idr[i];
+		}
+
+		for (unsigned i = railstart; i < term_count; i++)
+			RHS_t = RHS_t  + go[i] * *other_cur_analog[i];
+
+		new_V[k] = this->m_last_RHS[k] = RHS_t;
+
+		// add diagonal element
+		m_A[mat.diag[k]] = gtot_t;
+
+		for (unsigned i = 0; i < railstart; i++)
+			m_A[m_term_cr[k][i]] -= go[i];
+	}
+
+	if (m_static != NULL)
+		m_static(m_A, new_V);
+	else
+	{
+		LU_factorize();
+		mat.solveLUx(m_A, new_V);
+	}
+
+	this->m_stat_calculations++;
+
+	if (newton_raphson)
+	{
+		nl_double err = this->delta(new_V);
+
+		this->store(new_V);
+
+		return (err > this->m_params.m_accuracy) ? 2 : 1;
+	}
+	else
+	{
+		this->store(new_V);
+		return 1;
+	}
+}
+
+NETLIB_NAMESPACE_DEVICES_END()
+
+#endif /* NLD_MS_SPARSE_H_ */
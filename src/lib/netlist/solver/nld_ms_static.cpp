@@ -0,0 +1,303 @@
+// license:GPL-2.0+
+// copyright-holders:MAMEdev Team
+/*
+ * nld_ms_static.cpp
+ *
+ * Static solvers for the sparse LU solver.
+ *
+ * The code below is written by
+ *
+ *     nltool -c static -f <file> -n <netlist>
+ *
+ * which prints a function per sparse matrix group followed by the table.
+ * Add the functions here and merge the table entries. A solver whose name
+ * is not in the table uses the generic elimination in nld_ms_sparse.h.
+ *
+ */
+
+#include "solver/nld_solver.h"
+
+NETLIB_NAMESPACE_DEVICES_START()
+
+/* kidniki_interface, mame/audio/irem.cpp */
+
+static void nl_gcr_43_167_859e9a239c491f52(nl_double * RESTRICT m_A, nl_double * RESTRICT V)
+{
+	const nl_double f0 = m_A[6] = m_A[6] / m_A[4];
+	m_A[7] -= f0 * m_A[5];
+	const nl_double f1 = m_A[11] = m_A[11] / m_A[9];
+	m_A[12] -= f1 * m_A[10];
+	const nl_double f2 = m_A[14] = m_A[14] / m_A[12];
+	m_A[15] -= f2 * m_A[13];
+	const nl_double f3 = m_A[17] = m_A[17] / m_A[15];
+	m_A[18] -= f3 * m_A[16];
+	const nl_double f4 = m_A[20] = m_A[20] / m_A[18];
+	m_A[21] -= f4 * m_A[19];
+	const nl_double f5 = m_A[23] = m_A[23] / m_A[21];
+	m_A[24] -= f5 * m_A[22];
+	const nl_double f6 = m_A[28] = m_A[28] / m_A[26];
+	m_A[29] -= f6 * m_A[27];
+	const nl_double f7 = m_A[31] = m_A[31] / m_A[29];
+	m_A[32] -= f7 * m_A[30];
+	const nl_double f8 = m_A[34] = m_A[34] / m_A[32];
+	m_A[35] -= f8 * m_A[33];
+	const nl_double f9 = m_A[37] = m_A[37] / m_A[35];
+	m_A[38] -= f9 * m_A[36];
+	const nl_double f10 = m_A[40] = m_A[40] / m_A[38];
+	m_A[41] -= f10 * m_A[39];
+	const nl_double f11 = m_A[45] = m_A[45] / m_A[43];
+	m_A[46] -= f11 * m_A[44];
+	const nl_double f12 = m_A[50] = m_A[50] / m_A[48];
+	m_A[51] -= f12 * m_A[49];
+	const nl_double f13 = m_A[53] = m_A[53] / m_A[0];
+	m_A[54] -= f13 * m_A[1];
+	const nl_double f14 = m_A[57] = m_A[57] / m_A[2];
+	m_A[59] -= f14 * m_A[3];
+	const nl_double f15 = m_A[58] = m_A[58] / m_A[54];
+	m_A[59] -= f15 * m_A[55];
+	m_A[60] -= f15 * m_A[56];
+	const nl_double f16 = m_A[62] = m_A[62] / m_A[54];
+	m_A[63] -= f16 * m_A[55];
+	m_A[64] -= f16 * m_A[56];
+	const nl_double f17 = m_A[63] = m_A[63] / m_A[59];
+	m_A[64] -= f17 * m_A[60];
+	m_A[65] -= f17 * m_A[61];
+	const nl_double f18 = m_A[66] = m_A[66] / m_A[46];
+	m_A[70] -= f18 * m_A[47];
+	const nl_double f19 = m_A[67] = m_A[67] / m_A[51];
+	m_A[70] -= f19 * m_A[52];
+	const nl_double f20 = m_A[68] = m_A[68] / m_A[59];
+	m_A[69] -= f20 * m_A[60];
+	m_A[70] -= f20 * m_A[61];
+	const nl_double f21 = m_A[69] = m_A[69] / m_A[64];
+	m_A[70] -= f21 * m_A[65];
+	const nl_double f22 = m_A[73] = m_A[73] / m_A[70];
+	m_A[74] -= f22 * m_A[71];
+	m_A[76] -= f22 * m_A[72];
+	const nl_double f23 = m_A[83] = m_A[83] / m_A[77];
+	m_A[85] -= f23 * m_A[78];
+	m_A[87] -= f23 * m_A[79];
+	const nl_double f24 = m_A[84] = m_A[84] / m_A[80];
+	m_A[85] -= f24 * m_A[81];
+	m_A[86] -= f24 * m_A[82];
+	const nl_double f25 = m_A[91] = m_A[91] / m_A[7];
+	m_A[95] -= f25 * m_A[8];
+	const nl_double f26 = m_A[92] = m_A[92] / m_A[80];
+	m_A[93] -= f26 * m_A[81];
+	m_A[95] -= f26 * m_A[82];
+	const nl_double f27 = m_A[93] = m_A[93] / m_A[85];
+	m_A[95] -= f27 * m_A[86];
+	m_A[96] -= f27 * m_A[87];
+	const nl_double f28 = m_A[94] = m_A[94] / m_A[88];
+	m_A[95] -= f28 * m_A[89];
+	m_A[97] -= f28 * m_A[90];
+	const nl_double f29 = m_A[101] = m_A[101] / m_A[74];
+	m_A[103] -= f29 * m_A[75];
+	m_A[105] -= f29 * m_A[76];
+	const nl_double f30 = m_A[102] = m_A[102] / m_A[98];
+	m_A[103] -= f30 * m_A[99];
+	m_A[104] -= f30 * m_A[100];
+	const nl_double f31 = m_A[106] = m_A[106] / m_A[77];
+	m_A[107] -= f31 * m_A[78];
+	m_A[111] -= f31 * m_A[79];
+	const nl_double f32 = m_A[107] = m_A[107] / m_A[85];
+	m_A[108] -= f32 * m_A[86];
+	m_A[111] -= f32 * m_A[87];
+	const nl_double f33 = m_A[108] = m_A[108] / m_A[95];
+	m_A[111] -= f33 * m_A[96];
+	m_A[113] -= f33 * m_A[97];
+	const nl_double f34 = m_A[109] = m_A[109] / m_A[98];
+	m_A[110] -= f34 * m_A[99];
+	m_A[111] -= f34 * m_A[100];
+	const nl_double f35 = m_A[110] = m_A[110] / m_A[103];
+	m_A[111] -= f35 * m_A[104];
+	m_A[112] -= f35 * m_A[105];
+	const nl_double f36 = m_A[114] = m_A[114] / m_A[70];
+	m_A[115] -= f36 * m_A[71];
+	m_A[118] -= f36 * m_A[72];
+	const nl_double f37 = m_A[115] = m_A[115] / m_A[74];
+	m_A[116] -= f37 * m_A[75];
+	m_A[118] -= f37 * m_A[76];
+	const nl_double f38 = m_A[116] = m_A[116] / m_A[103];
+	m_A[117] -= f38 * m_A[104];
+	m_A[118] -= f38 * m_A[105];
+	const nl_double f39 = m_A[117] = m_A[117] / m_A[111];
+	m_A[118] -= f39 * m_A[112];
+	m_A[119] -= f39 * m_A[113];
+	const nl_double f40 = m_A[121] = m_A[121] / m_A[24];
+	m_A[123] -= f40 * m_A[25];
+	const nl_double f41 = m_A[122] = m_A[122] / m_A[41];
+	m_A[123] -= f41 * m_A[42];
+	const nl_double f42 = m_A[126] = m_A[126] / m_A[123];
+	m_A[127] -= f42 * m_A[124];
+	m_A[129] -= f42 * m_A[125];
+	const nl_double f43 = m_A[130] = m_A[130] / m_A[127];
+	m_A[131] -= f43 * m_A[128];
+	m_A[133] -= f43 * m_A[129];
+	const nl_double f44 = m_A[134] = m_A[134] / m_A[131];
+	m_A[135] -= f44 * m_A[132];
+	m_A[137] -= f44 * m_A[133];
+	const nl_double f45 = m_A[138] = m_A[138] / m_A[88];
+	m_A[139] -= f45 * m_A[89];
+	m_A[143] -= f45 * m_A[90];
+	const nl_double f46 = m_A[139] = m_A[139] / m_A[95];
+	m_A[140] -= f46 * m_A[96];
+	m_A[143] -= f46 * m_A[97];
+	const nl_double f47 = m_A[140] = m_A[140] / m_A[111];
+	m_A[141] -= f47 * m_A[112];
+	m_A[143] -= f47 * m_A[113];
+	const nl_double f48 = m_A[141] = m_A[141] / m_A[118];
+	m_A[143] -= f48 * m_A[119];
+	m_A[145] -= f48 * m_A[120];
+	const nl_double f49 = m_A[142] = m_A[142] / m_A[135];
+	m_A[143] -= f49 * m_A[136];
+	m_A[144] -= f49 * m_A[137];
+	const nl_double f50 = m_A[146] = m_A[146] / m_A[123];
+	m_A[147] -= f50 * m_A[124];
+	m_A[151] -= f50 * m_A[125];
+	const nl_double f51 = m_A[147] = m_A[147] / m_A[127];
+	m_A[148] -= f51 * m_A[128];
+	m_A[151] -= f51 * m_A[129];
+	const nl_double f52 = m_A[148] = m_A[148] / m_A[131];
+	m_A[149] -= f52 * m_A[132];
+	m_A[151] -= f52 * m_A[133];
+	const nl_double f53 = m_A[149] = m_A[149] / m_A[135];
+	m_A[150] -= f53 * m_A[136];
+	m_A[151] -= f53 * m_A[137];
+	const nl_double f54 = m_A[150] = m_A[150] / m_A[143];
+	m_A[151] -= f54 * m_A[144];
+	m_A[152] -= f54 * m_A[145];
+	const nl_double f55 = m_A[154] = m_A[154] / m_A[118];
+	m_A[155] -= f55 * m_A[119];
+	m_A[157] -= f55 * m_A[120];
+	const nl_double f56 = m_A[155] = m_A[155] / m_A[143];
+	m_A[156] -= f56 * m_A[144];
+	m_A[157] -= f56 * m_A[145];
+	const nl_double f57 = m_A[156] = m_A[156] / m_A[151];
+	m_A[157] -= f57 * m_A[152];
+	m_A[158] -= f57 * m_A[153];
+	const nl_double f58 = m_A[160] = m_A[160] / m_A[151];
+	m_A[161] -= f58 * m_A[152];
+	m_A[162] -= f58 * m_A[153];
+	const nl_double f59 = m_A[161] = m_A[161] / m_A[157];
+	m_A[162] -= f59 * m_A[158];
+	m_A[163] -= f59 * m_A[159];
+	const nl_double f60 = m_A[164] = m_A[164] / m_A[157];
+	m_A[165] -= f60 * m_A[158];
+	m_A[166] -= f60 * m_A[159];
+	const nl_double f61 = m_A[165] = m_A[165] / m_A[162];
+	m_A[166] -= f61 * m_A[163];
+	V[3] -= m_A[6] * V[2];
+	V[5] -= m_A[11] * V[4];
+	V[6] -= m_A[14] * V[5];
+	V[7] -= m_A[17] * V[6];
+	V[8] -= m_A[20] * V[7];
+	V[9] -= m_A[23] * V[8];
+	V[11] -= m_A[28] * V[10];
+	V[12] -= m_A[31] * V[11];
+	V[13] -= m_A[34] * V[12];
+	V[14] -= m_A[37] * V[13];
+	V[15] -= m_A[40] * V[14];
+	V[17] -= m_A[45] * V[16];
+	V[19] -= m_A[50] * V[18];
+	V[20] -= m_A[53] * V[0];
+	V[21] -= m_A[57] * V[1];
+	V[21] -= m_A[58] * V[20];
+	V[22] -= m_A[62] * V[20];
+	V[22] -= m_A[63] * V[21];
+	V[23] -= m_A[66] * V[17];
+	V[23] -= m_A[67] * V[19];
+	V[23] -= m_A[68] * V[21];
+	V[23] -= m_A[69] * V[22];
+	V[24] -= m_A[73] * V[23];
+	V[27] -= m_A[83] * V[25];
+	V[27] -= m_A[84] * V[26];
+	V[29] -= m_A[91] * V[3];
+	V[29] -= m_A[92] * V[26];
+	V[29] -= m_A[93] * V[27];
+	V[29] -= m_A[94] * V[28];
+	V[31] -= m_A[101] * V[24];
+	V[31] -= m_A[102] * V[30];
+	V[32] -= m_A[106] * V[25];
+	V[32] -= m_A[107] * V[27];
+	V[32] -= m_A[108] * V[29];
+	V[32] -= m_A[109] * V[30];
+	V[32] -= m_A[110] * V[31];
+	V[33] -= m_A[114] * V[23];
+	V[33] -= m_A[115] * V[24];
+	V[33] -= m_A[116] * V[31];
+	V[33] -= m_A[117] * V[32];
+	V[34] -= m_A[121] * V[9];
+	V[34] -= m_A[122] * V[15];
+	V[35] -= m_A[126] * V[34];
+	V[36] -= m_A[130] * V[35];
+	V[37] -= m_A[134] * V[36];
+	V[38] -= m_A[138] * V[28];
+	V[38] -= m_A[139] * V[29];
+	V[38] -= m_A[140] * V[32];
+	V[38] -= m_A[141] * V[33];
+	V[38] -= m_A[142] * V[37];
+	V[39] -= m_A[146] * V[34];
+	V[39] -= m_A[147] * V[35];
+	V[39] -= m_A[148] * V[36];
+	V[39] -= m_A[149] * V[37];
+	V[39] -= m_A[150] * V[38];
+	V[40] -= m_A[154] * V[33];
+	V[40] -= m_A[155] * V[38];
+	V[40] -= m_A[156] * V[39];
+	V[41] -= m_A[160] * V[39];
+	V[41] -= m_A[161] * V[40];
+	V[42] -= m_A[164] * V[40];
+	V[42] -= m_A[165] * V[41];
+	V[42] = (V[42]) / m_A[166];
+	V[41] = (V[41] - m_A[163] * V[42]) / m_A[162];
+	V[40] = (V[40] - m_A[158] * V[41] - m_A[159] * V[42]) / m_A[157];
+	V[39] = (V[39] - m_A[152] * V[40] - m_A[153] * V[41]) / m_A[151];
+	V[38] = (V[38] - m_A[144] * V[39] - m_A[145] * V[40]) / m_A[143];
+	V[37] = (V[37] - m_A[136] * V[38] - m_A[137] * V[39]) / m_A[135];
+	V[36] = (V[36] - m_A[132] * V[37] - m_A[133] * V[39]) / m_A[131];
+	V[35] = (V[35] - m_A[128] * V[36] - m_A[129] * V[39]) / m_A[127];
+	V[34] = (V[34] - m_A[124] * V[35] - m_A[125] * V[39]) / m_A[123];
+	V[33] = (V[33] - m_A[119] * V[38] - m_A[120] * V[40]) / m_A[118];
+	V[32] = (V[32] - m_A[112] * V[33] - m_A[113] * V[38]) / m_A[111];
+	V[31] = (V[31] - m_A[104] * V[32] - m_A[105] * V[33]) / m_A[103];
+	V[30] = (V[30] - m_A[99] * V[31] - m_A[100] * V[32]) / m_A[98];
+	V[29] = (V[29] - m_A[96] * V[32] - m_A[97] * V[38]) / m_A[95];
+	V[28] = (V[28] - m_A[89] * V[29] - m_A[90] * V[38]) / m_A[88];
+	V[27] = (V[27] - m_A[86] * V[29] - m_A[87] * V[32]) / m_A[85];
+	V[26] = (V[26] - m_A[81] * V[27] - m_A[82] * V[29]) / m_A[80];
+	V[25] = (V[25] - m_A[78] * V[27] - m_A[79] * V[32]) / m_A[77];
+	V[24] = (V[24] - m_A[75] * V[31] - m_A[76] * V[33]) / m_A[74];
+	V[23] = (V[23] - m_A[71] * V[24] - m_A[72] * V[33]) / m_A[70];
+	V[22] = (V[22] - m_A[65] * V[23]) / m_A[64];
+	V[21] = (V[21] - m_A[60] * V[22] - m_A[61] * V[23]) / m_A[59];
+	V[20] = (V[20] - m_A[55] * V[21] - m_A[56] * V[22]) / m_A[54];
+	V[19] = (V[19] - m_A[52] * V[23]) / m_A[51];
+	V[18] = (V[18] - m_A[49] * V[19]) / m_A[48];
+	V[17] = (V[17] - m_A[47] * V[23]) / m_A[46];
+	V[16] = (V[16] - m_A[44] * V[17]) / m_A[43];
+	V[15] = (V[15] - m_A[42] * V[34]) / m_A[41];
+	V[14] = (V[14] - m_A[39] * V[15]) / m_A[38];
+	V[13] = (V[13] - m_A[36] * V[14]) / m_A[35];
+	V[12] = (V[12] - m_A[33] * V[13]) / m_A[32];
+	V[11] = (V[11] - m_A[30] * V[12]) / m_A[29];
+	V[10] = (V[10] - m_A[27] * V[11]) / m_A[26];
+	V[9] = (V[9] - m_A[25] * V[34]) / m_A[24];
+	V[8] = (V[8] - m_A[22] * V[9]) / m_A[21];
+	V[7] = (V[7] - m_A[19] * V[8]) / m_A[18];
+	V[6] = (V[6] - m_A[16] * V[7]) / m_A[15];
+	V[5] = (V[5] - m_A[13] * V[6]) / m_A[12];
+	V[4] = (V[4] - m_A[10] * V[5]) / m_A[9];
+	V[3] = (V[3] - m_A[8] * V[29]) / m_A[7];
+	V[2] = (V[2] - m_A[5] * V[3]) / m_A[4];
+	V[1] = (V[1] - m_A[3] * V[21]) / m_A[2];
+	V[0] = (V[0] - m_A[1] * V[20]) / m_A[0];
+}
+
+const static_solver_entry_t static_solvers[] =
+{
+	{ "nl_gcr_43_167_859e9a239c491f52", &nl_gcr_43_167_859e9a239c491f52 },
+	{ NULL, NULL }
+};
+
+NETLIB_NAMESPACE_DEVICES_END()
@@ -38,15 +38,20 @@
 #include "nld_ms_sor.h"
 #include "nld_ms_sor_mat.h"
 #include "nld_ms_gmres.h"
+#include "nld_ms_sparse.h"
 //#include "nld_twoterm.h"
 #include "nl_lists.h"
 
-#if HAS_OPENMP
-#include "omp.h"
-#endif
-
 NETLIB_NAMESPACE_DEVICES_START()
 
+ATTR_COLD static_solver_func_t find_static_solver(const pstring &name)
+{
+	for (const static_solver_entry_t *p = static_solvers; p->name != NULL; p++)
+		if (name.equals(p->name))
+			return p->func;
+	return NULL;
+}
+
 ATTR_COLD void terms_t::add(terminal_t *term, int net_other, bool sorted)
 {
 	if (sorted)
@@ -92,8 +97,10 @@ ATTR_COLD matrix_solver_t::matrix_solver_t(const eSolverType type, const solver_
 	m_stat_vsolver_calls(0),
 	m_iterative_fail(0),
 	m_iterative_total(0),
+	m_stat_solve_time(0),
 	m_params(*params),
 	m_cur_ts(0),
+	m_newton_exceeded(false),
 	m_type(type)
 {
 }
@@ -261,12 +268,8 @@ void matrix_solver_t::solve_base(C *p)
 		} while (this_resched > 1 && newton_loops < m_params.m_nr_loops);
 
 		m_stat_newton_raphson += newton_loops;
-		// reschedule ....
-		if (this_resched > 1 && !m_Q_sync.net().is_queued())
-		{
-			log().warning("NEWTON_LOOPS exceeded on net {1}... reschedule", this->name());
-			m_Q_sync.net().reschedule_in_queue(m_params.m_nt_sync_delay);
-		}
+		// reschedule in solve_commit()
+		m_newton_exceeded = (this_resched > 1);
 	}
 	else
 	{
@@ -275,6 +278,16 @@ void matrix_solver_t::solve_base(C *p)
 }
 
 ATTR_HOT nl_double matrix_solver_t::solve()
+{
+	nl_double next_time_step;
+
+	if (!solve_local(next_time_step))
+		return -1.0;
+	solve_commit();
+	return next_time_step;
+}
+
+ATTR_HOT bool matrix_solver_t::solve_local(nl_double &next_time_step)
 {
 	const netlist_time now = netlist().time();
 	const netlist_time delta = now - m_last_step;
@@ -282,7 +295,9 @@ ATTR_HOT nl_double matrix_solver_t::solve()
 	// We are already up to date. Avoid oscillations.
 	// FIXME: Make this a parameter!
 	if (delta < netlist_time::from_nsec(1)) // 20000
-		return -1.0;
+		return false;
+
+	begin_timing(m_stat_solve_time);
 
 	/* update all terminals for new time step */
 	m_last_step = now;
@@ -290,10 +305,24 @@ ATTR_HOT nl_double matrix_solver_t::solve()
 
 	step(delta);
 
-	const nl_double next_time_step = vsolve();
+	next_time_step = vsolve();
+
+	end_timing(m_stat_solve_time);
+	return true;
+}
 
+ATTR_HOT void matrix_solver_t::solve_commit()
+{
+	if (m_newton_exceeded)
+	{
+		m_newton_exceeded = false;
+		if (!m_Q_sync.net().is_queued())
+		{
+			log().warning("NEWTON_LOOPS exceeded on net {1}... reschedule", this->name());
+			m_Q_sync.net().reschedule_in_queue(m_params.m_nt_sync_delay);
+		}
+	}
 	update_inputs();
-	return next_time_step;
 }
 
 ATTR_COLD int matrix_solver_t::get_net_idx(net_t *net)
@@ -356,6 +385,7 @@ NETLIB_START(solver)
 	register_param("PIVOT", m_pivot, 0);                    // use pivoting - on supported solvers
 	register_param("NR_LOOPS", m_nr_loops, 250);            // Newton-Raphson loops
 	register_param("PARALLEL", m_parallel, 0);
+	register_param("SPARSE_THRESHOLD", m_sparse_threshold, 30);   // from this size on, use sparse LU for sparse groups (0: never)
 
 	/* automatic time step */
 	register_param("DYNAMIC_TS", m_dynamic, 0);
@@ -391,49 +421,50 @@ NETLIB_STOP(solver)
 
 NETLIB_NAME(solver)::~NETLIB_NAME(solver)()
 {
+	if (m_pool != NULL)
+		pfree(m_pool);
 	m_mat_solvers.clear_and_free();
 }
 
+/* one pool job: the local part of a single timestep solver */
+struct solver_job_t
+{
+	solver_job_t(matrix_solver_t::list_t &solvers, plist_t<int> &solved)
+	: m_solvers(solvers), m_solved(solved) { }
+
+	void operator()(const std::size_t i)
+	{
+		nl_double ts;
+		m_solved[i] = m_solvers[i]->solve_local(ts);
+	}
+
+	matrix_solver_t::list_t &m_solvers;
+	plist_t<int> &m_solved;
+};
+
 NETLIB_UPDATE(solver)
 {
 	if (m_params.m_dynamic)
 		return;
 
-	const std::size_t t_cnt = m_mat_solvers.size();
+	const std::size_t t_cnt = m_ts_solvers.size();
 
-#if HAS_OPENMP && USE_OPENMP
-	if (m_parallel.Value())
+	if (m_pool != NULL)
 	{
-		omp_set_num_threads(3);
-		//omp_set_dynamic(0);
-		#pragma omp parallel
-		{
-			#pragma omp for
-			for (int i = 0; i <  t_cnt; i++)
-				if (m_mat_solvers[i]->is_timestep())
-				{
-					// Ignore return value
-					ATTR_UNUSED const nl_double ts = m_mat_solvers[i]->solve();
-				}
-		}
+		/* groups share no nets, but the queue is not thread safe:
+		 * solve in parallel, then commit the outputs in order */
+		solver_job_t job(m_ts_solvers, m_ts_solved);
+		m_pool->run(t_cnt, job);
+		for (std::size_t i = 0; i < t_cnt; i++)
+			if (m_ts_solved[i])
+				m_ts_solvers[i]->solve_commit();
 	}
 	else
-		for (int i = 0; i < t_cnt; i++)
-			if (m_mat_solvers[i]->is_timestep())
-			{
-				// Ignore return value
-				ATTR_UNUSED const nl_double ts = m_mat_solvers[i]->solve();
-			}
-#else
-	for (std::size_t i = 0; i < t_cnt; i++)
-	{
-		if (m_mat_solvers[i]->is_timestep())
+		for (std::size_t i = 0; i < t_cnt; i++)
 		{
 			// Ignore return value
-			ATTR_UNUSED const nl_double ts = m_mat_solvers[i]->solve();
+			ATTR_UNUSED const nl_double ts = m_ts_solvers[i]->solve();
 		}
-	}
-#endif
 
 	/* step circuit */
 	if (!m_Q_step.net().is_queued())
@@ -443,7 +474,7 @@ NETLIB_UPDATE(solver)
 }
 
 template <int m_N, int _storage_N>
-matrix_solver_t * NETLIB_NAME(solver)::create_solver(int size, const bool use_specific)
+matrix_solver_t * NETLIB_NAME(solver)::create_solver(int size, const bool use_specific, const bool use_sparse)
 {
 	if (use_specific && m_N == 1)
 		return palloc(matrix_solver_direct1_t(&m_params));
@@ -451,7 +482,12 @@ matrix_solver_t * NETLIB_NAME(solver)::create_solver(int size, const bool use_sp
 		return palloc(matrix_solver_direct2_t(&m_params));
 	else
 	{
-		if (size >= m_gs_threshold)
+		if (use_sparse)
+		{
+			typedef matrix_solver_sparse_t<m_N,_storage_N> solver_sparse;
+			return palloc(solver_sparse(&m_params, size));
+		}
+		else if (size >= m_gs_threshold)
 		{
 			if (pstring("SOR_MAT").equals(m_iterative_solver))
 			{
@@ -482,6 +518,47 @@ matrix_solver_t * NETLIB_NAME(solver)::create_solver(int size, const bool use_sp
 	}
 }
 
+/* number of off-diagonal matrix elements the group will populate */
+ATTR_COLD std::size_t NETLIB_NAME(solver)::group_couplings(analog_net_t::list_t &nets)
+{
+	std::size_t cnt = 0;
+	for (std::size_t i = 0; i < nets.size(); i++)
+	{
+		net_t *n = nets[i];
+		for (std::size_t k = 0; k < n->m_core_terms.size(); k++)
+		{
+			core_terminal_t *pcore = n->m_core_terms[k];
+			if (pcore->isType(core_terminal_t::TERMINAL)
+					&& !static_cast<terminal_t *>(pcore)->m_otherterm->net().isRailNet())
+				cnt++;
+		}
+	}
+	return cnt;
+}
+
+ATTR_COLD void NETLIB_NAME(solver)::create_solver_code(postream &strm)
+{
+	plist_t<pstring> names;
+
+	for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
+	{
+		pstring name = m_mat_solvers[i]->static_solver_name();
+		if (name != "" && !names.contains(name))
+		{
+			m_mat_solvers[i]->create_solver_code(strm);
+			strm.writeline("");
+			names.add(name);
+		}
+	}
+
+	strm.writeline("const static_solver_entry_t static_solvers[] =");
+	strm.writeline("{");
+	for (std::size_t i = 0; i < names.size(); i++)
+		strm.writeline(pfmt("\t{ \"{1}\", &{2} },")(names[i])(names[i]));
+	strm.writeline("\t{ NULL, NULL }");
+	strm.writeline("};");
+}
+
 ATTR_COLD void NETLIB_NAME(solver)::post_start()
 {
 	analog_net_t::list_t groups[256];
@@ -539,74 +616,77 @@ ATTR_COLD void NETLIB_NAME(solver)::post_start()
 	{
 		matrix_solver_t *ms;
 		std::size_t net_count = groups[i].size();
+		const bool use_sparse = m_sparse_threshold.Value() > 0
+				&& net_count >= (std::size_t) m_sparse_threshold.Value()
+				&& group_couplings(groups[i]) * 4 < net_count * net_count;
 
 		switch (net_count)
 		{
 			case 1:
-				ms = create_solver<1,1>(1, use_specific);
+				ms = create_solver<1,1>(1, use_specific, use_sparse);
 				break;
 			case 2:
-				ms = create_solver<2,2>(2, use_specific);
+				ms = create_solver<2,2>(2, use_specific, use_sparse);
 				break;
 			case 3:
-				ms = create_solver<3,3>(3, use_specific);
+				ms = create_solver<3,3>(3, use_specific, use_sparse);
 				break;
 			case 4:
-				ms = create_solver<4,4>(4, use_specific);
+				ms = create_solver<4,4>(4, use_specific, use_sparse);
 				break;
 			case 5:
-				ms = create_solver<5,5>(5, use_specific);
+				ms = create_solver<5,5>(5, use_specific, use_sparse);
 				break;
 			case 6:
-				ms = create_solver<6,6>(6, use_specific);
+				ms = create_solver<6,6>(6, use_specific, use_sparse);
 				break;
 			case 7:
-				ms = create_solver<7,7>(7, use_specific);
+				ms = create_solver<7,7>(7, use_specific, use_sparse);
 				break;
 			case 8:
-				ms = create_solver<8,8>(8, use_specific);
+				ms = create_solver<8,8>(8, use_specific, use_sparse);
 				break;
 			case 10:
-				ms = create_solver<10,10>(10, use_specific);
+				ms = create_solver<10,10>(10, use_specific, use_sparse);
 				break;
 			case 11:
-				ms = create_solver<11,11>(11, use_specific);
+				ms = create_solver<11,11>(11, use_specific, use_sparse);
 				break;
 			case 12:
-				ms = create_solver<12,12>(12, use_specific);
+				ms = create_solver<12,12>(12, use_specific, use_sparse);
 				break;
 			case 15:
-				ms = create_solver<15,15>(15, use_specific);
+				ms = create_solver<15,15>(15, use_specific, use_sparse);
 				break;
 			case 31:
-				ms = create_solver<31,31>(31, use_specific);
+				ms = create_solver<31,31>(31, use_specific, use_sparse);
 				break;
 			case 49:
-				ms = create_solver<49,49>(49, use_specific);
+				ms = create_solver<49,49>(49, use_specific, use_sparse);
 				break;
 #if 0
 			case 87:
-				ms = create_solver<87,87>(87, use_specific);
+				ms = create_solver<87,87>(87, use_specific, use_sparse);
 				break;
 #endif
 			default:
 				netlist().log().warning("No specific solver found for netlist of size {1}", (unsigned) net_count);
 				if (net_count <= 16)
 				{
-					ms = create_solver<0,16>(net_count, use_specific);
+					ms = create_solver<0,16>(net_count, use_specific, use_sparse);
 				}
 				else if (net_count <= 32)
 				{
-					ms = create_solver<0,32>(net_count, use_specific);
+					ms = create_solver<0,32>(net_count, use_specific, use_sparse);
 				}
 				else if (net_count <= 64)
 				{
-					ms = create_solver<0,64>(net_count, use_specific);
+					ms = create_solver<0,64>(net_count, use_specific, use_sparse);
 				}
 				else
 					if (net_count <= 128)
 				{
-					ms = create_solver<0,128>(net_count, use_specific);
+					ms = create_solver<0,128>(net_count, use_specific, use_sparse);
 				}
 				else
 				{
@@ -638,6 +718,20 @@ ATTR_COLD void NETLIB_NAME(solver)::post_start()
 			}
 		}
 	}
+
+	for (std::size_t i = 0; i < m_mat_solvers.size(); i++)
+		if (m_mat_solvers[i]->is_timestep())
+		{
+			m_ts_solvers.add(m_mat_solvers[i]);
+			m_ts_solved.add(0);
+		}
+
+	/* a single group gains nothing from the pool */
+	if (m_parallel.Value() != 0 && m_ts_solvers.size() > 1)
+	{
+		m_pool = palloc(pthreadpool_t(m_parallel.Value() == 1 ? 0 : m_parallel.Value()));
+		netlist().log().verbose("Solving {1} groups on {2} threads", m_ts_solvers.size(), m_pool->size());
+	}
 }
 
 NETLIB_NAMESPACE_DEVICES_END()
@@ -10,6 +10,8 @@
 
 #include "nl_setup.h"
 #include "nl_base.h"
+#include "plib/pthreadpool.h"
+#include "plib/pstream.h"
 
 //#define ATTR_ALIGNED(N) __attribute__((aligned(N)))
 #define ATTR_ALIGNED(N) ATTR_ALIGN
@@ -30,6 +32,26 @@ NETLIB_NAMESPACE_DEVICES_START()
 
 class NETLIB_NAME(solver);
 
+// ----------------------------------------------------------------------------------------
+// static solvers
+//
+// "nltool -c static" writes an unrolled factorization for each sparse
+// matrix group. Solvers look up their name in static_solvers at setup.
+// ----------------------------------------------------------------------------------------
+
+typedef void (*static_solver_func_t)(nl_double * RESTRICT A, nl_double * RESTRICT V);
+
+struct static_solver_entry_t
+{
+	const char *name;
+	static_solver_func_t func;
+};
+
+/* terminated by an entry with name NULL, see nld_ms_static.cpp */
+extern const static_solver_entry_t static_solvers[];
+
+ATTR_COLD static_solver_func_t find_static_solver(const pstring &name);
+
 /* FIXME: these should become proper devices */
 
 struct solver_parameters_t
@@ -115,6 +137,11 @@ public:
 
 	ATTR_HOT nl_double solve();
 
+	/* solve() split in two: solve_local() only touches this group and may run
+	 * on a worker thread, solve_commit() pushes the results to the queue. */
+	ATTR_HOT bool solve_local(nl_double &next_time_step);
+	ATTR_HOT void solve_commit();
+
 	ATTR_HOT inline bool is_dynamic() { return m_dynamic_devices.size() > 0; }
 	ATTR_HOT inline bool is_timestep() { return m_step_devices.size() > 0; }
 
@@ -136,6 +163,19 @@ public:
 
 	virtual void log_stats();
 
+	/* statistics, see log_stats() */
+	unsigned stat_nets() const { return m_nets.size(); }
+	int stat_vsolver_calls() const { return m_stat_vsolver_calls; }
+	int stat_calculations() const { return m_stat_calculations; }
+	int stat_newton_raphson() const { return m_stat_newton_raphson; }
+	int stat_iterative_total() const { return m_iterative_total; }
+	int stat_iterative_fail() const { return m_iterative_fail; }
+	INT64 stat_solve_time() const { return m_stat_solve_time; }  /* needs NL_KEEP_STATISTICS */
+
+	/* code generation, empty name if the solver has no static variant */
+	virtual pstring static_solver_name() { return ""; }
+	virtual void create_solver_code(postream &strm) { }
+
 protected:
 
 	ATTR_COLD void setup(analog_net_t::list_t &nets);
@@ -154,6 +194,7 @@ protected:
 	int m_stat_vsolver_calls;
 	int m_iterative_fail;
 	int m_iterative_total;
+	INT64 m_stat_solve_time;
 
 	const solver_parameters_t &m_params;
 
@@ -168,6 +209,8 @@ private:
 	logic_input_t m_fb_sync;
 	logic_output_t m_Q_sync;
 
+	bool m_newton_exceeded;
+
 	ATTR_HOT void step(const netlist_time delta);
 
 	ATTR_HOT void update_inputs();
@@ -181,7 +224,7 @@ class NETLIB_NAME(solver) : public device_t
 {
 public:
 	NETLIB_NAME(solver)()
-	: device_t()    { }
+	: device_t(), m_pool(NULL)    { }
 
 	virtual ~NETLIB_NAME(solver)();
 
@@ -190,6 +233,10 @@ public:
 
 	ATTR_HOT inline nl_double gmin() { return m_gmin.Value(); }
 
+	ATTR_COLD void create_solver_code(postream &strm);
+
+	const matrix_solver_t::list_t &solvers() const { return m_mat_solvers; }
+
 protected:
 	ATTR_HOT void update() override;
 	ATTR_HOT void start() override;
@@ -213,7 +260,8 @@ protected:
 	param_int_t m_nr_loops;
 	param_int_t m_gs_loops;
 	param_int_t m_gs_threshold;
-	param_int_t m_parallel;
+	param_int_t m_parallel;         /* 0: off, 1: one thread per core, n: at most n threads */
+	param_int_t m_sparse_threshold;
 
 	param_logic_t  m_log_stats;
 
@@ -222,8 +270,14 @@ private:
 
 	solver_parameters_t m_params;
 
+	pthreadpool_t *m_pool;
+	matrix_solver_t::list_t m_ts_solvers;
+	plist_t<int> m_ts_solved;
+
+	ATTR_COLD std::size_t group_couplings(analog_net_t::list_t &nets);
+
 	template <int m_N, int _storage_N>
-	matrix_solver_t *create_solver(int size, bool use_specific);
+	matrix_solver_t *create_solver(int size, bool use_specific, bool use_sparse);
 };
 
 NETLIB_NAMESPACE_DEVICES_END()
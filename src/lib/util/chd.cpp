@@ -189,7 +189,8 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 	if (m_file == nullptr)
 		throw CHDERR_NOT_OPEN;
 
-	// seek and read
+	// seek and read; the prefetcher may be reading too
+	std::lock_guard<std::mutex> lock(m_filelock);
 	m_file->seek(offset, SEEK_SET);
 	UINT32 count = m_file->read(dest, length);
 	if (count != length)
@@ -289,10 +290,17 @@ inline UINT8 chd_file::bits_for_value(UINT64 value)
 
 chd_file::chd_file()
 	: m_file(nullptr),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_cache(DEFAULT_CACHE_HUNKS),
+		m_cachestamp(0),
+		m_readahead(DEFAULT_READAHEAD_HUNKS),
+		m_lasthunk(~0),
+		m_prefetch_queue(nullptr),
+		m_prefetch_parallel(false)
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
+	memset(m_prefetch_decompressor, 0, sizeof(m_prefetch_decompressor));
 	close();
 }
 
@@ -801,6 +809,20 @@ chd_error chd_file::open(util::core_file &file, bool writeable, chd_file *parent
 
 void chd_file::close()
 {
+	// stop the prefetcher before anything it uses goes away
+	if (m_prefetch_queue != nullptr)
+		osd_work_queue_free(m_prefetch_queue);
+	m_prefetch_queue = nullptr;
+	for (int threadid = 0; threadid < ARRAY_LENGTH(m_prefetch_decompressor); threadid++)
+	{
+		for (auto & elem : m_prefetch_decompressor[threadid])
+		{
+			delete elem;
+			elem = nullptr;
+		}
+		m_prefetch_compressed[threadid].clear();
+	}
+
 	// reset file characteristics
 	if (m_owns_file && m_file)
 		delete m_file;
@@ -833,6 +855,10 @@ void chd_file::close()
 	m_mapentrybytes = 0;
 	m_rawmap.clear();
 
+	// the mapping belongs to the file
+	m_mapped = nullptr;
+	m_mappedbytes = 0;
+
 	// reset compression management
 	for (auto & elem : m_decompressor)
 	{
@@ -842,8 +868,7 @@ void chd_file::close()
 	m_compressed.clear();
 
 	// reset caching
-	m_cache.clear();
-	m_cachehunk = ~0;
+	cache_reset();
 }
 
 /**
@@ -937,8 +962,11 @@ chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
 				// uncompressed case
 				if (!compressed())
 				{
+					const void *mapped = mapped_hunk(hunknum);
 					blockoffs = UINT64(be_read(rawmap, 4)) * UINT64(m_hunkbytes);
-					if (blockoffs != 0)
+					if (mapped != nullptr)
+						memcpy(dest, mapped, m_hunkbytes);
+					else if (blockoffs != 0)
 						file_read(blockoffs, dest, m_hunkbytes);
 					else if (m_parent_missing)
 						throw CHDERR_REQUIRES_PARENT;
@@ -1062,15 +1090,16 @@ chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
 			// write the map entry back
 			be_write(rawmap, rawentry, 4);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
-
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != &m_cache[0])
-				memcpy(&m_cache[0], buffer, m_hunkbytes);
 		}
 
 		// otherwise, just overwrite
 		else
 			file_write(UINT64(rawentry) * UINT64(m_hunkbytes), buffer, m_hunkbytes);
+
+		// update the cached hunk if we just wrote it
+		cache_entry *entry = cache_find(hunknum);
+		if (entry != nullptr && buffer != &entry->m_data[0])
+			memcpy(&entry->m_data[0], buffer, m_hunkbytes);
 		return CHDERR_NONE;
 	}
 
@@ -1146,32 +1175,75 @@ chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
+		// memory-mapped hunks are copied straight out of the mapping
+		const UINT8 *mapped = reinterpret_cast<const UINT8 *>(mapped_hunk(curhunk));
+		if (mapped != nullptr)
+		{
+			memcpy(dest, mapped + startoffs, endoffs + 1 - startoffs);
+			dest += endoffs + 1 - startoffs;
+			continue;
+		}
+
+		// if it's a full block, just read directly from disk unless it's cached
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		cache_entry *entry = cache_find(curhunk);
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && entry == nullptr)
 			err = read_hunk(curhunk, dest);
 
 		// otherwise, read from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
+			if (entry == nullptr)
 			{
-				err = read_hunk(curhunk, &m_cache[0]);
+				entry = cache_allocate(curhunk);
+				err = read_hunk(curhunk, &entry->m_data[0]);
 				if (err != CHDERR_NONE)
+				{
+					cache_discard(*entry);
 					return err;
-				m_cachehunk = curhunk;
+				}
 			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
+			memcpy(dest, &entry->m_data[startoffs], endoffs + 1 - startoffs);
 		}
 
 		// handle errors and advance
 		if (err != CHDERR_NONE)
 			return err;
 		dest += endoffs + 1 - startoffs;
+
+		// get ahead of sequential readers
+		if (curhunk == m_lasthunk + 1)
+			cache_readahead(curhunk + 1);
+		m_lasthunk = curhunk;
 	}
 	return CHDERR_NONE;
 }
 
+/**
+ * @fn  const void *chd_file::mapped_hunk(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            mapped_hunk - return a pointer to a hunk's data inside the memory-mapped file, for
+ *            reading without a copy
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  null if the file isn't mapped or the hunk has no data of its own in the file (it
+ *          lives in the parent or reads as zeros); use read_hunk or read_bytes then.
+ */
+
+const void *chd_file::mapped_hunk(UINT32 hunknum)
+{
+	if (m_mapped == nullptr || hunknum >= m_hunkcount)
+		return nullptr;
+
+	UINT64 blockoffs = UINT64(be_read(&m_rawmap[m_mapentrybytes * hunknum], 4)) * UINT64(m_hunkbytes);
+	if (blockoffs == 0 || blockoffs + m_hunkbytes > m_mappedbytes)
+		return nullptr;
+	return m_mapped + blockoffs;
+}
+
 /**
  * @fn  chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
  *
@@ -1199,23 +1271,27 @@ chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just write directly to disk unless it's the cached hunk
+		// if it's a full block, just write directly to disk unless it's cached
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		cache_entry *entry = cache_find(curhunk);
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && entry == nullptr)
 			err = write_hunk(curhunk, source);
 
 		// otherwise, write from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
+			if (entry == nullptr)
 			{
-				err = read_hunk(curhunk, &m_cache[0]);
+				entry = cache_allocate(curhunk);
+				err = read_hunk(curhunk, &entry->m_data[0]);
 				if (err != CHDERR_NONE)
+				{
+					cache_discard(*entry);
 					return err;
-				m_cachehunk = curhunk;
+				}
 			}
-			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
-			err = write_hunk(curhunk, &m_cache[0]);
+			memcpy(&entry->m_data[startoffs], source, endoffs + 1 - startoffs);
+			err = write_hunk(curhunk, &entry->m_data[0]);
 		}
 
 		// handle errors and advance
@@ -1645,6 +1721,41 @@ chd_error chd_file::codec_configure(chd_codec_type codec, int param, void *confi
 	}
 }
 
+/**
+ * @fn  void chd_file::configure_cache(UINT32 hunks, UINT32 readahead)
+ *
+ * @brief   -------------------------------------------------
+ *            configure_cache - set how many hunks are cached for partial reads and how many of
+ *            them may be decompressed ahead of a sequential reader
+ *          -------------------------------------------------.
+ *
+ * @param   hunks       Number of hunks to cache; at least one is always kept.
+ * @param   readahead   Number of hunks to prefetch, 0 to disable.
+ * @param   parallel    true to decompress prefetched hunks on every processor, for tools
+ *                      that do nothing but stream through the file.
+ */
+
+void chd_file::configure_cache(UINT32 hunks, UINT32 readahead, bool parallel)
+{
+	// the prefetcher holds pointers into the cache; a queue of the wrong kind is rebuilt
+	if (m_prefetch_queue != nullptr)
+	{
+		osd_work_queue_wait(m_prefetch_queue, 30 * osd_ticks_per_second());
+		if (parallel != m_prefetch_parallel)
+		{
+			osd_work_queue_free(m_prefetch_queue);
+			m_prefetch_queue = nullptr;
+		}
+	}
+	m_prefetch_parallel = parallel;
+
+	m_cache.clear();
+	m_cache.resize(MAX(hunks, 1));
+	m_readahead = MIN(readahead, m_cache.size() - 1);
+	m_cachestamp = 0;
+	m_lasthunk = ~0;
+}
+
 /**
  * @fn  const char *chd_file::error_string(chd_error err)
  *
@@ -2428,6 +2539,13 @@ chd_error chd_file::open_common(bool writeable)
 
 		// finish opening the file
 		create_open_common();
+
+		// uncompressed files opened read-only can be read straight out of memory
+		if (!writeable && m_version >= 5 && !compressed())
+		{
+			m_mapped = reinterpret_cast<const UINT8 *>(m_file->map());
+			m_mappedbytes = (m_mapped != nullptr) ? m_file->size() : 0;
+		}
 		return CHDERR_NONE;
 	}
 
@@ -2467,9 +2585,8 @@ void chd_file::create_open_common()
 	else
 		file_read(m_mapoffset, &m_rawmap[0], m_rawmap.size());
 
-	// allocate the temporary compressed buffer and a buffer for caching
+	// allocate the temporary compressed buffer; cache entries are sized on first use
 	m_compressed.resize(m_hunkbytes);
-	m_cache.resize(m_hunkbytes);
 }
 
 /**
@@ -2739,6 +2856,299 @@ int CLIB_DECL chd_file::metadata_hash_compare(const void *elem1, const void *ele
 	return memcmp(elem1, elem2, sizeof(metadata_hash));
 }
 
+/**
+ * @fn  chd_file::cache_entry *chd_file::cache_find(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_find - find a hunk in the cache, waiting for it if it is still being
+ *            prefetched
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  null if the hunk is not cached, else the cache entry.
+ */
+
+chd_file::cache_entry *chd_file::cache_find(UINT32 hunknum)
+{
+	std::unique_lock<std::mutex> lock(m_cachelock);
+	for (auto & entry : m_cache)
+		if (entry.m_hunknum == hunknum && entry.m_state != cache_entry::EMPTY)
+		{
+			while (entry.m_state == cache_entry::PREFETCHING)
+				m_cacheready.wait(lock);
+
+			// a failed prefetch leaves the hunk for read_hunk to report on
+			if (entry.m_state != cache_entry::VALID || entry.m_hunknum != hunknum)
+				return nullptr;
+			entry.m_lastused = ++m_cachestamp;
+			return &entry;
+		}
+	return nullptr;
+}
+
+/**
+ * @fn  chd_file::cache_entry *chd_file::cache_victim()
+ *
+ * @brief   -------------------------------------------------
+ *            cache_victim - pick an empty or least recently used entry to replace; must be
+ *            called with the cache lock held
+ *          -------------------------------------------------.
+ *
+ * @return  null if every entry is being prefetched, else the cache entry.
+ */
+
+chd_file::cache_entry *chd_file::cache_victim()
+{
+	cache_entry *victim = nullptr;
+	for (auto & entry : m_cache)
+	{
+		if (entry.m_state == cache_entry::EMPTY)
+			return &entry;
+		if (entry.m_state == cache_entry::VALID && (victim == nullptr || entry.m_lastused < victim->m_lastused))
+			victim = &entry;
+	}
+	return victim;
+}
+
+/**
+ * @fn  chd_file::cache_entry *chd_file::cache_allocate(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_allocate - claim a cache entry for a hunk the caller is about to read into it
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunknum.
+ *
+ * @return  the cache entry.
+ */
+
+chd_file::cache_entry *chd_file::cache_allocate(UINT32 hunknum)
+{
+	std::lock_guard<std::mutex> lock(m_cachelock);
+
+	// the read-ahead limit always leaves one entry that isn't being prefetched
+	cache_entry *entry = cache_victim();
+	assert(entry != nullptr);
+	entry->m_chd = this;
+	entry->m_data.resize(m_hunkbytes);
+	entry->m_hunknum = hunknum;
+	entry->m_lastused = ++m_cachestamp;
+	entry->m_state = cache_entry::VALID;
+	return entry;
+}
+
+/**
+ * @fn  void chd_file::cache_discard(cache_entry &entry)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_discard - drop an entry whose read failed
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  entry   The entry.
+ */
+
+void chd_file::cache_discard(cache_entry &entry)
+{
+	std::lock_guard<std::mutex> lock(m_cachelock);
+	entry.m_state = cache_entry::EMPTY;
+}
+
+/**
+ * @fn  void chd_file::cache_reset()
+ *
+ * @brief   -------------------------------------------------
+ *            cache_reset - empty the cache; the prefetcher must be idle
+ *          -------------------------------------------------.
+ */
+
+void chd_file::cache_reset()
+{
+	for (auto & entry : m_cache)
+	{
+		entry.m_data.clear();
+		entry.m_hunknum = ~0;
+		entry.m_state = cache_entry::EMPTY;
+	}
+	m_cachestamp = 0;
+	m_lasthunk = ~0;
+}
+
+/**
+ * @fn  void chd_file::cache_readahead(UINT32 hunknum)
+ *
+ * @brief   -------------------------------------------------
+ *            cache_readahead - queue the hunks following a sequential read for decompression
+ *            on a worker thread
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The first hunk to prefetch.
+ */
+
+void chd_file::cache_readahead(UINT32 hunknum)
+{
+	// only read-only V5 files can be decoded behind the caller's back
+	if (m_readahead == 0 || m_allow_writes || m_version < 5)
+		return;
+
+	// create the prefetcher's queue on first use
+	if (m_prefetch_queue == nullptr)
+	{
+		m_prefetch_queue = osd_work_queue_alloc(m_prefetch_parallel ? WORK_QUEUE_FLAG_MULTI : WORK_QUEUE_FLAG_IO);
+		if (m_prefetch_queue == nullptr)
+		{
+			m_readahead = 0;
+			return;
+		}
+	}
+
+	// claim the entries under the lock but queue them after releasing it: a queue
+	// without worker threads runs the item inline, and the item takes the lock
+	std::vector<cache_entry *> claimed;
+	{
+		std::lock_guard<std::mutex> lock(m_cachelock);
+
+		// don't let stale prefetches from an earlier position pile up
+		UINT32 pending = 0;
+		for (auto & entry : m_cache)
+			if (entry.m_state == cache_entry::PREFETCHING)
+				pending++;
+
+		for (UINT32 curhunk = hunknum; curhunk < hunknum + m_readahead && curhunk < m_hunkcount && pending < m_readahead; curhunk++)
+		{
+			// skip anything already cached or on its way
+			bool present = false;
+			for (auto & entry : m_cache)
+				if (entry.m_hunknum == curhunk && entry.m_state != cache_entry::EMPTY)
+					present = true;
+			if (present)
+				continue;
+
+			cache_entry *entry = cache_victim();
+			if (entry == nullptr)
+				break;
+			entry->m_chd = this;
+			entry->m_data.resize(m_hunkbytes);
+			entry->m_hunknum = curhunk;
+			entry->m_state = cache_entry::PREFETCHING;
+			claimed.push_back(entry);
+			pending++;
+		}
+	}
+
+	// PREFETCHING entries are never picked as victims, so they stay ours until the item finishes
+	for (cache_entry *entry : claimed)
+		osd_work_item_queue(m_prefetch_queue, async_prefetch_static, entry, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+/**
+ * @fn  bool chd_file::prefetch_hunk(UINT32 hunknum, UINT8 *dest, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            prefetch_hunk - decode a hunk on a prefetch thread; only the simple V5 cases are
+ *            handled, anything referring to other hunks is left to read_hunk
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  dest    Destination for the hunk data.
+ * @param   threadid        The work queue thread, selecting its private codecs.
+ *
+ * @return  true if the hunk was decoded and verified.
+ */
+
+bool chd_file::prefetch_hunk(UINT32 hunknum, UINT8 *dest, int threadid)
+{
+	assert(threadid < ARRAY_LENGTH(m_prefetch_decompressor));
+	chd_decompressor **decompressors = m_prefetch_decompressor[threadid];
+	dynamic_buffer &compbuf = m_prefetch_compressed[threadid];
+
+	try
+	{
+		// create this thread's codecs on first use
+		if (compbuf.empty())
+		{
+			for (int decompnum = 0; decompnum < ARRAY_LENGTH(m_compression); decompnum++)
+			{
+				delete decompressors[decompnum];
+				decompressors[decompnum] = chd_codec_list::new_decompressor(m_compression[decompnum], *this);
+			}
+			compbuf.resize(m_hunkbytes);
+		}
+
+		const UINT8 *rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+
+		// uncompressed case
+		if (!compressed())
+		{
+			UINT64 blockoffs = UINT64(be_read(rawmap, 4)) * UINT64(m_hunkbytes);
+			if (blockoffs == 0)
+				return false;
+			file_read(blockoffs, dest, m_hunkbytes);
+			return true;
+		}
+
+		// compressed case
+		UINT32 blocklen = be_read(&rawmap[1], 3);
+		UINT64 blockoffs = be_read(&rawmap[4], 6);
+		UINT32 blockcrc = be_read(&rawmap[10], 2);
+		switch (rawmap[0])
+		{
+			case COMPRESSION_TYPE_0:
+			case COMPRESSION_TYPE_1:
+			case COMPRESSION_TYPE_2:
+			case COMPRESSION_TYPE_3:
+			{
+				// lossy codecs decode into caller-configured buffers, so leave them alone
+				chd_decompressor *decompressor = decompressors[rawmap[0]];
+				if (decompressor == nullptr || decompressor->lossy())
+					return false;
+				file_read(blockoffs, &compbuf[0], blocklen);
+				decompressor->decompress(&compbuf[0], blocklen, dest, m_hunkbytes);
+				return crc16_creator::simple(dest, m_hunkbytes) == blockcrc;
+			}
+
+			case COMPRESSION_NONE:
+				file_read(blockoffs, dest, m_hunkbytes);
+				return crc16_creator::simple(dest, m_hunkbytes) == blockcrc;
+		}
+		return false;
+	}
+
+	// failures are reported when the hunk is read for real
+	catch (chd_error &)
+	{
+		return false;
+	}
+}
+
+/**
+ * @fn  void *chd_file::async_prefetch_static(void *param, int threadid)
+ *
+ * @brief   -------------------------------------------------
+ *            async_prefetch_static - work item callback for prefetching a hunk into a cache
+ *            entry
+ *          -------------------------------------------------.
+ *
+ * @param [in,out]  param   If non-null, the cache entry.
+ * @param   threadid        The threadid.
+ *
+ * @return  null.
+ */
+
+void *chd_file::async_prefetch_static(void *param, int threadid)
+{
+	cache_entry &entry = *reinterpret_cast<cache_entry *>(param);
+	chd_file &chd = *entry.m_chd;
+	bool success = chd.prefetch_hunk(entry.m_hunknum, &entry.m_data[0], threadid);
+	{
+		std::lock_guard<std::mutex> lock(chd.m_cachelock);
+		entry.m_state = success ? cache_entry::VALID : cache_entry::EMPTY;
+		entry.m_lastused = ++chd.m_cachestamp;
+	}
+	chd.m_cacheready.notify_all();
+	return nullptr;
+}
+
 
 
 //**************************************************************************
@@ -2762,6 +3172,7 @@ chd_file_compressor::chd_file_compressor()
 		m_read_done_offset(0),
 		m_read_error(false),
 		m_work_queue(nullptr),
+		m_preselect(0),
 		m_write_hunk(0)
 {
 	// zap arrays
@@ -2834,8 +3245,16 @@ void chd_file_compressor::compress_begin()
 	{
 		delete elem;
 		elem = new chd_compressor_group(*this, m_compression);
+		elem->set_preselect(m_preselect);
 	}
 
+	// every hunk predicts from what the hunks written before its work item was
+	// last recycled taught us, regardless of which thread gets to it
+	chd_compressor_group::preselect_reset(m_preselect_table);
+	memset(&m_preselect_stats, 0, sizeof(m_preselect_stats));
+	for (auto & elem : m_work_item)
+		elem.m_pretable = m_preselect_table;
+
 	// reset write state
 	m_write_hunk = 0;
 }
@@ -2948,10 +3367,12 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 			// otherwise, append it compressed and add to the self map
 			hunk_write_compressed(item.m_hunknum, item.m_compression, item.m_compressed, item.m_complen, item.m_hash[0].m_crc16);
 			m_total_out += item.m_complen;
+			chd_compressor_group::preselect_learn(m_preselect_table, m_preselect_stats, item.m_preresult);
 			m_current_map.add(item.m_hunknum, item.m_hash[0].m_crc16, item.m_hash[0].m_sha1);
 		} while (0);
 
-		// reset the item and advance
+		// reset the item and advance; its next hunk is WORK_BUFFER_HUNKS further on
+		item.m_pretable = m_preselect_table;
 		item.m_status = WS_READY;
 		m_write_hunk++;
 
@@ -3080,7 +3501,7 @@ void chd_file_compressor::async_compress_hunk(work_item &item, int threadid)
 	// TODO: data race
 	if (m_current_map.find(item.m_hash[0].m_crc16, item.m_hash[0].m_sha1) == hashmap::NOT_FOUND &&
 		m_parent_map.find(item.m_hash[0].m_crc16, item.m_hash[0].m_sha1) == hashmap::NOT_FOUND)
-		item.m_compression = item.m_codecs->find_best_compressor(item.m_data, item.m_compressed, item.m_complen);
+		item.m_compression = item.m_codecs->find_best_compressor(item.m_data, item.m_compressed, item.m_complen, item.m_hunknum, item.m_pretable, item.m_preresult);
 
 	// mark us complete
 	item.m_status = WS_COMPLETE;
@@ -22,6 +22,8 @@
 #include "hashing.h"
 #include "chdcodec.h"
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 /***************************************************************************
 
@@ -347,6 +349,9 @@ public:
 	chd_error read_bytes(UINT64 offset, void *buffer, UINT32 bytes);
 	chd_error write_bytes(UINT64 offset, const void *buffer, UINT32 bytes);
 
+	// direct access to hunks of a read-only uncompressed file; nullptr if the hunk must be read
+	const void *mapped_hunk(UINT32 hunknum);
+
 	// metadata management
 	chd_error read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, std::string &output);
 	chd_error read_metadata(chd_metadata_tag searchtag, UINT32 searchindex, dynamic_buffer &output);
@@ -364,6 +369,9 @@ public:
 	// codec interfaces
 	chd_error codec_configure(chd_codec_type codec, int param, void *config);
 
+	// cache configuration
+	void configure_cache(UINT32 hunks, UINT32 readahead, bool parallel = false);
+
 	// static helpers
 	static const char *error_string(chd_error err);
 
@@ -371,6 +379,29 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// default cache configuration
+	static const UINT32 DEFAULT_CACHE_HUNKS = 16;
+	static const UINT32 DEFAULT_READAHEAD_HUNKS = 4;
+
+	// a hunk held in the cache
+	struct cache_entry
+	{
+		enum state_t
+		{
+			EMPTY,
+			VALID,
+			PREFETCHING
+		};
+
+		cache_entry() : m_chd(nullptr), m_hunknum(~0), m_lastused(0), m_state(EMPTY) { }
+
+		chd_file *          m_chd;              // owning file, for the prefetch callback
+		dynamic_buffer      m_data;             // hunk data
+		UINT32              m_hunknum;          // which hunk is in this entry?
+		UINT32              m_lastused;         // LRU stamp
+		state_t             m_state;            // current state
+	};
+
 	// inline helpers
 	UINT64 be_read(const UINT8 *base, int numbytes);
 	void be_write(UINT8 *base, UINT64 value, int numbytes);
@@ -399,6 +430,14 @@ private:
 	void metadata_set_previous_next(UINT64 prevoffset, UINT64 nextoffset);
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
+	cache_entry *cache_find(UINT32 hunknum);
+	cache_entry *cache_victim();
+	cache_entry *cache_allocate(UINT32 hunknum);
+	void cache_discard(cache_entry &entry);
+	void cache_readahead(UINT32 hunknum);
+	void cache_reset();
+	bool prefetch_hunk(UINT32 hunknum, UINT8 *dest, int threadid);
+	static void *async_prefetch_static(void *param, int threadid);
 
 	// file characteristics
 	util::core_file *       m_file;             // handle to the open core file
@@ -430,13 +469,28 @@ private:
 	UINT32                  m_mapentrybytes;    // length of each entry in a map
 	dynamic_buffer          m_rawmap;           // raw map data
 
+	// memory-mapped file data
+	const UINT8 *           m_mapped;           // read-only mapping of an uncompressed file, or NULL
+	UINT64                  m_mappedbytes;      // size of the mapping
+
 	// compression management
 	chd_decompressor *      m_decompressor[4];  // array of decompression codecs
 	dynamic_buffer          m_compressed;       // temporary buffer for compressed data
 
 	// caching
-	dynamic_buffer          m_cache;            // single-hunk cache for partial reads/writes
-	UINT32                  m_cachehunk;        // which hunk is in the cache?
+	std::vector<cache_entry> m_cache;           // LRU cache of hunks for partial reads/writes
+	UINT32                  m_cachestamp;       // LRU clock
+	UINT32                  m_readahead;        // hunks to prefetch on sequential reads
+	UINT32                  m_lasthunk;         // last hunk read through the cache
+	std::mutex              m_cachelock;        // protects entry states against the prefetcher
+	std::condition_variable m_cacheready;       // signalled when a prefetch completes
+	std::mutex              m_filelock;         // serializes file reads with the prefetcher
+
+	// read-ahead
+	osd_work_queue *        m_prefetch_queue;   // queue for decompressing hunks ahead of time
+	bool                    m_prefetch_parallel;// decompress on all processors instead of one I/O thread
+	chd_decompressor *      m_prefetch_decompressor[WORK_MAX_THREADS + 1][4]; // codecs private to each prefetch thread
+	dynamic_buffer          m_prefetch_compressed[WORK_MAX_THREADS + 1]; // compressed data buffer for each prefetch thread
 };
 
 
@@ -451,8 +505,10 @@ public:
 	virtual ~chd_file_compressor();
 
 	// compression management
+	void set_preselect(int level) { m_preselect = level; }
 	void compress_begin();
 	chd_error compress_continue(double &progress, double &ratio);
+	const chd_compressor_group::preselect_stats &preselect_stats() const { return m_preselect_stats; }
 
 protected:
 	// required override: read more data
@@ -540,6 +596,8 @@ private:
 		UINT32              m_complen;          // compressed data length
 		INT8                m_compression;      // type of compression used
 		chd_compressor_group *m_codecs;         // codec instance
+		chd_compressor_group::preselect_table m_pretable;   // what the hunks before this one taught us
+		chd_compressor_group::preselect_result m_preresult; // how this hunk was compressed
 		std::vector<hash_pair> m_hash;        // array of hashes
 	};
 
@@ -574,6 +632,9 @@ private:
 	dynamic_buffer          m_compressed_buffer;// buffer containing compressed data
 	work_item               m_work_item[WORK_BUFFER_HUNKS]; // status of each hunk
 	chd_compressor_group *  m_codecs[WORK_MAX_THREADS]; // codecs to use
+	int                     m_preselect;        // codec preselection level
+	chd_compressor_group::preselect_table m_preselect_table; // learned from the hunks written so far
+	chd_compressor_group::preselect_stats m_preselect_stats; // preselection statistics
 
 	// output state
 	UINT32                  m_write_hunk;       // next hunk to write
@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include <assert.h>
+#include <math.h>
 
 #include "chd.h"
 #include "hashing.h"
@@ -616,11 +617,16 @@ const chd_codec_list::codec_entry *chd_codec_list::find_in_list(chd_codec_type t
 
 chd_compressor_group::chd_compressor_group(chd_file &chd, UINT32 compressor_list[4])
 	: m_hunkbytes(chd.hunk_bytes()),
-		m_compress_test(m_hunkbytes)
+		m_compress_test(m_hunkbytes),
+		m_preselect(0),
+		m_trust(0),
+		m_recheck(0)
 #if CHDCODEC_VERIFY_COMPRESSION
 		,m_decompressed(m_hunkbytes)
 #endif
 {
+	set_preselect(0);
+
 	// verify the compression types and initialize the codecs
 	for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
 	{
@@ -652,59 +658,214 @@ chd_compressor_group::~chd_compressor_group()
 }
 
 
+//-------------------------------------------------
+//  set_preselect - configure how readily a codec
+//  that kept winning is tried on its own
+//-------------------------------------------------
+
+void chd_compressor_group::set_preselect(int level)
+{
+	// level 1 rechecks every 16th hunk, level 2 every 64th and trusts sooner
+	m_preselect = MAX(MIN(level, 2), 0);
+	m_trust = (m_preselect >= 2) ? 2 : 4;
+	m_recheck = (m_preselect >= 2) ? 64 : 16;
+}
+
+
+//-------------------------------------------------
+//  preselect_reset - forget anything a table
+//  has learned
+//-------------------------------------------------
+
+void chd_compressor_group::preselect_reset(preselect_table &table)
+{
+	for (int cls = 0; cls < PRESELECT_CLASSES; cls++)
+	{
+		table.m_winner[cls] = -1;
+		table.m_streak[cls] = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  preselect_learn - update a table and the
+//  statistics with the result of a hunk; must be
+//  called in hunk order
+//-------------------------------------------------
+
+void chd_compressor_group::preselect_learn(preselect_table &table, preselect_stats &stats, const preselect_result &result)
+{
+	stats.m_hunks++;
+	if (result.m_class < 0)
+		return;
+
+	// predicted hunks teach us nothing new
+	if (result.m_predicted)
+	{
+		stats.m_predicted++;
+		return;
+	}
+
+	// score the prediction the full trial replaced
+	if (result.m_checked)
+	{
+		stats.m_checked++;
+		if (result.m_mispredicted)
+		{
+			stats.m_mispredicted++;
+			stats.m_lostbytes += result.m_lostbytes;
+		}
+	}
+
+	// learn from the full trial
+	if (result.m_compression == table.m_winner[result.m_class])
+		table.m_streak[result.m_class] = MIN(table.m_streak[result.m_class] + 1, 255);
+	else
+	{
+		table.m_winner[result.m_class] = result.m_compression;
+		table.m_streak[result.m_class] = 1;
+	}
+}
+
+
+//-------------------------------------------------
+//  classify - sort a hunk into a preselection
+//  class by the entropy of its bytes
+//-------------------------------------------------
+
+int chd_compressor_group::classify(const UINT8 *src) const
+{
+	UINT32 histogram[256] = { 0 };
+	for (UINT32 offs = 0; offs < m_hunkbytes; offs++)
+		histogram[src[offs]]++;
+
+	// entropy in bits per byte is log2(n) - sum(c * log2(c)) / n
+	double sum = 0.0;
+	for (auto count : histogram)
+		if (count > 1)
+			sum += count * log2(double(count));
+	double entropy = log2(double(m_hunkbytes)) - sum / double(m_hunkbytes);
+	return MAX(MIN(int(entropy * 2.0), PRESELECT_CLASSES - 1), 0);
+}
+
+
+//-------------------------------------------------
+//  compress_with - compress a hunk into the test
+//  buffer with one codec, returning m_hunkbytes
+//  if it failed or did not help
+//-------------------------------------------------
+
+UINT32 chd_compressor_group::compress_with(int codecnum, const UINT8 *src)
+{
+	// attempt to compress, swallowing errors
+	try
+	{
+		UINT32 compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, &m_compress_test[0]);
+#if CHDCODEC_VERIFY_COMPRESSION
+		try
+		{
+			memset(m_decompressed, 0, m_hunkbytes);
+			m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
+		}
+		catch (...)
+		{
+		}
+
+		if (memcmp(src, m_decompressed, m_hunkbytes) != 0)
+		{
+			compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, m_compress_test);
+			try
+			{
+				m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
+			}
+			catch (...)
+			{
+				memset(m_decompressed, 0, m_hunkbytes);
+			}
+		}
+printf("   codec%d=%d bytes            \n", codecnum, compbytes);
+#endif
+		return MIN(compbytes, m_hunkbytes);
+	}
+	catch (...) { }
+	return m_hunkbytes;
+}
+
+
 //-------------------------------------------------
 //  find_best_compressor - iterate over all codecs
 //  to determine which one produces the best
 //  compression for this hunk
 //-------------------------------------------------
 
-INT8 chd_compressor_group::find_best_compressor(const UINT8 *src, UINT8 *compressed, UINT32 &complen)
+INT8 chd_compressor_group::find_best_compressor(const UINT8 *src, UINT8 *compressed, UINT32 &complen, UINT32 hunknum, const preselect_table &table, preselect_result &result)
 {
+	result.m_class = -1;
+	result.m_predicted = result.m_checked = result.m_mispredicted = false;
+	result.m_lostbytes = 0;
+
+	// if a codec kept winning on this kind of data, try it alone; the recheck
+	// schedule goes by hunk number so it doesn't depend on the thread either
+	INT8 prediction = -1;
+	bool trusted = false;
+	if (m_preselect > 0)
+	{
+		result.m_class = classify(src);
+		prediction = table.m_winner[result.m_class];
+		trusted = (table.m_streak[result.m_class] >= m_trust);
+		if (trusted && hunknum % m_recheck != 0)
+		{
+			if (prediction == -1)
+			{
+				result.m_predicted = true;
+				result.m_compression = -1;
+				complen = m_hunkbytes;
+				memcpy(compressed, src, m_hunkbytes);
+				return -1;
+			}
+
+			// if it fails to compress at all, fall back to trying them all
+			UINT32 compbytes = compress_with(prediction, src);
+			if (compbytes < m_hunkbytes)
+			{
+				result.m_predicted = true;
+				result.m_compression = prediction;
+				complen = compbytes;
+				memcpy(compressed, &m_compress_test[0], compbytes);
+				return prediction;
+			}
+		}
+	}
+
 	// determine best compression technique
 	complen = m_hunkbytes;
 	INT8 compression = -1;
+	UINT32 sizes[4] = { m_hunkbytes, m_hunkbytes, m_hunkbytes, m_hunkbytes };
 	for (int codecnum = 0; codecnum < ARRAY_LENGTH(m_compressor); codecnum++)
 		if (m_compressor[codecnum] != nullptr)
 		{
-			// attempt to compress, swallowing errors
-			try
+			// if this is the best one, copy the data into the permanent buffer
+			UINT32 compbytes = sizes[codecnum] = compress_with(codecnum, src);
+			if (compbytes < complen)
 			{
-				// if this is the best one, copy the data into the permanent buffer
-				UINT32 compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, &m_compress_test[0]);
-#if CHDCODEC_VERIFY_COMPRESSION
-				try
-				{
-					memset(m_decompressed, 0, m_hunkbytes);
-					m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
-				}
-				catch (...)
-				{
-				}
-
-				if (memcmp(src, m_decompressed, m_hunkbytes) != 0)
-				{
-					compbytes = m_compressor[codecnum]->compress(src, m_hunkbytes, m_compress_test);
-					try
-					{
-						m_decompressor[codecnum]->decompress(m_compress_test, compbytes, m_decompressed, m_hunkbytes);
-					}
-					catch (...)
-					{
-						memset(m_decompressed, 0, m_hunkbytes);
-					}
-				}
-printf("   codec%d=%d bytes            \n", codecnum, compbytes);
-#endif
-				if (compbytes < complen)
-				{
-					compression = codecnum;
-					complen = compbytes;
-					memcpy(compressed, &m_compress_test[0], compbytes);
-				}
+				compression = codecnum;
+				complen = compbytes;
+				memcpy(compressed, &m_compress_test[0], compbytes);
 			}
-			catch (...) { }
 		}
 
+	// score the prediction the full trial replaced
+	result.m_compression = compression;
+	if (trusted)
+	{
+		result.m_checked = true;
+		if (compression != prediction)
+		{
+			result.m_mispredicted = true;
+			result.m_lostbytes = ((prediction == -1) ? m_hunkbytes : sizes[prediction]) - complen;
+		}
+	}
+
 	// if the best is none, copy it over
 	if (compression == -1)
 		memcpy(compressed, src, m_hunkbytes);
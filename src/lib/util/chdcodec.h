@@ -142,18 +142,63 @@ private:
 class chd_compressor_group
 {
 public:
+	// hunks are grouped by order-0 entropy, in half bit per byte steps
+	static const int PRESELECT_CLASSES = 17;
+
+	// preselection statistics
+	struct preselect_stats
+	{
+		UINT64              m_hunks;            // hunks compressed
+		UINT64              m_predicted;        // hunks compressed with the predicted codec only
+		UINT64              m_checked;          // predictions checked against a full trial
+		UINT64              m_mispredicted;     // checked predictions that were not the best
+		UINT64              m_lostbytes;        // extra bytes the mispredictions would have cost
+	};
+
+	// what earlier hunks taught us about each class; it is only ever updated
+	// in hunk order, so the output doesn't depend on how work was threaded
+	struct preselect_table
+	{
+		INT8                m_winner[PRESELECT_CLASSES]; // codec that won the last full trials (-1 = none)
+		UINT8               m_streak[PRESELECT_CLASSES]; // consecutive full trials it has won
+	};
+
+	// how a single hunk was compressed, for preselect_learn
+	struct preselect_result
+	{
+		INT8                m_class;            // class of the hunk (-1 = preselection off)
+		INT8                m_compression;      // codec that was used
+		bool                m_predicted;        // only the predicted codec was tried
+		bool                m_checked;          // a full trial replaced a trusted prediction
+		bool                m_mispredicted;     // ... and found a better codec
+		UINT32              m_lostbytes;        // extra bytes the prediction would have cost
+	};
+
 	// construction/destruction
 	chd_compressor_group(chd_file &file, chd_codec_type compressor_list[4]);
 	~chd_compressor_group();
 
-	// find the best compressor
-	INT8 find_best_compressor(const UINT8 *src, UINT8 *compressed, UINT32 &complen);
+	// codec preselection: 0 tries every codec on every hunk, higher levels
+	// trust the codec that kept winning on similar data for longer
+	void set_preselect(int level);
+	static void preselect_reset(preselect_table &table);
+	static void preselect_learn(preselect_table &table, preselect_stats &stats, const preselect_result &result);
+
+	// find the best compressor, predicting from what the table has learned
+	INT8 find_best_compressor(const UINT8 *src, UINT8 *compressed, UINT32 &complen, UINT32 hunknum, const preselect_table &table, preselect_result &result);
 
 private:
+	// internal helpers
+	UINT32 compress_with(int codecnum, const UINT8 *src);
+	int classify(const UINT8 *src) const;
+
 	// internal state
 	UINT32                  m_hunkbytes;        // number of bytes in a hunk
 	chd_compressor *        m_compressor[4];    // array of active codecs
 	dynamic_buffer          m_compress_test;    // test buffer for compression
+	int                     m_preselect;        // preselection level
+	UINT8                   m_trust;            // full trial wins before a codec is predicted
+	UINT32                  m_recheck;          // a full trial is run on every this many hunks
 #if CHDCODEC_VERIFY_COMPRESSION
 	chd_decompressor *      m_decompressor[4];  // array of active codecs
 	dynamic_buffer          m_decompressed;     // verification buffer
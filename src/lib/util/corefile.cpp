@@ -153,6 +153,7 @@ public:
 	virtual int ungetc(int c) override { return m_file.ungetc(c); }
 	virtual char *gets(char *s, int n) override { return m_file.gets(s, n); }
 	virtual const void *buffer() override { return m_file.buffer(); }
+	virtual const void *map() override { return m_file.map(); }
 
 	virtual std::uint32_t write(const void *buffer, std::uint32_t length) override { return m_file.write(buffer, length); }
 	virtual int puts(const char *s) override { return m_file.puts(s); }
@@ -237,6 +238,7 @@ public:
 
 	virtual std::uint32_t read(void *buffer, std::uint32_t length) override;
 	virtual void const *buffer() override { return m_data; }
+	virtual void const *map() override { return m_data; }
 
 	virtual std::uint32_t write(void const *buffer, std::uint32_t length) override { return 0; }
 	virtual file_error truncate(std::uint64_t offset) override;
@@ -295,6 +297,7 @@ public:
 		: core_in_memory_file(openmode, length)
 		, m_file(file)
 		, m_zdata()
+		, m_mapped(nullptr)
 		, m_bufferbase(0)
 		, m_bufferbytes(0)
 	{
@@ -307,6 +310,7 @@ public:
 
 	virtual std::uint32_t read(void *buffer, std::uint32_t length) override;
 	virtual void const *buffer() override;
+	virtual void const *map() override;
 
 	virtual std::uint32_t write(void const *buffer, std::uint32_t length) override;
 	virtual file_error truncate(std::uint64_t offset) override;
@@ -324,6 +328,7 @@ private:
 
 	osd_file *      m_file;                     // OSD file handle
 	zlib_data::ptr  m_zdata;                    // compression data
+	void const *    m_mapped;                   // read-only mapping of the whole file
 	std::uint64_t   m_bufferbase;               // base offset of internal buffer
 	std::uint32_t   m_bufferbytes;              // bytes currently loaded into buffer
 	std::uint8_t    m_buffer[FILE_BUFFER_SIZE]; // buffer data
@@ -730,6 +735,8 @@ core_osd_file::~core_osd_file()
 	// close files and free memory
 	if (m_zdata)
 		compress(FCOMPRESS_NONE);
+	if (m_mapped)
+		osd_unmap(m_mapped, length());
 	if (m_file)
 		osd_close(m_file);
 }
@@ -895,6 +902,29 @@ void const *core_osd_file::buffer()
 }
 
 
+/*-------------------------------------------------
+    map - return a pointer to the file mapped
+    read-only into memory, or nullptr if that
+    isn't possible
+-------------------------------------------------*/
+
+void const *core_osd_file::map()
+{
+	// data that's already in RAM is as good as a mapping
+	if (is_loaded())
+		return core_in_memory_file::map();
+
+	// writes and streaming decompression need to go through read/write
+	if (!m_mapped && m_file && !m_zdata && !write_access() && length())
+	{
+		void const *base;
+		if (osd_map(m_file, length(), &base) == FILERR_NONE)
+			m_mapped = base;
+	}
+	return m_mapped;
+}
+
+
 /*-------------------------------------------------
     write - write to a file
 -------------------------------------------------*/
@@ -100,6 +100,10 @@ public:
 	// this function may cause the full file data to be read
 	virtual const void *buffer() = 0;
 
+	// get a pointer to the full file data mapped read-only into memory,
+	// or nullptr if the file can't be mapped; valid until the file is closed
+	virtual const void *map() = 0;
+
 	// open a file with the specified filename, read it into memory, and return a pointer
 	static file_error load(const char *filename, void **data, std::uint32_t &length);
 	static file_error load(const char *filename, dynamic_buffer &data);
@@ -16,6 +16,8 @@
 #include <ctype.h>
 #include <stdlib.h>
 #include <zlib.h>
+#include <mutex>
+#include <vector>
 
 /***************************************************************************
     7Zip Memory / File handling (adapted from 7zfile.c/.h and 7zalloc.c/.h)
@@ -161,6 +163,9 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
 /* number of open files to cache */
 #define _7Z_CACHE_SIZE  8
 
+/* default decoded data kept per archive */
+#define _7Z_DEFAULT_BLOCK_BUDGET    (64 * 1024 * 1024)
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -168,6 +173,11 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
 
 static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
 
+/* guards _7z_cache, so archives may be opened and closed from worker threads */
+static std::mutex _7z_cache_lock;
+
+static UINT64 _7z_block_cache_budget = _7Z_DEFAULT_BLOCK_BUDGET;
+
 /***************************************************************************
     FUNCTION PROTOTYPES
 ***************************************************************************/
@@ -175,6 +185,14 @@ static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
 /* cache management */
 static void free__7z_file(_7z_file *_7z);
 
+/* solid block cache */
+static SRes block_extract(_7z_file *_7z, ILookInStream *stream, int fileindex, _7z_block *block, size_t *offset, size_t *size);
+static _7z_block *block_find(_7z_file *_7z, UInt32 blockindex);
+static _7z_block *block_victim(_7z_file *_7z);
+static void block_free(_7z_file *_7z, _7z_block *block);
+static void block_trim(_7z_file *_7z, const _7z_block *keep, UINT64 budget);
+static _7z_error copy_from_block(_7z_file *_7z, _7z_request &request, _7z_block *block);
+
 
 /***************************************************************************
     _7Z FILE ACCESS
@@ -291,16 +309,19 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 	*_7z = nullptr;
 
 	/* see if we are in the cache, and reopen if so */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 	{
-		_7z_file *cached = _7z_cache[cachenum];
-
-		/* if we have a valid entry and it matches our filename, use it and remove from the cache */
-		if (cached != nullptr && cached->filename != nullptr && strcmp(filename, cached->filename) == 0)
+		std::lock_guard<std::mutex> guard(_7z_cache_lock);
+		for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		{
-			*_7z = cached;
-			_7z_cache[cachenum] = nullptr;
-			return _7ZERR_NONE;
+			_7z_file *cached = _7z_cache[cachenum];
+
+			/* if we have a valid entry and it matches our filename, use it and remove from the cache */
+			if (cached != nullptr && cached->filename != nullptr && strcmp(filename, cached->filename) == 0)
+			{
+				*_7z = cached;
+				_7z_cache[cachenum] = nullptr;
+				return _7ZERR_NONE;
+			}
 		}
 	}
 
@@ -349,9 +370,9 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		goto error;
 	}
 
-	new_7z->blockIndex = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
-	new_7z->outBuffer = nullptr; /* it must be 0 before first call for each new archive. */
-	new_7z->outBufferSize = 0;  /* it can have any value before first call (if outBuffer = 0) */
+	for (auto & block : new_7z->blocks)
+		block.index = 0xFFFFFFFF;
+	new_7z->blockstamp = 0;
 
 	/* make a copy of the filename for caching purposes */
 	string = (char *)malloc(strlen(filename) + 1);
@@ -386,6 +407,7 @@ void _7z_file_close(_7z_file *_7z)
 	_7z->archiveStream.file._7z_osdfile = nullptr;
 
 	/* find the first NULL entry in the cache */
+	std::lock_guard<std::mutex> guard(_7z_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		if (_7z_cache[cachenum] == nullptr)
 			break;
@@ -411,6 +433,7 @@ void _7z_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
+	std::lock_guard<std::mutex> guard(_7z_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		if (_7z_cache[cachenum] != nullptr)
 		{
@@ -420,6 +443,48 @@ void _7z_file_cache_clear(void)
 }
 
 
+/*-------------------------------------------------
+    _7z_set_block_cache_budget - set how many
+    bytes of decoded solid blocks each archive
+    may keep
+-------------------------------------------------*/
+
+void _7z_set_block_cache_budget(UINT64 bytes)
+{
+	_7z_block_cache_budget = bytes;
+}
+
+
+/*-------------------------------------------------
+    _7z_get_block_cache_budget - return how many
+    bytes of decoded solid blocks each archive
+    may keep
+-------------------------------------------------*/
+
+UINT64 _7z_get_block_cache_budget(void)
+{
+	return _7z_block_cache_budget;
+}
+
+
+/*-------------------------------------------------
+    _7z_file_reopen - make sure the archive's own
+    file handle is open
+-------------------------------------------------*/
+
+static _7z_error _7z_file_reopen(_7z_file *new_7z)
+{
+	if (new_7z->archiveStream.file._7z_osdfile == nullptr)
+	{
+		new_7z->archiveStream.file._7z_currfpos = 0;
+		file_error err = osd_open(new_7z->filename, OPEN_FLAG_READ, &new_7z->archiveStream.file._7z_osdfile, &new_7z->archiveStream.file._7z_length);
+		if (err != FILERR_NONE)
+			return _7ZERR_FILE_ERROR;
+	}
+	return _7ZERR_NONE;
+}
+
+
 /*-------------------------------------------------
     _7z_file_decompress - decompress a file
     from a _7Z into the target buffer
@@ -427,32 +492,211 @@ void _7z_file_cache_clear(void)
 
 _7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length)
 {
-	file_error err;
 	SRes res;
 	int index = new_7z->curr_file_idx;
 
 	/* make sure the file is open.. */
-	if (new_7z->archiveStream.file._7z_osdfile==nullptr)
+	_7z_error _7zerr = _7z_file_reopen(new_7z);
+	if (_7zerr != _7ZERR_NONE)
+		return _7zerr;
+
+	/* empty files don't live in any block */
+	UInt32 blockindex = new_7z->db.FileIndexToFolderIndexMap[index];
+	if (blockindex == 0xFFFFFFFF)
+		return _7ZERR_NONE;
+
+	/* reuse the block if we decoded it recently, otherwise decode it over the oldest one */
+	_7z_block *block = block_find(new_7z, blockindex);
+	if (block == nullptr)
 	{
-		new_7z->archiveStream.file._7z_currfpos = 0;
-		err = osd_open(new_7z->filename, OPEN_FLAG_READ, &new_7z->archiveStream.file._7z_osdfile, &new_7z->archiveStream.file._7z_length);
-		if (err != FILERR_NONE)
-			return _7ZERR_FILE_ERROR;
+		block = block_victim(new_7z);
+		block->lastused = ++new_7z->blockstamp;
 	}
 
 	size_t offset = 0;
 	size_t outSizeProcessed = 0;
 
-	res = SzArEx_Extract(&new_7z->db, &new_7z->lookStream.s, index,
-		&new_7z->blockIndex, &new_7z->outBuffer, &new_7z->outBufferSize,
-		&offset, &outSizeProcessed,
-		&new_7z->allocImp, &new_7z->allocTempImp);
-
+	res = block_extract(new_7z, &new_7z->lookStream.s, index, block, &offset, &outSizeProcessed);
 	if (res != SZ_OK)
+	{
+		block_free(new_7z, block);
 		return _7ZERR_FILE_ERROR;
+	}
 
-	memcpy(buffer, new_7z->outBuffer + offset, length);
+	memcpy(buffer, block->data + offset, length);
 
+	block_trim(new_7z, block, _7z_block_cache_budget);
+	return _7ZERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    decode_block_static - work item callback that
+    decodes one solid block through a private
+    file handle
+-------------------------------------------------*/
+
+namespace {
+
+struct _7z_decode_job
+{
+	_7z_file *      archive;                /* archive being decoded */
+	int             file_index;             /* any file in the block */
+	_7z_block       block;                  /* the decoded block */
+	SRes            res;                    /* result of decoding */
+};
+
+} // anonymous namespace
+
+static void *decode_block_static(void *param, int threadid)
+{
+	_7z_decode_job &job = *reinterpret_cast<_7z_decode_job *>(param);
+	_7z_file *_7z = job.archive;
+
+	/* the archive's own stream can't be shared, so each block gets a handle of its own */
+	CFileInStream stream;
+	CLookToRead look;
+	memset(&stream, 0, sizeof(stream));
+	job.res = SZ_ERROR_READ;
+	if (osd_open(_7z->filename, OPEN_FLAG_READ, &stream.file._7z_osdfile, &stream.file._7z_length) != FILERR_NONE)
+		return nullptr;
+
+	FileInStream_CreateVTable(&stream);
+	LookToRead_CreateVTable(&look, False);
+	look.realStream = &stream.s;
+	LookToRead_Init(&look);
+
+	size_t offset, size;
+	job.res = block_extract(_7z, &look.s, job.file_index, &job.block, &offset, &size);
+	osd_close(stream.file._7z_osdfile);
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    _7z_file_decompress_multiple - decompress a
+    set of files, decoding each solid block they
+    need only once and independent blocks on
+    several threads
+-------------------------------------------------*/
+
+_7z_error _7z_file_decompress_multiple(_7z_file *_7z, _7z_request *requests, int count)
+{
+	/* make sure the file is open.. */
+	_7z_error _7zerr = _7z_file_reopen(_7z);
+	if (_7zerr != _7ZERR_NONE)
+		return _7zerr;
+
+	/* files in blocks we already have can be copied out right away */
+	std::vector<_7z_decode_job> jobs;
+	for (int reqnum = 0; reqnum < count; reqnum++)
+	{
+		_7z_request &request = requests[reqnum];
+		request.error = _7ZERR_NONE;
+		UInt32 blockindex = _7z->db.FileIndexToFolderIndexMap[request.file_index];
+		if (blockindex == 0xFFFFFFFF)
+			continue;
+
+		_7z_block *block = block_find(_7z, blockindex);
+		if (block != nullptr)
+		{
+			request.error = copy_from_block(_7z, request, block);
+			continue;
+		}
+
+		/* gather the ones that need decoding */
+		bool queued = false;
+		for (auto & job : jobs)
+			if (_7z->db.FileIndexToFolderIndexMap[job.file_index] == blockindex)
+				queued = true;
+		if (queued)
+			continue;
+
+		_7z_decode_job job = { _7z, request.file_index, { 0xFFFFFFFF, nullptr, 0, 0 }, SZ_OK };
+		jobs.push_back(job);
+	}
+
+	/* decode in groups that fit the budget, along with what is cached; a block
+	   larger than the budget gets a group of its own */
+	osd_work_queue *queue = nullptr;
+	for (size_t first = 0, last; first < jobs.size(); first = last)
+	{
+		UINT64 groupsize = 0;
+		for (last = first; last < jobs.size(); last++)
+		{
+			UINT64 size = SzFolder_GetUnpackSize(_7z->db.db.Folders + _7z->db.FileIndexToFolderIndexMap[jobs[last].file_index]);
+			if (last != first && groupsize + size > _7z_block_cache_budget)
+				break;
+			groupsize += size;
+		}
+		block_trim(_7z, nullptr, (groupsize < _7z_block_cache_budget) ? _7z_block_cache_budget - groupsize : 0);
+
+		/* blocks are independent of each other, so decode them side by side */
+		if (last - first > 1 && queue == nullptr)
+			queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		if (last - first > 1 && queue != nullptr)
+		{
+			osd_work_item_queue_multiple(queue, decode_block_static, last - first, &jobs[first], sizeof(jobs[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+		}
+		else
+		{
+			for (size_t jobnum = first; jobnum < last; jobnum++)
+				decode_block_static(&jobs[jobnum], 0);
+		}
+
+		/* copy out each file from the group's blocks */
+		for (int reqnum = 0; reqnum < count; reqnum++)
+		{
+			_7z_request &request = requests[reqnum];
+			UInt32 blockindex = _7z->db.FileIndexToFolderIndexMap[request.file_index];
+			for (size_t jobnum = first; jobnum < last; jobnum++)
+				if (_7z->db.FileIndexToFolderIndexMap[jobs[jobnum].file_index] == blockindex)
+				{
+					_7z_decode_job &job = jobs[jobnum];
+					request.error = (job.res == SZ_OK && job.block.data != nullptr) ? copy_from_block(_7z, request, &job.block) : _7ZERR_FILE_ERROR;
+				}
+		}
+
+		/* hand the new blocks over to the cache */
+		_7z_block *newest = nullptr;
+		for (size_t jobnum = first; jobnum < last; jobnum++)
+		{
+			_7z_decode_job &job = jobs[jobnum];
+			if (job.res != SZ_OK || job.block.data == nullptr)
+			{
+				block_free(_7z, &job.block);
+				continue;
+			}
+			newest = block_victim(_7z);
+			block_free(_7z, newest);
+			*newest = job.block;
+			newest->lastused = ++_7z->blockstamp;
+		}
+		block_trim(_7z, newest, _7z_block_cache_budget);
+	}
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
+
+	/* report the first failure */
+	for (int reqnum = 0; reqnum < count; reqnum++)
+		if (requests[reqnum].error != _7ZERR_NONE)
+			return requests[reqnum].error;
+	return _7ZERR_NONE;
+}
+
+
+/*-------------------------------------------------
+    copy_from_block - copy a requested file out
+    of a decoded solid block
+-------------------------------------------------*/
+
+static _7z_error copy_from_block(_7z_file *_7z, _7z_request &request, _7z_block *block)
+{
+	size_t offset, size;
+	if (block_extract(_7z, &_7z->lookStream.s, request.file_index, block, &offset, &size) != SZ_OK)
+		return _7ZERR_FILE_ERROR;
+	memcpy(request.buffer, block->data + offset, request.length);
 	return _7ZERR_NONE;
 }
 
@@ -485,10 +729,108 @@ static void free__7z_file(_7z_file *_7z)
 			free((void *)_7z->filename);
 
 
-		if (_7z->outBuffer) IAlloc_Free(&_7z->allocImp, _7z->outBuffer);
+		for (auto & block : _7z->blocks)
+			block_free(_7z, &block);
 		if (_7z->inited) SzArEx_Free(&_7z->db, &_7z->allocImp);
 
 
 		free(_7z);
 	}
 }
+
+
+
+/***************************************************************************
+    SOLID BLOCK CACHE
+***************************************************************************/
+
+/*-------------------------------------------------
+    block_extract - locate a file's data within a
+    solid block, first decoding the block into the
+    entry if it holds a different one
+-------------------------------------------------*/
+
+static SRes block_extract(_7z_file *_7z, ILookInStream *stream, int fileindex, _7z_block *block, size_t *offset, size_t *size)
+{
+	return SzArEx_Extract(&_7z->db, stream, fileindex,
+		&block->index, &block->data, &block->size,
+		offset, size,
+		&_7z->allocImp, &_7z->allocTempImp);
+}
+
+
+/*-------------------------------------------------
+    block_find - return the cache entry holding a
+    solid block, marking it as recently used
+-------------------------------------------------*/
+
+static _7z_block *block_find(_7z_file *_7z, UInt32 blockindex)
+{
+	for (auto & block : _7z->blocks)
+		if (block.data != nullptr && block.index == blockindex)
+		{
+			block.lastused = ++_7z->blockstamp;
+			return &block;
+		}
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    block_victim - pick an unused or else the
+    least recently used cache entry
+-------------------------------------------------*/
+
+static _7z_block *block_victim(_7z_file *_7z)
+{
+	_7z_block *victim = &_7z->blocks[0];
+	for (auto & block : _7z->blocks)
+	{
+		if (block.data == nullptr)
+			return &block;
+		if (block.lastused < victim->lastused)
+			victim = &block;
+	}
+	return victim;
+}
+
+
+/*-------------------------------------------------
+    block_free - release a cache entry's data
+-------------------------------------------------*/
+
+static void block_free(_7z_file *_7z, _7z_block *block)
+{
+	if (block->data != nullptr)
+		IAlloc_Free(&_7z->allocImp, block->data);
+	block->index = 0xFFFFFFFF;
+	block->data = nullptr;
+	block->size = 0;
+	block->lastused = 0;
+}
+
+
+/*-------------------------------------------------
+    block_trim - drop the least recently used
+    blocks until the archive is within a budget,
+    never dropping the one just used
+-------------------------------------------------*/
+
+static void block_trim(_7z_file *_7z, const _7z_block *keep, UINT64 budget)
+{
+	for (;;)
+	{
+		UINT64 total = 0;
+		_7z_block *oldest = nullptr;
+		for (auto & block : _7z->blocks)
+			if (block.data != nullptr)
+			{
+				total += block.size;
+				if (&block != keep && (oldest == nullptr || block.lastused < oldest->lastused))
+					oldest = &block;
+			}
+		if (total <= budget || oldest == nullptr)
+			return;
+		block_free(_7z, oldest);
+	}
+}
@@ -69,6 +69,9 @@ void FileOutStream_CreateVTable(CFileOutStream *p);
 ***************************************************************************/
 
 
+/* number of decoded solid blocks kept per archive */
+#define _7Z_BLOCK_CACHE_SIZE    16
+
 /* Error types */
 enum _7z_error
 {
@@ -89,6 +92,24 @@ enum _7z_error
     TYPE DEFINITIONS
 ***************************************************************************/
 
+/* a decoded solid block */
+struct _7z_block
+{
+	UInt32          index;                  /* solid block index, 0xFFFFFFFF if unused */
+	Byte *          data;                   /* decoded data, allocated with allocImp */
+	size_t          size;                   /* size of the decoded data */
+	UINT32          lastused;               /* LRU stamp */
+};
+
+/* one file to extract with _7z_file_decompress_multiple */
+struct _7z_request
+{
+	int             file_index;             /* index returned by _7z_search_crc_match */
+	void *          buffer;                 /* destination */
+	UINT32          length;                 /* bytes to copy */
+	_7z_error       error;                  /* result for this file */
+};
+
 /* describes an open _7Z file */
 struct  _7z_file
 {
@@ -107,9 +128,8 @@ struct  _7z_file
 	bool inited;
 
 	// cached stuff for solid blocks
-	UInt32 blockIndex;// = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
-	Byte *outBuffer;// = 0; /* it must be 0 before first call for each new archive. */
-	size_t outBufferSize;// = 0;  /* it can have any value before first call (if outBuffer = 0) */
+	_7z_block blocks[_7Z_BLOCK_CACHE_SIZE]; /* recently decoded solid blocks */
+	UINT32 blockstamp;                      /* LRU clock for the blocks */
 };
 
 
@@ -130,6 +150,10 @@ void _7z_file_close(_7z_file *_7z);
 /* clear out all open _7Z files from the cache */
 void _7z_file_cache_clear(void);
 
+/* set how much decoded data each archive may keep around; the most recent block is always kept */
+void _7z_set_block_cache_budget(UINT64 bytes);
+UINT64 _7z_get_block_cache_budget(void);
+
 
 /* ----- contained file access ----- */
 
@@ -139,5 +163,9 @@ int _7z_search_crc_match(_7z_file *new_7z, UINT32 crc, const char *search_filena
 /* decompress the most recently found file in the _7Z */
 _7z_error _7z_file_decompress(_7z_file *_7z, void *buffer, UINT32 length);
 
+/* decompress several files, decoding each solid block once and independent blocks in parallel,
+   a group of blocks within the budget at a time */
+_7z_error _7z_file_decompress_multiple(_7z_file *_7z, _7z_request *requests, int count);
+
 
 #endif  /* __UN_7Z_H__ */
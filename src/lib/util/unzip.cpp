@@ -14,6 +14,7 @@
 #include <ctype.h>
 #include <stdlib.h>
 #include <zlib.h>
+#include <mutex>
 
 
 
@@ -137,6 +138,9 @@ static inline UINT32 read_dword(UINT8 *buf)
 /** @brief  The zip cache[ zip cache size]. */
 static zip_file *zip_cache[ZIP_CACHE_SIZE];
 
+/** @brief  Guards zip_cache, so files may be closed from worker threads. */
+static std::mutex zip_cache_lock;
+
 
 
 /***************************************************************************
@@ -188,16 +192,19 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 	*zip = nullptr;
 
 	/* see if we are in the cache, and reopen if so */
-	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 	{
-		zip_file *cached = zip_cache[cachenum];
-
-		/* if we have a valid entry and it matches our filename, use it and remove from the cache */
-		if (cached != nullptr && cached->filename != nullptr && strcmp(filename, cached->filename) == 0)
+		std::lock_guard<std::mutex> guard(zip_cache_lock);
+		for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 		{
-			*zip = cached;
-			zip_cache[cachenum] = nullptr;
-			return ZIPERR_NONE;
+			zip_file *cached = zip_cache[cachenum];
+
+			/* if we have a valid entry and it matches our filename, use it and remove from the cache */
+			if (cached != nullptr && cached->filename != nullptr && strcmp(filename, cached->filename) == 0)
+			{
+				*zip = cached;
+				zip_cache[cachenum] = nullptr;
+				return ZIPERR_NONE;
+			}
 		}
 	}
 
@@ -284,6 +291,7 @@ void zip_file_close(zip_file *zip)
 	zip->file = nullptr;
 
 	/* find the first NULL entry in the cache */
+	std::lock_guard<std::mutex> guard(zip_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 		if (zip_cache[cachenum] == nullptr)
 			break;
@@ -315,6 +323,7 @@ void zip_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
+	std::lock_guard<std::mutex> guard(zip_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 		if (zip_cache[cachenum] != nullptr)
 		{
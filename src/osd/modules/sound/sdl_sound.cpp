@@ -9,6 +9,7 @@
 //============================================================
 
 #include "sound_module.h"
+#include "sound_ring.h"
 #include "modules/osdmodule.h"
 
 #if (defined(OSD_SDL) || defined(USE_SDL_SOUND))
@@ -50,8 +51,8 @@ public:
 	sound_sdl()
 	: osd_module(OSD_SOUND_PROVIDER, "sdl"), sound_module(),
 		stream_in_initialized(0),
-		stream_loop(0),
-		attenuation(0)
+		attenuation(0),
+		stream_latency(0)
 	{
 		sdl_xfer_samples = SDL_XFER_SAMPLES;
 	}
@@ -66,31 +67,18 @@ public:
 	virtual void set_mastervolume(int attenuation) override;
 
 private:
-	int lock_buffer(bool is_throttled, long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2);
-	void unlock_buffer(void);
-	void att_memcpy(void *dest, const INT16 *data, int bytes_to_copy);
-	void copy_sample_data(bool is_throttled, const INT16 *data, int bytes_to_copy);
-	int sdl_create_buffers(void);
+	int sdl_create_buffers(int audio_latency);
 	void sdl_destroy_buffers(void);
 
 	int sdl_xfer_samples;
 	int stream_in_initialized;
-	int stream_loop;
 	int attenuation;
 
-	int              buf_locked;
-
-	INT8             *stream_buffer;
-	volatile INT32   stream_playpos;
-
-	UINT32           stream_buffer_size;
-	UINT32           stream_buffer_in;
-
-	// buffer over/underflow counts
-	int              buffer_underflows;
-	int              buffer_overflows;
-
+	// written by update_audio_stream, read by sdl_callback
+	sound_ring       stream_ring;
 
+	// frames queued ahead of the callback when starting or after it ran dry
+	UINT32           stream_latency;
 };
 
 
@@ -108,140 +96,6 @@ private:
 // debugging
 static FILE *sound_log;
 
-//============================================================
-//  sound_sdl - destructor
-//============================================================
-
-//============================================================
-//  lock_buffer
-//============================================================
-int sound_sdl::lock_buffer(bool is_throttled, long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2)
-{
-	volatile long pstart, pend, lstart, lend;
-
-	if (!buf_locked)
-	{
-		if (is_throttled)
-		{
-			pstart = stream_playpos;
-			pend = (pstart + sdl_xfer_samples);
-			lstart = offset;
-			lend = lstart+size;
-			while (((pstart >= lstart) && (pstart <= lend)) ||
-					((pend >= lstart) && (pend <= lend)))
-			{
-				pstart = stream_playpos;
-				pend = pstart + sdl_xfer_samples;
-			}
-		}
-
-		SDL_LockAudio();
-		buf_locked++;
-	}
-
-	// init lengths
-	*length1 = *length2 = 0;
-
-	if ((offset + size) > stream_buffer_size)
-	{
-		// 2-piece case
-		*length1 = stream_buffer_size - offset;
-		*buffer1 = &stream_buffer[offset];
-		*length2 = size - *length1;
-		*buffer2 = stream_buffer;
-	}
-	else
-	{
-		// normal 1-piece case
-		*length1 = size;
-		*buffer1 = &stream_buffer[offset];
-	}
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "locking %ld bytes at offset %ld (total %d, playpos %d): len1 %ld len2 %ld\n",
-			size, offset, stream_buffer_size, stream_playpos, *length1, *length2);
-
-	return 0;
-}
-
-//============================================================
-//  unlock_buffer
-//============================================================
-void sound_sdl::unlock_buffer(void)
-{
-	buf_locked--;
-	if (!buf_locked)
-		SDL_UnlockAudio();
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "unlocking\n");
-
-}
-
-//============================================================
-//  Apply attenuation
-//============================================================
-
-void sound_sdl::att_memcpy(void *dest, const INT16 *data, int bytes_to_copy)
-{
-	int level= (int) (pow(10.0, (double) attenuation / 20.0) * 128.0);
-	INT16 *d = (INT16 *) dest;
-	int count = bytes_to_copy/2;
-	while (count>0)
-	{
-		*d++ = (*data++ * level) >> 7; /* / 128 */
-		count--;
-	}
-}
-
-//============================================================
-//  copy_sample_data
-//============================================================
-
-void sound_sdl::copy_sample_data(bool is_throttled, const INT16 *data, int bytes_to_copy)
-{
-	void *buffer1, *buffer2 = (void *)NULL;
-	long length1, length2;
-	int cur_bytes;
-
-	// attempt to lock the stream buffer
-	if (lock_buffer(is_throttled, stream_buffer_in, bytes_to_copy, &buffer1, &length1, &buffer2, &length2) < 0)
-	{
-		buffer_underflows++;
-		return;
-	}
-
-	// adjust the input pointer
-	stream_buffer_in += bytes_to_copy;
-	if (stream_buffer_in >= stream_buffer_size)
-	{
-		stream_buffer_in -= stream_buffer_size;
-		stream_loop = 1;
-
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 1 (stream_buffer_in looped)\n");
-	}
-
-	// copy the first chunk
-	cur_bytes = (bytes_to_copy > length1) ? length1 : bytes_to_copy;
-	att_memcpy(buffer1, data, cur_bytes);
-
-	// adjust for the number of bytes
-	bytes_to_copy -= cur_bytes;
-	data = (INT16 *)((UINT8 *)data + cur_bytes);
-
-	// copy the second chunk
-	if (bytes_to_copy != 0)
-	{
-		cur_bytes = (bytes_to_copy > length2) ? length2 : bytes_to_copy;
-		att_memcpy(buffer2, data, cur_bytes);
-	}
-
-	// unlock
-	unlock_buffer();
-}
-
-
 //============================================================
 //  update_audio_stream
 //============================================================
@@ -249,77 +103,40 @@ void sound_sdl::copy_sample_data(bool is_throttled, const INT16 *data, int bytes
 void sound_sdl::update_audio_stream(bool is_throttled, const INT16 *buffer, int samples_this_frame)
 {
 	// if nothing to do, don't do it
-	if (sample_rate() != 0 && stream_buffer)
-	{
-		int bytes_this_frame = samples_this_frame * sizeof(INT16) * 2;
-		int play_position, write_position, stream_in;
-		int orig_write; // used in LOG
+	if (sample_rate() == 0 || stream_ring.capacity() == 0)
+		return;
 
-		play_position = stream_playpos;
+	// rebuild the latency cushion at startup and whenever the callback caught up with us
+	if (!stream_in_initialized || stream_ring.fill() == 0)
+	{
+		if (LOG_SOUND)
+			fprintf(sound_log, "queueing %u frames of silence (underruns %u)\n", stream_latency, stream_ring.underruns());
 
-		write_position = stream_playpos + ((sample_rate() / 50) * sizeof(INT16) * 2);
-		orig_write = write_position;
+		stream_ring.write_silence(stream_latency);
 
 		if (!stream_in_initialized)
 		{
-			stream_in = stream_buffer_in = (write_position + stream_buffer_size) / 2;
-
-			if (LOG_SOUND)
-			{
-				fprintf(sound_log, "stream_in = %d\n", (int)stream_in);
-				fprintf(sound_log, "stream_playpos = %d\n", (int)stream_playpos);
-				fprintf(sound_log, "write_position = %d\n", (int)write_position);
-			}
 			// start playing
 			SDL_PauseAudio(0);
-
 			stream_in_initialized = 1;
 		}
-		else
-		{
-			// normalize the stream in position
-			stream_in = stream_buffer_in;
-			if (stream_in < write_position && stream_loop == 1)
-				stream_in += stream_buffer_size;
-
-			// now we should have, in order:
-			//    <------pp---wp---si--------------->
-
-			// if we're between play and write positions, then bump forward, but only in full chunks
-			while (stream_in < write_position)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Underflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_underflows++;
-				stream_in += bytes_this_frame;
-			}
-
-			// if we're going to overlap the play position, just skip this chunk
-			if (stream_in + bytes_this_frame > play_position + stream_buffer_size)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Overflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_overflows++;
-				return;
-			}
-		}
-
-		if (stream_in >= stream_buffer_size)
-		{
-			stream_in -= stream_buffer_size;
-			stream_loop = 1;
-
-			if (LOG_SOUND)
-				fprintf(sound_log, "stream_loop set to 1 (stream_in looped)\n");
-
-		}
+	}
 
-		// now we know where to copy; let's do it
-		stream_buffer_in = stream_in;
-		copy_sample_data(is_throttled, buffer, bytes_this_frame);
+	// when throttled, wait for the callback to make room as the old locked
+	// buffer did; give up after a full ring's worth of playback so a stalled
+	// audio device can't hang emulation, and don't wait at all while playback
+	// is paused at minimum volume since nothing will drain the ring
+	if (is_throttled && stream_in_initialized && attenuation != -32 && stream_ring.space() < samples_this_frame)
+	{
+		const osd_ticks_t limit = osd_ticks() + osd_ticks_per_second() * stream_ring.capacity() / sample_rate();
+		while (stream_ring.space() < samples_this_frame && osd_ticks() < limit)
+			osd_sleep(osd_ticks_per_second() / 1000);
 	}
+
+	// a frame that still doesn't fit is skipped rather than overwriting unplayed data
+	int level = (int) (pow(10.0, (double) attenuation / 20.0) * 128.0);
+	if (!stream_ring.write(buffer, samples_this_frame, level) && LOG_SOUND)
+		fprintf(sound_log, "Overflow: fill=%u frames=%d\n", stream_ring.fill(), samples_this_frame);
 }
 
 
@@ -348,53 +165,13 @@ void sound_sdl::set_mastervolume(int _attenuation)
 static void sdl_callback(void *userdata, Uint8 *stream, int len)
 {
 	sound_sdl *thiz = (sound_sdl *) userdata;
-	int len1, len2, sb_in;
+	UINT32 frames = len / (sizeof(INT16) * 2);
 
-	sb_in = thiz->stream_buffer_in;
-	if (thiz->stream_loop)
-		sb_in += thiz->stream_buffer_size;
+	// pads with silence if the emulation fell behind
+	UINT32 played = thiz->stream_ring.read((INT16 *)stream, frames);
 
-	if (sb_in < (thiz->stream_playpos+len))
-	{
-		if (LOG_SOUND)
-			fprintf(sound_log, "Underflow at sdl_callback: SPP=%d SBI=%d(%d) Len=%d\n", (int)thiz->stream_playpos, (int)sb_in, (int)thiz->stream_buffer_in, (int)len);
-
-		return;
-	}
-	else if ((thiz->stream_playpos+len) > thiz->stream_buffer_size)
-	{
-		len1 = thiz->stream_buffer_size - thiz->stream_playpos;
-		len2 = len - len1;
-	}
-	else
-	{
-		len1 = len;
-		len2 = 0;
-	}
-
-	memcpy(stream, thiz->stream_buffer + thiz->stream_playpos, len1);
-	memset(thiz->stream_buffer + thiz->stream_playpos, 0, len1); // no longer needed
-	if (len2)
-	{
-		memcpy(stream+len1, thiz->stream_buffer, len2);
-		memset(thiz->stream_buffer, 0, len2); // no longer needed
-	}
-
-
-	// move the play cursor
-	thiz->stream_playpos += len1 + len2;
-	if (thiz->stream_playpos >= thiz->stream_buffer_size)
-	{
-		thiz->stream_playpos -= thiz->stream_buffer_size;
-		thiz->stream_loop = 0;
-
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 0 (stream_playpos looped)\n");
-	}
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "callback: xfer len1 %d len2 %d, playpos %d\n",
-				len1, len2, thiz->stream_playpos);
+	if (LOG_SOUND && played < frames)
+		fprintf(sound_log, "Underflow at sdl_callback: wanted %u frames, got %u\n", frames, played);
 }
 
 
@@ -426,7 +203,6 @@ int sound_sdl::init(const osd_options &options)
 
 		sdl_xfer_samples = SDL_XFER_SAMPLES;
 		stream_in_initialized = 0;
-		stream_loop = 0;
 
 		// set up the audio specs
 		aspec.freq = sample_rate();
@@ -448,13 +224,7 @@ int sound_sdl::init(const osd_options &options)
 		audio_latency = MAX(MIN(m_audio_latency, MAX_AUDIO_LATENCY), 1);
 
 		// compute the buffer sizes
-		stream_buffer_size = (sample_rate() * 2 * sizeof(INT16) * (2 + audio_latency)) / 30;
-		stream_buffer_size = (stream_buffer_size / 1024) * 1024;
-		if (stream_buffer_size < 1024)
-			stream_buffer_size = 1024;
-
-		// create the buffers
-		if (sdl_create_buffers())
+		if (sdl_create_buffers(audio_latency))
 			goto cant_create_buffers;
 
 		// set the startup volume
@@ -490,18 +260,19 @@ void sound_sdl::exit()
 
 	SDL_QuitSubSystem(SDL_INIT_AUDIO);
 
-	// kill the buffers
-	sdl_destroy_buffers();
-
 	// print out over/underflow stats
-	if (buffer_overflows || buffer_underflows)
-		osd_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+	if (stream_ring.overruns() || stream_ring.underruns())
+		osd_printf_verbose("Sound buffer: overflows=%u underflows=%u\n", stream_ring.overruns(), stream_ring.underruns());
+	osd_printf_verbose("Sound buffer: queued %u to %u frames at callback\n", stream_ring.min_fill(), stream_ring.max_fill());
 
 	if (LOG_SOUND)
 	{
-		fprintf(sound_log, "Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+		fprintf(sound_log, "Sound buffer: overflows=%u underflows=%u\n", stream_ring.overruns(), stream_ring.underruns());
 		fclose(sound_log);
 	}
+
+	// kill the buffers
+	sdl_destroy_buffers();
 }
 
 
@@ -510,13 +281,18 @@ void sound_sdl::exit()
 //  dsound_create_buffers
 //============================================================
 
-int sound_sdl::sdl_create_buffers(void)
+int sound_sdl::sdl_create_buffers(int audio_latency)
 {
+	UINT32 stream_buffer_size = (sample_rate() * 2 * sizeof(INT16) * (2 + audio_latency)) / 30;
+	stream_buffer_size = (stream_buffer_size / 1024) * 1024;
+	if (stream_buffer_size < 1024)
+		stream_buffer_size = 1024;
+
 	osd_printf_verbose("sdl_create_buffers: creating stream buffer of %u bytes\n", stream_buffer_size);
 
-	stream_buffer = global_alloc_array_clear<INT8>(stream_buffer_size);
-	stream_playpos = 0;
-	buf_locked = 0;
+	// start out half full, as the old play/write cursor layout did
+	stream_ring.reset(stream_buffer_size / (sizeof(INT16) * 2));
+	stream_latency = stream_ring.capacity() / 2;
 	return 0;
 }
 
@@ -527,9 +303,8 @@ int sound_sdl::sdl_create_buffers(void)
 void sound_sdl::sdl_destroy_buffers(void)
 {
 	// release the buffer
-	if (stream_buffer)
-		global_free_array(stream_buffer);
-	stream_buffer = NULL;
+	stream_ring.reset(0);
+	stream_latency = 0;
 }
 
 
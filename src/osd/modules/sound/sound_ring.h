@@ -0,0 +1,139 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+//============================================================
+//
+//  sound_ring.h - lock-free ring of stereo samples
+//
+//  One thread (the emulation side) writes, one thread (the
+//  audio callback) reads; neither side ever takes a lock.
+//
+//============================================================
+
+#ifndef SOUND_RING_H_
+#define SOUND_RING_H_
+
+#include <atomic>
+#include <memory>
+#include <string.h>
+
+#include "osdcomm.h"
+
+class sound_ring
+{
+public:
+	sound_ring()
+		: m_mask(0), m_capacity(0), m_read(0), m_write(0),
+			m_underruns(0), m_overruns(0), m_min_fill(0), m_max_fill(0)
+	{
+	}
+
+	// set the size in frames and empty the ring; not thread safe
+	void reset(UINT32 frames)
+	{
+		UINT32 size = 1;
+		while (size < frames)
+			size <<= 1;
+		m_buffer.reset(new INT16[size * 2]);
+		m_mask = size - 1;
+		m_capacity = frames;
+		m_read = m_write = 0;
+		m_underruns = m_overruns = 0;
+		m_min_fill = frames;
+		m_max_fill = 0;
+	}
+
+	UINT32 capacity() const { return m_capacity; }
+	UINT32 fill() const { return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire); }
+	UINT32 space() const { return m_capacity - fill(); }
+
+	// statistics
+	UINT32 underruns() const { return m_underruns.load(std::memory_order_relaxed); }
+	UINT32 overruns() const { return m_overruns.load(std::memory_order_relaxed); }
+	UINT32 min_fill() const { return m_min_fill.load(std::memory_order_relaxed); }
+	UINT32 max_fill() const { return m_max_fill.load(std::memory_order_relaxed); }
+
+	//------------------------------------------------
+	//  producer side
+	//------------------------------------------------
+
+	// queue frames scaled by level/128; a chunk that doesn't
+	// fit is dropped whole and counted as an overrun
+	bool write(const INT16 *data, UINT32 frames, int level = 128)
+	{
+		const UINT32 wr = m_write.load(std::memory_order_relaxed);
+		const UINT32 used = wr - m_read.load(std::memory_order_acquire);
+		if (frames > m_capacity - used)
+		{
+			m_overruns.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		for (UINT32 done = 0; done < frames; )
+		{
+			const UINT32 pos = (wr + done) & m_mask;
+			const UINT32 chunk = MIN(frames - done, m_mask + 1 - pos);
+			INT16 *dest = &m_buffer[pos * 2];
+			if (data == nullptr)
+				memset(dest, 0, chunk * 2 * sizeof(INT16));
+			else if (level == 128)
+				memcpy(dest, data + done * 2, chunk * 2 * sizeof(INT16));
+			else
+				for (UINT32 i = 0; i < chunk * 2; i++)
+					dest[i] = (data[done * 2 + i] * level) >> 7;
+			done += chunk;
+		}
+
+		m_write.store(wr + frames, std::memory_order_release);
+		return true;
+	}
+
+	// queue silence
+	bool write_silence(UINT32 frames) { return write(nullptr, frames); }
+
+	//------------------------------------------------
+	//  consumer side
+	//------------------------------------------------
+
+	// fetch up to frames frames, padding with silence and
+	// counting an underrun if not enough were queued
+	UINT32 read(INT16 *dest, UINT32 frames)
+	{
+		const UINT32 rd = m_read.load(std::memory_order_relaxed);
+		const UINT32 avail = m_write.load(std::memory_order_acquire) - rd;
+		const UINT32 count = MIN(frames, avail);
+
+		if (avail < m_min_fill.load(std::memory_order_relaxed))
+			m_min_fill.store(avail, std::memory_order_relaxed);
+		if (avail > m_max_fill.load(std::memory_order_relaxed))
+			m_max_fill.store(avail, std::memory_order_relaxed);
+
+		for (UINT32 done = 0; done < count; )
+		{
+			const UINT32 pos = (rd + done) & m_mask;
+			const UINT32 chunk = MIN(count - done, m_mask + 1 - pos);
+			memcpy(dest + done * 2, &m_buffer[pos * 2], chunk * 2 * sizeof(INT16));
+			done += chunk;
+		}
+		m_read.store(rd + count, std::memory_order_release);
+
+		if (count < frames)
+		{
+			memset(dest + count * 2, 0, (frames - count) * 2 * sizeof(INT16));
+			m_underruns.fetch_add(1, std::memory_order_relaxed);
+		}
+		return count;
+	}
+
+private:
+	std::unique_ptr<INT16[]>    m_buffer;       // interleaved left/right, power of two frames
+	UINT32                      m_mask;         // frame index mask for m_buffer
+	UINT32                      m_capacity;     // frames that may be queued at once
+	std::atomic<UINT32>         m_read;         // frames consumed, only advanced by the reader
+	std::atomic<UINT32>         m_write;        // frames produced, only advanced by the writer
+	std::atomic<UINT32>         m_underruns;
+	std::atomic<UINT32>         m_overruns;
+	std::atomic<UINT32>         m_min_fill;     // queue depth seen by the reader, for latency
+	std::atomic<UINT32>         m_max_fill;
+};
+
+#endif /* SOUND_RING_H_ */
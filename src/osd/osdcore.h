@@ -217,6 +217,49 @@ file_error osd_truncate(osd_file *file, UINT64 offset);
 file_error osd_fflush(osd_file *file);
 
 
+/*-----------------------------------------------------------------------------
+    osd_map: map the start of a file into memory for reading
+
+    Parameters:
+
+        file - handle to a file previously opened via osd_open
+
+        length - number of bytes to map, starting at offset 0
+
+        base - pointer to a const void * to receive the address of the
+            mapped data
+
+    Return value:
+
+        a file_error describing any error that occurred while mapping the
+        file, or FILERR_NONE if no error occurred
+
+    Notes:
+
+        The mapping is read-only and stays valid until it is released with
+        osd_unmap, even if the file is closed first. Files that can't be
+        mapped (sockets, ptys, or platforms without support) return
+        FILERR_FAILURE, and callers should fall back to osd_read.
+-----------------------------------------------------------------------------*/
+file_error osd_map(osd_file *file, UINT64 length, const void **base);
+
+
+/*-----------------------------------------------------------------------------
+    osd_unmap: release a mapping made with osd_map
+
+    Parameters:
+
+        base - address returned by osd_map
+
+        length - length passed to osd_map
+
+    Return value:
+
+        None.
+-----------------------------------------------------------------------------*/
+void osd_unmap(const void *base, UINT64 length);
+
+
 /*-----------------------------------------------------------------------------
     osd_rmfile: deletes a file
 
@@ -320,6 +363,7 @@ struct osd_directory_entry
 	const char *        name;           /* name of the entry */
 	osd_dir_entry_type  type;           /* type of the entry */
 	UINT64              size;           /* size of the entry */
+	UINT64              last_modified;  /* modification time in OSD-specific units, or 0 if unknown */
 };
 
 
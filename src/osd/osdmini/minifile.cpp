@@ -110,6 +110,23 @@ file_error osd_openpty(osd_file **file, char *name, size_t name_len)
 	return FILERR_FAILURE;
 }
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	return FILERR_FAILURE;
+}
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(const void *base, UINT64 length)
+{
+}
+
 //============================================================
 //  osd_truncate
 //============================================================
@@ -194,6 +211,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = (char *)(result + 1);
 	result->type = ENTTYPE_NONE;
 	result->size = 0;
+	result->last_modified = 0;
 
 	FILE *f = fopen(path, "rb");
 	if (f != nullptr)
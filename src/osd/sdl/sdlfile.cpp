@@ -33,6 +33,7 @@
 #endif
 
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdio.h>
@@ -414,6 +415,32 @@ file_error osd_close(osd_file *file)
 	}
 }
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	if (file->type != SDLFILE_FILE || length == 0 || length != (size_t)length)
+		return FILERR_FAILURE;
+
+	void *result = mmap(nullptr, length, PROT_READ, MAP_SHARED, file->handle, 0);
+	if (result == MAP_FAILED)
+		return error_to_file_error(errno);
+
+	*base = result;
+	return FILERR_NONE;
+}
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(const void *base, UINT64 length)
+{
+	munmap(const_cast<void *>(base), length);
+}
+
 //============================================================
 //  osd_rmfile
 //============================================================
@@ -534,6 +561,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = ((char *) result) + sizeof(*result);
 	result->type = S_ISDIR(st.st_mode) ? ENTTYPE_DIR : ENTTYPE_FILE;
 	result->size = (UINT64)st.st_size;
+	result->last_modified = (UINT64)st.st_mtime;
 
 	return result;
 }
@@ -333,6 +333,41 @@ file_error osd_close(osd_file *file)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 length, const void **base)
+{
+	if (file->type != WINFILE_FILE || length == 0 || length != (SIZE_T)length)
+		return FILERR_FAILURE;
+
+	HANDLE mapping = CreateFileMapping(file->handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+		return win_error_to_file_error(GetLastError());
+
+	// the view keeps the mapping object alive on its own
+	void *result = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, (SIZE_T)length);
+	DWORD error = GetLastError();
+	CloseHandle(mapping);
+	if (result == nullptr)
+		return win_error_to_file_error(error);
+
+	*base = result;
+	return FILERR_NONE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+void osd_unmap(const void *base, UINT64 length)
+{
+	UnmapViewOfFile(base);
+}
+
+
 //============================================================
 //  osd_rmfile
 //============================================================
@@ -515,6 +550,7 @@ osd_directory_entry *osd_stat(const char *path)
 	result->name = ((char *) result) + sizeof(*result);
 	result->type = win_attributes_to_entry_type(find_data.dwFileAttributes);
 	result->size = find_data.nFileSizeLow | ((UINT64) find_data.nFileSizeHigh << 32);
+	result->last_modified = find_data.ftLastWriteTime.dwLowDateTime | ((UINT64) find_data.ftLastWriteTime.dwHighDateTime << 32);
 
 done:
 	if (t_path != NULL)
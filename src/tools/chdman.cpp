@@ -96,6 +96,7 @@ const int MODE_GDI = 2;
 #define OPTION_VERBOSE "verbose"
 #define OPTION_FIX "fix"
 #define OPTION_NUMPROCESSORS "numprocessors"
+#define OPTION_PRESELECT "preselect"
 #define OPTION_SIZE "size"
 
 
@@ -535,7 +536,8 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression or decompression" },
+	{ OPTION_PRESELECT,             "ps",   true, " <0-2>: try only the codec that kept winning on similar data (0 = try all codecs on every hunk)" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -556,7 +558,8 @@ static const command_description s_commands[] =
 	{ COMMAND_VERIFY, do_verify, ": verifies a CHD's integrity",
 		{
 			REQUIRED OPTION_INPUT,
-			OPTION_INPUT_PARENT
+			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -573,7 +576,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_HUNK_SIZE,
 			REQUIRED OPTION_UNIT_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_PRESELECT
 		}
 	},
 
@@ -593,7 +597,8 @@ static const command_description s_commands[] =
 			OPTION_CHS,
 			OPTION_SIZE,
 			OPTION_SECTOR_SIZE,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_PRESELECT
 		}
 	},
 
@@ -605,7 +610,8 @@ static const command_description s_commands[] =
 			REQUIRED OPTION_INPUT,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_PRESELECT
 		}
 	},
 
@@ -619,7 +625,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_FRAMES,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_PRESELECT
 		}
 	},
 
@@ -632,7 +639,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -645,7 +653,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -656,6 +665,7 @@ static const command_description s_commands[] =
 			OPTION_OUTPUT_FORCE,
 			REQUIRED OPTION_INPUT,
 			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -683,7 +693,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_LENGTH_HUNKS,
 			OPTION_HUNK_SIZE,
 			OPTION_COMPRESSION,
-			OPTION_NUMPROCESSORS
+			OPTION_NUMPROCESSORS,
+			OPTION_PRESELECT
 		}
 	},
 
@@ -1126,6 +1137,39 @@ static void parse_numprocessors(const parameters_t &params)
 }
 
 
+//-------------------------------------------------
+//  configure_parallel_read - have worker threads
+//  decompress hunks ahead of a sequential reader
+//  of the input CHD
+//-------------------------------------------------
+
+static void configure_parallel_read(chd_file &input_chd)
+{
+	// a multi-processor queue has no worker threads when limited to one processor
+	// and would decode every hunk ahead inline; keep the default I/O thread instead
+	extern int osd_num_processors;
+	if (osd_num_processors == 1)
+		return;
+
+	// keep every worker busy, with as many decoded hunks again waiting to be consumed
+	const UINT32 readahead = 2 * WORK_MAX_THREADS;
+	input_chd.configure_cache(2 * readahead, readahead, true);
+}
+
+
+//-------------------------------------------------
+//  throughput_string - describe how fast data was
+//  processed since a starting time
+//-------------------------------------------------
+
+static const char *throughput_string(std::string &str, UINT64 bytes, osd_ticks_t start)
+{
+	double seconds = double(osd_ticks() - start) / double(osd_ticks_per_second());
+	str = string_format("%.1f MB/s", (seconds > 0.0) ? double(bytes) / (1024.0 * 1024.0 * seconds) : 0.0);
+	return str.c_str();
+}
+
+
 //-------------------------------------------------
 //  compression_string - create a friendly string
 //  describing a set of compressors
@@ -1160,8 +1204,15 @@ static const char *compression_string(std::string &str, chd_codec_type compressi
 //  compress_common - standard compression loop
 //-------------------------------------------------
 
-static void compress_common(chd_file_compressor &chd)
+static void compress_common(chd_file_compressor &chd, const parameters_t &params)
 {
+	// process codec preselection
+	int preselect = 0;
+	auto preselect_str = params.find(OPTION_PRESELECT);
+	if (preselect_str != params.end())
+		preselect = atoi(preselect_str->second->c_str());
+	chd.set_preselect(preselect);
+
 	// begin compressing
 	chd.compress_begin();
 
@@ -1180,6 +1231,15 @@ static void compress_common(chd_file_compressor &chd)
 
 	// final progress update
 	progress(true, "Compression complete ... final ratio = %.1f%%            \n", 100.0 * ratio);
+
+	// report how well the codec predictions held up
+	if (preselect > 0)
+	{
+		chd_compressor_group::preselect_stats stats = chd.preselect_stats();
+		std::string tempstr1, tempstr2, tempstr3;
+		printf("Preselected:  %s of %s hunks\n", big_int_string(tempstr1, stats.m_predicted), big_int_string(tempstr2, stats.m_hunks));
+		printf("Mispredicted: %s of %s checked (%s bytes lost)\n", big_int_string(tempstr1, stats.m_mispredicted), big_int_string(tempstr2, stats.m_checked), big_int_string(tempstr3, stats.m_lostbytes));
+	}
 }
 
 
@@ -1504,14 +1564,20 @@ static void do_verify(parameters_t &params)
 	if (raw_sha1 == sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
+	// process numprocessors
+	parse_numprocessors(params);
+	configure_parallel_read(input_chd);
+
 	// create an array to read into
 	dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
 
 	// read all the data and build up an SHA-1
 	sha1_creator rawsha1;
+	std::string tempstr;
+	osd_ticks_t start = osd_ticks();
 	for (UINT64 offset = 0; offset < input_chd.logical_bytes(); )
 	{
-		progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(offset) / double(input_chd.logical_bytes()));
+		progress(false, "Verifying, %.1f%% complete... (%s)  \r", 100.0 * double(offset) / double(input_chd.logical_bytes()), throughput_string(tempstr, offset, start));
 
 		// determine how much to read
 		UINT32 bytes_to_read = MIN((UINT32)buffer.size(), input_chd.logical_bytes() - offset);
@@ -1524,6 +1590,7 @@ static void do_verify(parameters_t &params)
 		offset += bytes_to_read;
 	}
 	sha1_t computed_sha1 = rawsha1.finish();
+	progress(true, "Verification complete ... %s              \n", throughput_string(tempstr, input_chd.logical_bytes(), start));
 
 	// finish up
 	if (raw_sha1 != computed_sha1)
@@ -1647,7 +1714,7 @@ static void do_create_raw(parameters_t &params)
 			chd->clone_all_metadata(output_parent);
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 		delete chd;
 	}
 	catch (...)
@@ -1836,7 +1903,7 @@ static void do_create_hd(parameters_t &params)
 
 		// compress it generically
 		if (input_file)
-			compress_common(*chd);
+			compress_common(*chd, params);
 		delete chd;
 	}
 	catch (...)
@@ -1928,7 +1995,7 @@ static void do_create_cd(parameters_t &params)
 			report_error(1, "Error adding CD metadata: %s", chd_file::error_string(err));
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 		delete chd;
 	}
 	catch (...)
@@ -2047,7 +2114,7 @@ static void do_create_ld(parameters_t &params)
 			report_error(1, "Error adding AV metadata: %s\n", chd_file::error_string(err));
 
 		// create the compressor and then run it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 
 		// write the final LD metadata
 		if (info.height == 524/2 || info.height == 624/2)
@@ -2118,6 +2185,7 @@ static void do_copy(parameters_t &params)
 
 	// process numprocessors
 	parse_numprocessors(params);
+	configure_parallel_read(input_chd);
 
 	// print some info
 	std::string tempstr;
@@ -2191,7 +2259,7 @@ static void do_copy(parameters_t &params)
 		}
 
 		// compress it generically
-		compress_common(*chd);
+		compress_common(*chd, params);
 		delete chd;
 	}
 	catch (...)
@@ -2228,6 +2296,10 @@ static void do_extract_raw(parameters_t &params)
 	if (output_file_str != params.end())
 		check_existing_output_file(params, output_file_str->second->c_str());
 
+	// process numprocessors
+	parse_numprocessors(params);
+	configure_parallel_read(input_chd);
+
 	// print some info
 	std::string tempstr;
 	printf("Output File:  %s\n", output_file_str->second->c_str());
@@ -2249,9 +2321,10 @@ static void do_extract_raw(parameters_t &params)
 
 		// copy all data
 		dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+		osd_ticks_t start = osd_ticks();
 		for (UINT64 offset = input_start; offset < input_end; )
 		{
-			progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(offset - input_start) / double(input_end - input_start));
+			progress(false, "Extracting, %.1f%% complete... (%s)  \r", 100.0 * double(offset - input_start) / double(input_end - input_start), throughput_string(tempstr, offset - input_start, start));
 
 			// determine how much to read
 			UINT32 bytes_to_read = MIN((UINT32)buffer.size(), input_end - offset);
@@ -2270,7 +2343,7 @@ static void do_extract_raw(parameters_t &params)
 
 		// finish up
 		output_file.reset();
-		printf("Extraction complete                                    \n");
+		printf("Extraction complete ... %s                            \n", throughput_string(tempstr, input_end - input_start, start));
 	}
 	catch (...)
 	{
@@ -2297,6 +2370,10 @@ static void do_extract_cd(parameters_t &params)
 	chd_file input_chd;
 	parse_input_chd_parameters(params, input_chd, input_parent_chd);
 
+	// process numprocessors
+	parse_numprocessors(params);
+	configure_parallel_read(input_chd);
+
 	// further process input file
 	cdrom_file *cdrom = cdrom_open(&input_chd);
 	if (cdrom == nullptr)
@@ -2373,8 +2450,10 @@ static void do_extract_cd(parameters_t &params)
 
 		// iterate over tracks and copy all data
 		UINT64 outputoffs = 0;
+		UINT64 totaloffs = 0;
 		UINT32 discoffs = 0;
 		dynamic_buffer buffer;
+		osd_ticks_t start = osd_ticks();
 		for (int tracknum = 0; tracknum < toc->numtrks; tracknum++)
 		{
 			std::string trackbin_name(basename);
@@ -2427,7 +2506,7 @@ static void do_extract_cd(parameters_t &params)
 			UINT32 actualframes = trackinfo.frames - trackinfo.padframes;
 			for (UINT32 frame = 0; frame < actualframes; frame++)
 			{
-				progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(outputoffs) / double(total_bytes));
+				progress(false, "Extracting, %.1f%% complete... (%s)  \r", 100.0 * double(totaloffs) / double(total_bytes), throughput_string(tempstr, totaloffs, start));
 
 				// read the data
 				cdrom_read_data(cdrom, cdrom_get_track_start_phys(cdrom, tracknum) + frame, &buffer[bufferoffs], trackinfo.trktype, true);
@@ -2459,6 +2538,7 @@ static void do_extract_cd(parameters_t &params)
 					if (byteswritten != bufferoffs)
 						report_error(1, "Error writing frame %d to file (%s): %s\n", frame, output_file_str->second->c_str(), chd_file::error_string(CHDERR_WRITE_ERROR));
 					outputoffs += bufferoffs;
+					totaloffs += bufferoffs;
 					bufferoffs = 0;
 				}
 			}
@@ -2469,7 +2549,7 @@ static void do_extract_cd(parameters_t &params)
 		// finish up
 		output_bin_file.reset();
 		output_toc_file.reset();
-		printf("Extraction complete                                    \n");
+		printf("Extraction complete ... %s                            \n", throughput_string(tempstr, totaloffs, start));
 	}
 	catch (...)
 	{